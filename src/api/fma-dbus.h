@@ -132,6 +132,36 @@ G_BEGIN_DECLS
  */
 #define FILEMANAGER_ACTIONS_DBUS_TRACKER_IFACE  	"org.filemanager_actions.DBus.Tracker.Properties1"
 
+/**
+ * FILEMANAGER_ACTIONS_DBUS_RUN_SERVICE:
+ *
+ * The well-known name owned on the D-Bus session bus by the
+ * <command>fma-run-daemon</command> resident service, which is
+ * activated on demand by <command>fma-run</command>.
+ *
+ * Since: 3.5
+ */
+#define FILEMANAGER_ACTIONS_DBUS_RUN_SERVICE        "org.filemanager-actions.DBus.Run"
+
+/**
+ * FILEMANAGER_ACTIONS_DBUS_RUN_PATH:
+ *
+ * The D-Bus path of the <emphasis>run</emphasis> object.
+ *
+ * Since: 3.5
+ */
+#define FILEMANAGER_ACTIONS_DBUS_RUN_PATH           "/org/filemanager_actions/DBus/Run"
+
+/**
+ * FILEMANAGER_ACTIONS_DBUS_RUN_IFACE:
+ *
+ * The interface defined on the <emphasis>run</emphasis> object,
+ * identified by its %FILEMANAGER_ACTIONS_DBUS_RUN_PATH D-Bus path.
+ *
+ * Since: 3.5
+ */
+#define FILEMANAGER_ACTIONS_DBUS_RUN_IFACE          "org.filemanager_actions.DBus.Run.Actions1"
+
 G_END_DECLS
 
 #endif /* __FILEMANAGER_ACTIONS_API_DBUS_H__ */
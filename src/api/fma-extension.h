@@ -119,6 +119,26 @@
  * depending of your system.
  *       </para>
  *   </refsect3>
+ *    <refsect3>
+ *      <title>Deferring the load of the library</title>
+ *       <para>
+ * Since 3.5, the library may be installed along with a manifest, i.e.
+ * a keyed file with the same basename and a <filename>.plugin</filename>
+ * extension, which declares the identifier of the plugin and the
+ * interfaces it implements, as in:
+ * <programlisting>
+ *   [FileManager-Actions Plugin]
+ *   Id=io-desktop
+ *   Interfaces=FMAIIOProvider;FMAIFactoryProvider;FMAIImporter;FMAIExporter;
+ * </programlisting>
+ *       </para>
+ *       <para>
+ * Such a library is only loaded when one of these interfaces is first
+ * needed; a FMAIIOProvider is so only loaded when it is readable, or
+ * when the user is about to write into it. A library without manifest
+ * is loaded at startup.
+ *       </para>
+ *   </refsect3>
  * </refsect2>
  *
  * <refsect2>
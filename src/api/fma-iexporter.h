@@ -158,6 +158,7 @@
  */
 
 #include <gdk-pixbuf/gdk-pixbuf.h>
+#include <gio/gio.h>
 #include "fma-object-item.h"
 
 G_BEGIN_DECLS
@@ -365,6 +366,52 @@ typedef struct {
 }
 	FMAIExporterBufferParmsv2;
 
+/**
+ * FMAIExporterStreamParmsv2:
+ * @version:  [in] version of this structure;
+ *                 equals to 2;
+ *                 since structure version 2.
+ * @content:  [in] version of the content of this structure;
+ *                 equals to 1;
+ *                 since structure version 2.
+ * @exported: [in] exported FMAObjectItem-derived object;
+ *                 since structure version 2.
+ * @stream:   [in] the #GOutputStream the item is to be written to;
+ *                 since structure version 2.
+ * @format:   [in] export format string identifier;
+ *                 since structure version 2.
+ * @first:    [in] whether @exported is the first item written to @stream,
+ *                 i.e. whether the format prologue has to be written first;
+ *                 since structure version 2.
+ * @last:     [in] whether @exported is the last item written to @stream,
+ *                 i.e. whether the format epilogue has to be written after;
+ *                 since structure version 2.
+ * @messages: [in/out] a #GSList list of localized strings;
+ *                 the provider may append messages to this list,
+ *                 but shouldn't reinitialize it;
+ *                 since structure version 2.
+ *
+ * The structure that the plugin receives as a parameter of
+ * #FMAIExporterInterface.to_stream () interface method.
+ *
+ * When several items are exported to the same @stream, the method is
+ * called once per item, in order: the first call has @first set, and
+ * the last one has @last set. A single item export has both set.
+ *
+ * Since: 3.5
+ */
+typedef struct {
+	guint          version;
+	guint          content;
+	FMAObjectItem *exported;
+	GOutputStream *stream;
+	gchar         *format;
+	gboolean       first;
+	gboolean       last;
+	GSList        *messages;
+}
+	FMAIExporterStreamParmsv2;
+
 /**
  * FMAIExporterInterface:
  * @get_version:  [should] returns the version of this interface the plugin implements.
@@ -373,6 +420,7 @@ typedef struct {
  * @free_formats: [should] free a list of formats
  * @to_file:      [should] exports an item to a file.
  * @to_buffer:    [should] exports an item to a buffer.
+ * @to_stream:    [may] exports an item to an output stream.
  *
  * This defines the interface that a #FMAIExporter should implement.
  */
@@ -494,6 +542,25 @@ typedef struct {
 	 * Since: 2.30
 	 */
 	guint   ( *to_buffer )  ( const FMAIExporter *instance, FMAIExporterBufferParmsv2 *parms );
+
+	/**
+	 * to_stream:
+	 * @instance: this FMAIExporter instance.
+	 * @parms: a FMAIExporterStreamParmsv2 structure.
+	 *
+	 * Incrementally writes the specified 'exported' to the 'stream' in
+	 * the required 'format', without building the whole output in
+	 * memory. The implementation is expected to keep at most one item
+	 * in memory at a time.
+	 *
+	 * If this method is not implemented, FileManager-Actions falls back
+	 * to to_buffer() for single item exports.
+	 *
+	 * Return value: the FMAIExporterExportStatus status of the operation.
+	 *
+	 * Since: 3.5
+	 */
+	guint   ( *to_stream )  ( const FMAIExporter *instance, FMAIExporterStreamParmsv2 *parms );
 }
 	FMAIExporterInterface;
 
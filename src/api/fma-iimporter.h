@@ -380,7 +380,7 @@ typedef enum {
  * FMAIImporterImportFromUriParmsv2:
  * @version:       [in] the version of the structure, equals to 2;
  *                      since structure version 1.
- * @content:       [in] the version of the description content, equals to 1;
+ * @content:       [in] the version of the description content, equals to 2;
  *                      since structure version 2.
  * @uri:           [in] uri of the file to be imported;
  *                      since structure version 1.
@@ -390,10 +390,16 @@ typedef enum {
  *                      the provider may append messages to this list, but
  *                      shouldn't reinitialize it;
  *                      since structure version 1.
+ * @bundled:       [out] a #GList of the other #FMAObjectItem -derived objects
+ *                      imported from the same @uri, when this later holds
+ *                      a bundle of several items, or %NULL;
+ *                      since content version 2.
  *
  * This structure allows all used parameters when importing from an URI
  * to be passed and received through a single structure.
  *
+ * The provider must not set @bundled unless @content is at least 2.
+ *
  * Since: 3.2
  */
 typedef struct {
@@ -402,6 +408,7 @@ typedef struct {
 	const gchar   *uri;
 	FMAObjectItem *imported;
 	GSList        *messages;
+	GList         *bundled;
 }
 	FMAIImporterImportFromUriParmsv2;
 
@@ -220,6 +220,21 @@
  *        <row>
  *          <entry>since 2.30</entry>
  *          <entry>1</entry>
+ *          <entry></entry>
+ *        </row>
+ *        <row>
+ *          <entry>since 3.5</entry>
+ *          <entry>2</entry>
+ *          <entry></entry>
+ *        </row>
+ *        <row>
+ *          <entry>since 3.5</entry>
+ *          <entry>3</entry>
+ *          <entry></entry>
+ *        </row>
+ *        <row>
+ *          <entry>since 3.5</entry>
+ *          <entry>4</entry>
  *          <entry>current version</entry>
  *        </row>
  *      </tbody>
@@ -252,6 +267,11 @@ typedef struct _FMAIIOProviderInterfacePrivate     FMAIIOProviderInterfacePrivat
  * @write_item:          [should] writes an item.
  * @delete_item:         [should] deletes an item.
  * @duplicate_data:      [may]    let the I/O provider duplicates its specific data.
+ * @write_items_start:   [may]    starts writing a set of items.
+ * @write_items_done:    [may]    terminates writing a set of items.
+ * @write_items_abort:   [may]    discards a set of items.
+ * @read_item:           [may]    reads a single item.
+ * @read_items_is_thread_safe: [may] whether items may be read in a worker thread.
  *
  * This defines the methods that a #FMAIIOProvider may, should, or must
  * implement.
@@ -467,6 +487,121 @@ typedef struct {
 											FMAObjectItem *dest,
 											const FMAObjectItem *source,
 											GSList **messages );
+
+	/**
+	 * write_items_start:
+	 * @instance: the FMAIIOProvider provider.
+	 * @messages: a pointer to a GSList list of strings; the provider
+	 *  may append messages to this list, but shouldn't reinitialize it.
+	 *
+	 * FileManager-Actions calls this method before writing or deleting
+	 * a set of items, so that the I/O provider may group the
+	 * corresponding physical writes.
+	 *
+	 * Return value: IIO_PROVIDER_CODE_OK if the I/O provider is ready
+	 * to write, or another code depending of the detected error.
+	 *
+	 * This method is part of the version 2 of the interface.
+	 *
+	 * Since: 3.5
+	 */
+	guint    ( *write_items_start )  ( const FMAIIOProvider *instance,
+											GSList **messages );
+
+	/**
+	 * write_items_done:
+	 * @instance: the FMAIIOProvider provider.
+	 * @messages: a pointer to a GSList list of strings; the provider
+	 *  may append messages to this list, but shouldn't reinitialize it.
+	 *
+	 * FileManager-Actions calls this method after having written or
+	 * deleted the set of items; the I/O provider is expected to have
+	 * actually committed them to its storage subsystem on return.
+	 *
+	 * Return value: IIO_PROVIDER_CODE_OK if all the items have been
+	 * successfully committed, or another code depending of the
+	 * detected error.
+	 *
+	 * This method is part of the version 2 of the interface.
+	 *
+	 * Since: 3.5
+	 */
+	guint    ( *write_items_done )   ( const FMAIIOProvider *instance,
+											GSList **messages );
+
+	/**
+	 * write_items_abort:
+	 * @instance: the FMAIIOProvider provider.
+	 * @messages: a pointer to a GSList list of strings; the provider
+	 *  may append messages to this list, but shouldn't reinitialize it.
+	 *
+	 * FileManager-Actions calls this method instead of write_items_done()
+	 * when one of the items of the set could not be written or deleted;
+	 * the I/O provider is expected to discard all the writes and
+	 * deletions of the set, leaving its storage subsystem untouched.
+	 *
+	 * If the I/O provider doesn't implement this method, then
+	 * FileManager-Actions restores the already written items to their
+	 * origin, before calling write_items_done().
+	 *
+	 * Return value: IIO_PROVIDER_CODE_OK if the set of items has been
+	 * discarded, or another code depending of the detected error.
+	 *
+	 * This method is part of the version 2 of the interface.
+	 *
+	 * Since: 3.5
+	 */
+	guint    ( *write_items_abort )  ( const FMAIIOProvider *instance,
+											GSList **messages );
+
+	/**
+	 * read_item:
+	 * @instance: the FMAIIOProvider provider.
+	 * @id: the identifier of the searched item.
+	 * @messages: a pointer to a GSList list of strings; the provider
+	 *  may append messages to this list, but shouldn't reinitialize it.
+	 *
+	 * Reads the single item identified by @id from the specified I/O
+	 * provider, without having to read the whole items list.
+	 *
+	 * If the I/O provider doesn't implement this method, then
+	 * FileManager-Actions falls back to reading all the items.
+	 *
+	 * Return value: if implemented, this method must return a newly
+	 * allocated FMAObjectItem-derived object (menu or action), or %NULL
+	 * if the item is not found in this I/O provider; an action embeds
+	 * its own profiles.
+	 *
+	 * This method is part of the version 3 of the interface.
+	 *
+	 * Since: 3.5
+	 */
+	FMAObjectItem * ( *read_item )   ( const FMAIIOProvider *instance,
+											const gchar *id,
+											GSList **messages );
+
+	/**
+	 * read_items_is_thread_safe:
+	 * @instance: the FMAIIOProvider provider.
+	 *
+	 * FileManager-Actions may read the I/O providers concurrently, each
+	 * in its own thread. An I/O provider which relies on non thread-safe
+	 * resources while reading its items (e.g. file monitors attached
+	 * to the main context, or a GConf client) must not be read outside
+	 * of the calling thread.
+	 *
+	 * If the I/O provider doesn't implement this method, then
+	 * FileManager-Actions considers that it is not thread-safe, and
+	 * reads it in the calling thread.
+	 *
+	 * This method is part of the version 4 of the interface.
+	 *
+	 * Return value: %TRUE if the read_items() method may be run in a
+	 * worker thread, concurrently with the other I/O providers.
+	 *
+	 * Since: 3.5
+	 */
+	gboolean ( *read_items_is_thread_safe )( const FMAIIOProvider *instance );
 }
 	FMAIIOProviderInterface;
 
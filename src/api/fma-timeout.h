@@ -56,6 +56,28 @@ G_BEGIN_DECLS
  */
 typedef void ( *FMATimeoutFunc )( void *user_data );
 
+/**
+ * FMATimeoutFlags:
+ * @FMA_TIMEOUT_LEADING_EDGE:    the handler is triggered on the first
+ *                               event of a burst.
+ * @FMA_TIMEOUT_NO_TRAILING_EDGE: the handler is not triggered at the end
+ *                               of the burst.
+ *
+ * The default (zero) is to only trigger the handler at the end of the
+ * burst, i.e. on the trailing edge. When the leading edge is requested,
+ * the trailing call only happens if some other events have been recorded
+ * after the leading call.
+ *
+ * Since: 3.5
+ */
+typedef enum {
+	FMA_TIMEOUT_LEADING_EDGE     = 1 << 0,
+	FMA_TIMEOUT_NO_TRAILING_EDGE = 1 << 1
+}
+	FMATimeoutFlags;
+
+typedef struct _FMATimeoutPrivate        FMATimeoutPrivate;
+
 /**
  * FMATimeout:
  * @timeout:   timeout configurable parameter (ms)
@@ -77,20 +99,34 @@ typedef void ( *FMATimeoutFunc )( void *user_data );
  * will be triggered as soon as no event will be recorded after @timeout
  * milliseconds of inactivity.
  *
+ * Since 3.5, the duration of a burst may be bounded with
+ * fma_timeout_set_max_wait(), and the edges of the burst on which the
+ * @handler is triggered may be chosen with fma_timeout_set_flags().
+ * Delays are measured against the monotonic clock, and a single event
+ * source is attached during a burst, which is only woken up when the
+ * burst is expected to be terminated. fma_timeout_cancel() must be
+ * called before releasing a structure which has been configured with
+ * one of these functions.
+ *
+ * The size and the layout of the structure are unchanged since 3.1.
+ *
  * Since: 3.1
  */
 typedef struct {
 	/*< public >*/
-	guint          timeout;
-	FMATimeoutFunc handler;
-	gpointer       user_data;
+	guint              timeout;
+	FMATimeoutFunc     handler;
+	gpointer           user_data;
 	/*< private >*/
-	GTimeVal       last_time;
-	guint          source_id;
+	FMATimeoutPrivate *private;
+	gpointer           reserved[2];
 }
 	FMATimeout;
 
-void fma_timeout_event( FMATimeout *timeout );
+void fma_timeout_event       ( FMATimeout *timeout );
+void fma_timeout_cancel      ( FMATimeout *timeout );
+void fma_timeout_set_max_wait( FMATimeout *timeout, guint max_wait );
+void fma_timeout_set_flags   ( FMATimeout *timeout, guint flags );
 
 G_END_DECLS
 
@@ -81,13 +81,27 @@ struct _FMABoxedPrivate {
 		guint     uint;
 		GList    *uint_list;
 	} u;
+	struct _SharedList *shared;			/* which holds u.string_list */
 };
 
+/* SharedList:
+ * Identical string lists share one instance, so that they may be
+ * compared by address. The list and its strings are immutable.
+ */
+typedef struct _SharedList {
+	GSList *list;
+	guint   refcount;
+}
+	SharedList;
+
 #define LIST_SEPARATOR					";"
 #define DEBUG							if( 0 ) g_debug
 
 static GObjectClass *st_parent_class    = NULL;
 
+static GMutex        st_shared_mutex;				/* protects the table below */
+static GHashTable   *st_shared_lists    = NULL;		/* GSList * -> SharedList * */
+
 static GType            register_type( void );
 static void             class_init( FMABoxedClass *klass );
 static void             instance_init( GTypeInstance *instance, gpointer klass );
@@ -97,6 +111,11 @@ static void             instance_finalize( GObject *object );
 static FMABoxed        *boxed_new( const sBoxedDef *def );
 static const sBoxedDef *get_boxed_def( guint type );
 static gchar          **string_to_array( const gchar *string );
+static guint            shared_list_hash( gconstpointer list );
+static gboolean         shared_list_equal( gconstpointer a, gconstpointer b );
+static SharedList      *shared_list_get( GSList *list );
+static SharedList      *shared_list_ref( SharedList *shared );
+static void             shared_list_unref( SharedList *shared );
 
 static gboolean         bool_are_equal( const FMABoxed *a, const FMABoxed *b );
 static void             bool_copy( FMABoxed *dest, const FMABoxed *src );
@@ -136,6 +155,7 @@ static void            *string_to_void( const FMABoxed *boxed );
 static gboolean         string_list_are_equal( const FMABoxed *a, const FMABoxed *b );
 static void             string_list_copy( FMABoxed *dest, const FMABoxed *src );
 static void             string_list_free( FMABoxed *boxed );
+static void             string_list_set_shared( FMABoxed *boxed, GSList *list );
 static void             string_list_from_string( FMABoxed *boxed, const gchar *string );
 static void             string_list_from_value( FMABoxed *boxed, const GValue *value );
 static void             string_list_from_void( FMABoxed *boxed, const void *value );
@@ -482,6 +502,101 @@ string_to_array( const gchar *string )
 	return( array );
 }
 
+static guint
+shared_list_hash( gconstpointer list )
+{
+	const GSList *it;
+	guint hash;
+
+	hash = 0;
+	for( it = ( const GSList * ) list ; it ; it = it->next ){
+		hash = ( hash << 5 ) - hash + g_str_hash( it->data );
+	}
+
+	return( hash );
+}
+
+static gboolean
+shared_list_equal( gconstpointer a, gconstpointer b )
+{
+	const GSList *ia, *ib;
+
+	for( ia = a, ib = b ; ia && ib ; ia = ia->next, ib = ib->next ){
+		if( strcmp( ia->data, ib->data )){
+			return( FALSE );
+		}
+	}
+
+	return( !ia && !ib );
+}
+
+/*
+ * @list: a newly allocated list of newly allocated strings, whose
+ *  ownership is taken.
+ *
+ * Returns: the shared instance which holds the same strings in the same
+ * order, with a new reference, or %NULL if @list is empty.
+ */
+static SharedList *
+shared_list_get( GSList *list )
+{
+	SharedList *shared;
+
+	if( !list ){
+		return( NULL );
+	}
+
+	g_mutex_lock( &st_shared_mutex );
+
+	if( !st_shared_lists ){
+		st_shared_lists = g_hash_table_new( shared_list_hash, shared_list_equal );
+	}
+
+	shared = ( SharedList * ) g_hash_table_lookup( st_shared_lists, list );
+
+	if( shared ){
+		shared->refcount += 1;
+		fma_core_utils_slist_free( list );
+
+	} else {
+		shared = g_new0( SharedList, 1 );
+		shared->list = list;
+		shared->refcount = 1;
+		g_hash_table_insert( st_shared_lists, list, shared );
+	}
+
+	g_mutex_unlock( &st_shared_mutex );
+
+	return( shared );
+}
+
+static SharedList *
+shared_list_ref( SharedList *shared )
+{
+	if( shared ){
+		g_mutex_lock( &st_shared_mutex );
+		shared->refcount += 1;
+		g_mutex_unlock( &st_shared_mutex );
+	}
+
+	return( shared );
+}
+
+static void
+shared_list_unref( SharedList *shared )
+{
+	if( shared ){
+		g_mutex_lock( &st_shared_mutex );
+		shared->refcount -= 1;
+		if( !shared->refcount ){
+			g_hash_table_remove( st_shared_lists, shared->list );
+			fma_core_utils_slist_free( shared->list );
+			g_free( shared );
+		}
+		g_mutex_unlock( &st_shared_mutex );
+	}
+}
+
 /**
  * fma_boxed_set_type:
  * @boxed: this #FMABoxed object.
@@ -1118,26 +1233,12 @@ string_to_void( const FMABoxed *boxed )
 }
 
 /* the two string lists are equal if they have the same elements in the
- * same order
+ * same order, i.e. if they share the same instance
  */
 static gboolean
 string_list_are_equal( const FMABoxed *a, const FMABoxed *b )
 {
-	GSList *ia, *ib;
-	gboolean diff = FALSE;
-
-	guint na = g_slist_length( a->private->u.string_list );
-	guint nb = g_slist_length( b->private->u.string_list );
-
-	if( na != nb ) return( FALSE );
-
-	for( ia=a->private->u.string_list, ib=b->private->u.string_list ; ia && ib && !diff ; ia=ia->next, ib=ib->next ){
-		if( strcmp( ia->data, ib->data ) != 0 ){
-			diff = TRUE;
-		}
-	}
-
-	return( !diff );
+	return( a->private->shared == b->private->shared );
 }
 
 static void
@@ -1146,18 +1247,30 @@ string_list_copy( FMABoxed *dest, const FMABoxed *src )
 	if( dest->private->is_set ){
 		string_list_free( dest );
 	}
-	dest->private->u.string_list = fma_core_utils_slist_duplicate( src->private->u.string_list );
+	dest->private->shared = shared_list_ref( src->private->shared );
+	dest->private->u.string_list = src->private->u.string_list;
 	dest->private->is_set = TRUE;
 }
 
 static void
 string_list_free( FMABoxed *boxed )
 {
-	fma_core_utils_slist_free( boxed->private->u.string_list );
+	shared_list_unref( boxed->private->shared );
+	boxed->private->shared = NULL;
 	boxed->private->u.string_list = NULL;
 	boxed->private->is_set = FALSE;
 }
 
+/*
+ * @list: the newly built list, whose ownership is taken.
+ */
+static void
+string_list_set_shared( FMABoxed *boxed, GSList *list )
+{
+	boxed->private->shared = shared_list_get( list );
+	boxed->private->u.string_list = boxed->private->shared ? boxed->private->shared->list : NULL;
+}
+
 /*
  * accept string list both:
  * - as a semi-comma-separated list of strings
@@ -1168,21 +1281,25 @@ string_list_from_string( FMABoxed *boxed, const gchar *string )
 {
 	gchar **array;
 	gchar **i;
+	GSList *list;
 
 	array = string_to_array( string );
+	list = NULL;
 
 	if( array ){
 		i = ( gchar ** ) array;
 		while( *i ){
-			if( !fma_core_utils_slist_count( boxed->private->u.string_list, ( const gchar * )( *i ))){
-				boxed->private->u.string_list = g_slist_prepend( boxed->private->u.string_list, g_strdup( *i ));
+			if( !fma_core_utils_slist_count( list, ( const gchar * )( *i ))){
+				list = g_slist_prepend( list, g_strdup( *i ));
 			}
 			i++;
 		}
-		boxed->private->u.string_list = g_slist_reverse( boxed->private->u.string_list );
+		list = g_slist_reverse( list );
 	}
 
 	g_strfreev( array );
+
+	string_list_set_shared( boxed, list );
 }
 
 static void
@@ -1196,14 +1313,18 @@ string_list_from_void( FMABoxed *boxed, const void *value )
 {
 	GSList *value_slist;
 	GSList *it;
+	GSList *list;
 
 	value_slist = ( GSList * ) value;
+	list = NULL;
+
 	for( it = value_slist ; it ; it = it->next ){
-		if( !fma_core_utils_slist_count( boxed->private->u.string_list, ( const gchar * ) it->data )){
-			boxed->private->u.string_list = g_slist_prepend( boxed->private->u.string_list, g_strdup(( const gchar * ) it->data ));
+		if( !fma_core_utils_slist_count( list, ( const gchar * ) it->data )){
+			list = g_slist_prepend( list, g_strdup(( const gchar * ) it->data ));
 		}
 	}
-	boxed->private->u.string_list = g_slist_reverse( boxed->private->u.string_list );
+
+	string_list_set_shared( boxed, g_slist_reverse( list ));
 }
 
 static gconstpointer
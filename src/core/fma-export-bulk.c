@@ -0,0 +1,481 @@
+/*
+ * FileManager-Actions
+ * A file-manager extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * FileManager-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * FileManager-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileManager-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <api/fma-core-utils.h>
+
+#include "fma-export-bulk.h"
+#include "fma-exporter.h"
+
+#define STAGING_TEMPLATE				".fma-export-XXXXXX"
+#define DEFAULT_WORKERS					4
+
+/* the data shared by all workers during a run
+ */
+typedef struct {
+	GHashTable   *exporters;		/* format -> FMAIExporter, read-only while running */
+	gchar        *folder_uri;
+	gchar        *folder_path;		/* NULL if the target folder is not local */
+	gchar        *staging_path;		/* NULL if we are not able to stage the files */
+	gchar        *staging_uri;
+	GMainContext *context;
+	GMutex        mutex;			/* protects the counters below */
+	guint         done;
+	guint         errors;
+	guint64       bytes;
+}
+	RunData;
+
+static void     worker_run( FMAExportBulkJob *job, RunData *run );
+static gchar   *commit_staged_file( RunData *run, const gchar *staged_uri, FMAExportBulkJob *job );
+static gboolean link_no_clobber( const gchar *staged_path, const gchar *folder_path, const gchar *basename, gchar **final_basename );
+static void     sync_path( const gchar *path, gboolean is_dir );
+static void     setup_staging( RunData *run );
+static void     cleanup_staging( RunData *run );
+static void     get_progress( RunData *run, guint total, gint64 start, FMAExportBulkProgress *progress );
+
+/*
+ * fma_export_bulk_job_new:
+ * @item: the #FMAObjectItem to be exported.
+ * @format: the export format.
+ *
+ * The job holds a reference on the @item, so that the item stays alive
+ * while the workers export it, even if the caller releases it meanwhile.
+ *
+ * Returns: a newly allocated #FMAExportBulkJob structure, which should
+ * be fma_export_bulk_job_free() by the caller.
+ */
+FMAExportBulkJob *
+fma_export_bulk_job_new( FMAObjectItem *item, const gchar *format )
+{
+	FMAExportBulkJob *job;
+
+	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( item ), NULL );
+
+	job = g_new0( FMAExportBulkJob, 1 );
+	job->item = g_object_ref( item );
+	job->format = g_strdup( format );
+
+	return( job );
+}
+
+/*
+ * fma_export_bulk_job_free:
+ * @job: a #FMAExportBulkJob structure.
+ *
+ * Release the resources allocated to the @job.
+ */
+void
+fma_export_bulk_job_free( FMAExportBulkJob *job )
+{
+	if( job ){
+		g_object_unref( job->item );
+		g_free( job->format );
+		g_free( job->fname );
+		fma_core_utils_slist_free( job->msg );
+		g_free( job );
+	}
+}
+
+/*
+ * fma_export_bulk_run:
+ * @pivot: the #FMAPivot pivot for the running application.
+ * @jobs: a list of #FMAExportBulkJob structures.
+ * @folder_uri: the URI of the target folder.
+ * @max_workers: the maximum count of worker threads, or zero to use
+ *  one worker per available processor.
+ * @progress_fn: [allow-none]: a function to be called each time a job
+ *  has terminated.
+ * @user_data: user data to be passed to @progress_fn.
+ *
+ * Exports the items of the @jobs to the @folder_uri, serializing them
+ * in parallel. On return, each job has been updated with its result.
+ *
+ * Items must not be modified while they are being exported.
+ *
+ * Returns: the count of jobs which have failed.
+ */
+guint
+fma_export_bulk_run( const FMAPivot *pivot, GList *jobs, const gchar *folder_uri,
+		guint max_workers, FMAExportBulkProgressFn progress_fn, void *user_data )
+{
+	static const gchar *thisfn = "fma_export_bulk_run";
+	RunData run;
+	GList *it;
+	FMAExportBulkJob *job;
+	FMAIExporter *exporter;
+	GThreadPool *pool;
+	GError *error;
+	guint total, last_done;
+	gint64 start;
+	FMAExportBulkProgress progress;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), 0 );
+	g_return_val_if_fail( folder_uri && strlen( folder_uri ), 0 );
+
+	total = g_list_length( jobs );
+	if( max_workers == 0 ){
+#if GLIB_CHECK_VERSION( 2,36,0 )
+		max_workers = g_get_num_processors();
+#else
+		max_workers = DEFAULT_WORKERS;
+#endif
+	}
+
+	g_debug( "%s: pivot=%p, jobs=%p (count=%u), folder_uri=%s, max_workers=%u",
+			thisfn, ( void * ) pivot, ( void * ) jobs, total, folder_uri, max_workers );
+
+	memset( &run, '\0', sizeof( RunData ));
+	g_mutex_init( &run.mutex );
+	run.folder_uri = g_strdup( folder_uri );
+	run.context = g_main_context_ref_thread_default();
+
+	/* enumerating the export formats is not thread-safe: providers are
+	 * resolved here once per format, before any worker is started
+	 */
+	run.exporters = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	for( it = jobs ; it ; it = it->next ){
+		job = ( FMAExportBulkJob * ) it->data;
+		if( !g_hash_table_contains( run.exporters, job->format )){
+			exporter = fma_exporter_find_for_format( pivot, job->format );
+			g_hash_table_insert( run.exporters, g_strdup( job->format ), exporter );
+		}
+	}
+
+	setup_staging( &run );
+
+	start = g_get_monotonic_time();
+	error = NULL;
+	pool = NULL;
+
+	if( total > 1 && max_workers > 1 ){
+		pool = g_thread_pool_new(( GFunc ) worker_run, &run, max_workers, FALSE, &error );
+		if( !pool ){
+			g_warning( "%s: %s", thisfn, error->message );
+			g_error_free( error );
+		}
+	}
+
+	if( pool ){
+		for( it = jobs ; it ; it = it->next ){
+			g_thread_pool_push( pool, it->data, NULL );
+		}
+
+		/* keep the caller's main context alive while the workers are
+		 * busy; each terminated job wakes the context up
+		 */
+		last_done = 0;
+		while( last_done < total ){
+			g_main_context_iteration( run.context, TRUE );
+			get_progress( &run, total, start, &progress );
+			if( progress.done != last_done ){
+				last_done = progress.done;
+				if( progress_fn ){
+					( *progress_fn )( &progress, user_data );
+				}
+			}
+		}
+
+		g_thread_pool_free( pool, FALSE, TRUE );
+
+	} else {
+		for( it = jobs ; it ; it = it->next ){
+			worker_run(( FMAExportBulkJob * ) it->data, &run );
+			get_progress( &run, total, start, &progress );
+			if( progress_fn ){
+				( *progress_fn )( &progress, user_data );
+			}
+		}
+	}
+
+	if( run.staging_path ){
+		sync_path( run.folder_path, TRUE );
+		cleanup_staging( &run );
+	}
+
+	get_progress( &run, total, start, &progress );
+	g_debug( "%s: done=%u, errors=%u, bytes=%" G_GUINT64_FORMAT ", elapsed=%" G_GINT64_FORMAT "us",
+			thisfn, progress.done, progress.errors, progress.bytes, progress.elapsed );
+
+	g_hash_table_destroy( run.exporters );
+	g_main_context_unref( run.context );
+	g_mutex_clear( &run.mutex );
+	g_free( run.staging_uri );
+	g_free( run.staging_path );
+	g_free( run.folder_path );
+	g_free( run.folder_uri );
+
+	return( progress.errors );
+}
+
+/*
+ * fma_export_bulk_throughput:
+ * @progress: the current progress of a run.
+ *
+ * Returns: the count of exported items per second.
+ */
+gdouble
+fma_export_bulk_throughput( const FMAExportBulkProgress *progress )
+{
+	g_return_val_if_fail( progress, 0 );
+
+	if( progress->elapsed <= 0 ){
+		return( 0 );
+	}
+
+	return(( gdouble ) progress->done * G_USEC_PER_SEC / ( gdouble ) progress->elapsed );
+}
+
+/*
+ * items are exported to the staging directory when we have one,
+ * and then moved to the target folder
+ */
+static void
+worker_run( FMAExportBulkJob *job, RunData *run )
+{
+	FMAIExporter *exporter;
+	gchar *export_uri;
+
+	exporter = g_hash_table_lookup( run->exporters, job->format );
+
+	if( exporter ){
+		if( run->staging_path ){
+			export_uri = fma_exporter_to_file_with_exporter( exporter, job->item, run->staging_uri, job->format, &job->msg );
+			if( export_uri ){
+				job->fname = commit_staged_file( run, export_uri, job );
+				g_free( export_uri );
+			}
+		} else {
+			job->fname = fma_exporter_to_file_with_exporter( exporter, job->item, run->folder_uri, job->format, &job->msg );
+		}
+
+	} else {
+		/* i18n: FMAIExporter is an interface name, do not even try to translate */
+		job->msg = g_slist_append( job->msg,
+				g_strdup_printf( _( "No FMAIExporter implementation found for “%s” format." ), job->format ));
+	}
+
+	g_mutex_lock( &run->mutex );
+	run->done += 1;
+	run->bytes += job->size;
+	if( !job->fname ){
+		run->errors += 1;
+	}
+	g_mutex_unlock( &run->mutex );
+
+	g_main_context_wakeup( run->context );
+}
+
+/*
+ * flush the staged file to the disk, then atomically link it to the
+ * target folder
+ *
+ * Returns: the URI of the final file.
+ */
+static gchar *
+commit_staged_file( RunData *run, const gchar *staged_uri, FMAExportBulkJob *job )
+{
+	static const gchar *thisfn = "fma_export_bulk_commit_staged_file";
+	gchar *staged_path, *basename, *final_basename;
+	gchar *final_uri;
+	GStatBuf st;
+	int errsv;
+
+	final_uri = NULL;
+	staged_path = g_filename_from_uri( staged_uri, NULL, NULL );
+	g_return_val_if_fail( staged_path, NULL );
+
+	sync_path( staged_path, FALSE );
+	if( g_stat( staged_path, &st ) == 0 ){
+		job->size = st.st_size;
+	}
+
+	basename = g_path_get_basename( staged_path );
+
+	if( link_no_clobber( staged_path, run->folder_path, basename, &final_basename )){
+		final_uri = g_strdup_printf( "%s%s%s", run->folder_uri, G_DIR_SEPARATOR_S, final_basename );
+		g_free( final_basename );
+
+	} else {
+		errsv = errno;
+		g_warning( "%s: %s: %s", thisfn, basename, g_strerror( errsv ));
+		job->msg = g_slist_append( job->msg, g_strdup_printf( "%s: %s", basename, g_strerror( errsv )));
+		job->size = 0;
+	}
+
+	g_unlink( staged_path );
+	g_free( basename );
+	g_free( staged_path );
+
+	return( final_uri );
+}
+
+/*
+ * link(2) is atomic and fails if the target already exists: a counter
+ * is inserted before the extension until a free name is found
+ */
+static gboolean
+link_no_clobber( const gchar *staged_path, const gchar *folder_path, const gchar *basename, gchar **final_basename )
+{
+	gchar *stem, *ext, *dot;
+	gchar *candidate, *path;
+	gint counter;
+	gboolean ok;
+
+	stem = g_strdup( basename );
+	dot = strrchr( stem, '.' );
+	ext = g_strdup( dot ? dot : "" );
+	if( dot ){
+		*dot = '\0';
+	}
+
+	candidate = g_strdup( basename );
+	ok = FALSE;
+
+	for( counter = 0 ; ; ++counter ){
+		path = g_build_filename( folder_path, candidate, NULL );
+		ok = ( link( staged_path, path ) == 0 );
+		g_free( path );
+
+		if( ok || errno != EEXIST ){
+			break;
+		}
+
+		g_free( candidate );
+		candidate = g_strdup_printf( "%s_%d%s", stem, counter, ext );
+	}
+
+	if( ok ){
+		*final_basename = candidate;
+	} else {
+		g_free( candidate );
+	}
+
+	g_free( ext );
+	g_free( stem );
+
+	return( ok );
+}
+
+static void
+sync_path( const gchar *path, gboolean is_dir )
+{
+	static const gchar *thisfn = "fma_export_bulk_sync_path";
+	int fd;
+
+	fd = g_open( path, is_dir ? O_RDONLY | O_DIRECTORY : O_RDONLY, 0 );
+
+	if( fd < 0 ){
+		g_warning( "%s: %s: %s", thisfn, path, g_strerror( errno ));
+
+	} else {
+		if( fsync( fd ) < 0 ){
+			g_warning( "%s: %s: %s", thisfn, path, g_strerror( errno ));
+		}
+		close( fd );
+	}
+}
+
+/*
+ * the staging directory must be on the same filesystem than the target
+ * folder so that files may be linked: it is created inside of it
+ */
+static void
+setup_staging( RunData *run )
+{
+	static const gchar *thisfn = "fma_export_bulk_setup_staging";
+	gchar *template;
+
+	run->folder_path = g_filename_from_uri( run->folder_uri, NULL, NULL );
+
+	if( !run->folder_path ){
+		g_debug( "%s: %s is not a local folder, files will not be staged", thisfn, run->folder_uri );
+		return;
+	}
+
+	template = g_build_filename( run->folder_path, STAGING_TEMPLATE, NULL );
+
+	if( g_mkdtemp( template )){
+		run->staging_path = template;
+		run->staging_uri = g_filename_to_uri( template, NULL, NULL );
+
+	} else {
+		g_warning( "%s: %s: %s", thisfn, template, g_strerror( errno ));
+		g_free( template );
+	}
+}
+
+/*
+ * remove the files which may have been left by failing exporters
+ */
+static void
+cleanup_staging( RunData *run )
+{
+	static const gchar *thisfn = "fma_export_bulk_cleanup_staging";
+	GDir *dir;
+	const gchar *name;
+	gchar *path;
+
+	dir = g_dir_open( run->staging_path, 0, NULL );
+	if( dir ){
+		while(( name = g_dir_read_name( dir ))){
+			path = g_build_filename( run->staging_path, name, NULL );
+			g_unlink( path );
+			g_free( path );
+		}
+		g_dir_close( dir );
+	}
+
+	if( g_rmdir( run->staging_path ) < 0 ){
+		g_warning( "%s: %s: %s", thisfn, run->staging_path, g_strerror( errno ));
+	}
+}
+
+static void
+get_progress( RunData *run, guint total, gint64 start, FMAExportBulkProgress *progress )
+{
+	g_mutex_lock( &run->mutex );
+	progress->total = total;
+	progress->done = run->done;
+	progress->errors = run->errors;
+	progress->bytes = run->bytes;
+	g_mutex_unlock( &run->mutex );
+
+	progress->elapsed = g_get_monotonic_time() - start;
+}
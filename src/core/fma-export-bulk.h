@@ -0,0 +1,105 @@
+/*
+ * FileManager-Actions
+ * A file-manager extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * FileManager-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * FileManager-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileManager-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifndef __CORE_FMA_EXPORT_BULK_H__
+#define __CORE_FMA_EXPORT_BULK_H__
+
+/* @title: FMAExportBulk
+ * @short_description: Parallel export of a set of items
+ * @include: core/fma-export-bulk.h
+ *
+ * The bulk exporter serializes each item in its own worker thread.
+ * Each item is first exported to a staging directory created inside
+ * the target folder, fsync'ed, and then atomically moved to its final
+ * name, so that the target folder never contains a partially written
+ * file. Already existing files are never overwritten.
+ *
+ * The run is synchronous from the point of view of the caller, but
+ * the thread-default main context of the caller keeps being iterated
+ * while the workers are busy; this is also the context in which the
+ * progress callback is invoked.
+ */
+
+#include <api/fma-object-item.h>
+
+#include "fma-pivot.h"
+
+G_BEGIN_DECLS
+
+/**
+ * FMAExportBulkJob:
+ * @item:   [in] the #FMAObjectItem to be exported; the job holds a reference on it.
+ * @format: [in] the export format identifier.
+ * @fname:  [out] the URI of the exported file, or %NULL on error.
+ * @msg:    [out] a #GSList list of localized messages.
+ * @size:   [out] the size in bytes of the exported file.
+ */
+typedef struct {
+	FMAObjectItem *item;
+	gchar         *format;
+	gchar         *fname;
+	GSList        *msg;
+	guint64        size;
+}
+	FMAExportBulkJob;
+
+/**
+ * FMAExportBulkProgress:
+ * @total:   count of jobs to be exported.
+ * @done:    count of already terminated jobs.
+ * @errors:  count of jobs which have failed.
+ * @bytes:   total count of bytes written.
+ * @elapsed: elapsed time since the run has started, in microseconds.
+ */
+typedef struct {
+	guint          total;
+	guint          done;
+	guint          errors;
+	guint64        bytes;
+	gint64         elapsed;
+}
+	FMAExportBulkProgress;
+
+typedef void ( *FMAExportBulkProgressFn )( const FMAExportBulkProgress *progress, void *user_data );
+
+FMAExportBulkJob *fma_export_bulk_job_new   ( FMAObjectItem *item, const gchar *format );
+void              fma_export_bulk_job_free  ( FMAExportBulkJob *job );
+
+guint             fma_export_bulk_run       ( const FMAPivot *pivot,
+                                              GList *jobs,
+                                              const gchar *folder_uri,
+                                              guint max_workers,
+                                              FMAExportBulkProgressFn progress_fn,
+                                              void *user_data );
+
+gdouble           fma_export_bulk_throughput( const FMAExportBulkProgress *progress );
+
+G_END_DECLS
+
+#endif /* __CORE_FMA_EXPORT_BULK_H__ */
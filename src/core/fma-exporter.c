@@ -61,6 +61,8 @@ static NAExporterFormatStr st_format_ask = {
 static GList *exporter_get_formats( const FMAIExporter *exporter );
 static void   exporter_free_formats( const FMAIExporter *exporter, GList * str_list );
 static gchar *exporter_get_name( const FMAIExporter *exporter );
+static GList *exporter_flatten_items( GList *items, gboolean recurse, GList *flat );
+static guint  exporter_item_to_stream( FMAIExporter *exporter, FMAObjectItem *item, GOutputStream *stream, const gchar *format, gboolean first, gboolean last, GSList **messages );
 static void   on_pixbuf_finalized( gpointer user_data, GObject *pixbuf );
 
 /*
@@ -335,10 +337,8 @@ fma_exporter_to_file( const FMAPivot *pivot,
 {
 	static const gchar *thisfn = "fma_exporter_to_file";
 	gchar *export_uri;
-	FMAIExporterFileParmsv2 parms;
 	FMAIExporter *exporter;
 	gchar *msg;
-	gchar *name;
 
 	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), NULL );
 	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( item ), NULL );
@@ -356,38 +356,257 @@ fma_exporter_to_file( const FMAPivot *pivot,
 	exporter = fma_exporter_find_for_format( pivot, format );
 
 	if( exporter ){
-		parms.version = 2;
-		parms.exported = ( FMAObjectItem * ) item;
-		parms.folder = ( gchar * ) folder_uri;
-		parms.format = g_strdup( format );
-		parms.basename = NULL;
-		parms.messages = messages ? *messages : NULL;
+		export_uri = fma_exporter_to_file_with_exporter( exporter, item, folder_uri, format, messages );
 
-		if( FMA_IEXPORTER_GET_INTERFACE( exporter )->to_file ){
-			FMA_IEXPORTER_GET_INTERFACE( exporter )->to_file( exporter, &parms );
+	} else {
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		*messages = g_slist_append( *messages, msg );
+	}
 
-			if( parms.basename ){
-				export_uri = g_strdup_printf( "%s%s%s", folder_uri, G_DIR_SEPARATOR_S, parms.basename );
-			}
+	return( export_uri );
+}
 
-		} else {
-			name = exporter_get_name( exporter );
-			/* i18n: FMAIExporter is an interface name, do not even try to translate */
-			msg = g_strdup_printf( _( "%s FMAIExporter doesn’t implement “to_file” interface." ), name );
-			*messages = g_slist_append( *messages, msg );
-			g_free( name );
+/*
+ * fma_exporter_to_file_with_exporter:
+ * @exporter: the #FMAIExporter which provides the @format.
+ * @item: a #FMAObjectItem-derived object.
+ * @folder_uri: the URI of the target folder.
+ * @format: the target format identifier.
+ * @messages: a pointer to a #GSList list of strings; the provider
+ *  may append messages to this list, but shouldn't reinitialize it.
+ *
+ * Exports the specified @item to the target @uri in the required @format,
+ * when the @exporter has already been found by the caller, e.g. with
+ * fma_exporter_find_for_format().
+ *
+ * Contrarily to fma_exporter_to_file(), this function doesn't need to
+ * enumerate the available formats, and may so be called from a worker
+ * thread.
+ *
+ * Returns: the URI of the exported file, as a newly allocated string which
+ * should be g_free() by the caller, or %NULL if an error has been detected.
+ */
+gchar *
+fma_exporter_to_file_with_exporter( FMAIExporter *exporter,
+		const FMAObjectItem *item, const gchar *folder_uri, const gchar *format, GSList **messages )
+{
+	gchar *export_uri;
+	FMAIExporterFileParmsv2 parms;
+	gchar *msg;
+	gchar *name;
+
+	g_return_val_if_fail( FMA_IS_IEXPORTER( exporter ), NULL );
+	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( item ), NULL );
+
+	export_uri = NULL;
+
+	parms.version = 2;
+	parms.exported = ( FMAObjectItem * ) item;
+	parms.folder = ( gchar * ) folder_uri;
+	parms.format = g_strdup( format );
+	parms.basename = NULL;
+	parms.messages = messages ? *messages : NULL;
+
+	if( FMA_IEXPORTER_GET_INTERFACE( exporter )->to_file ){
+		FMA_IEXPORTER_GET_INTERFACE( exporter )->to_file( exporter, &parms );
+
+		if( messages ){
+			*messages = parms.messages;
 		}
 
-		g_free( parms.format );
+		if( parms.basename ){
+			export_uri = g_strdup_printf( "%s%s%s", folder_uri, G_DIR_SEPARATOR_S, parms.basename );
+			g_free( parms.basename );
+		}
 
 	} else {
-		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		name = exporter_get_name( exporter );
+		/* i18n: FMAIExporter is an interface name, do not even try to translate */
+		msg = g_strdup_printf( _( "%s FMAIExporter doesn’t implement “to_file” interface." ), name );
 		*messages = g_slist_append( *messages, msg );
+		g_free( name );
 	}
 
+	g_free( parms.format );
+
 	return( export_uri );
 }
 
+/*
+ * fma_exporter_to_stream:
+ * @pivot: the #FMAPivot pivot for the running application.
+ * @items: a list of #FMAObjectItem-derived objects.
+ * @recurse: whether the subitems of the menus should be exported too.
+ * @stream: the #GOutputStream to be written to.
+ * @format: the target format identifier.
+ * @messages: a pointer to a #GSList list of strings; the provider
+ *  may append messages to this list, but shouldn't reinitialize it.
+ *
+ * Exports the specified @items as a single bundle to the @stream in
+ * the required @format. When @recurse is %TRUE, each menu is followed
+ * by its subitems, so that the whole tree may be exported at once.
+ *
+ * Items are written one after the other, so that the memory footprint
+ * stays proportional to the largest exported item rather than to the
+ * whole bundle. The @stream is not closed.
+ *
+ * When the exporter does not implement the #FMAIExporterInterface.to_stream()
+ * method, a single item is still exported through its to_buffer()
+ * method.
+ *
+ * Returns: the #FMAIExporterExportStatus status of the operation.
+ */
+guint
+fma_exporter_to_stream( const FMAPivot *pivot,
+		GList *items, gboolean recurse, GOutputStream *stream, const gchar *format, GSList **messages )
+{
+	static const gchar *thisfn = "fma_exporter_to_stream";
+	guint code;
+	FMAIExporter *exporter;
+	GList *flat, *it;
+	gchar *name;
+	gchar *msg;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), FMA_IEXPORTER_CODE_ERROR );
+	g_return_val_if_fail( G_IS_OUTPUT_STREAM( stream ), FMA_IEXPORTER_CODE_INVALID_TARGET );
+
+	g_debug( "%s: pivot=%p, items=%p (count=%d), recurse=%s, stream=%p, format=%s, messages=%p",
+			thisfn,
+			( void * ) pivot,
+			( void * ) items, g_list_length( items ),
+			recurse ? "True":"False",
+			( void * ) stream,
+			format,
+			( void * ) messages );
+
+	code = FMA_IEXPORTER_CODE_OK;
+	exporter = fma_exporter_find_for_format( pivot, format );
+
+	if( !exporter ){
+		msg = g_strdup_printf( NO_IMPLEMENTATION_MSG, format );
+		if( messages ){
+			*messages = g_slist_append( *messages, msg );
+		} else {
+			g_free( msg );
+		}
+		return( FMA_IEXPORTER_CODE_INVALID_FORMAT );
+	}
+
+	flat = g_list_reverse( exporter_flatten_items( items, recurse, NULL ));
+
+	if( !flat ){
+		code = FMA_IEXPORTER_CODE_INVALID_ITEM;
+
+	} else if( !FMA_IEXPORTER_GET_INTERFACE( exporter )->to_stream && flat->next ){
+		name = exporter_get_name( exporter );
+		/* i18n: FMAIExporter is an interface name, do not even try to translate */
+		msg = g_strdup_printf( _( "%s FMAIExporter doesn’t implement “to_stream” interface." ), name );
+		if( messages ){
+			*messages = g_slist_append( *messages, msg );
+		} else {
+			g_free( msg );
+		}
+		g_free( name );
+		code = FMA_IEXPORTER_CODE_INVALID_TARGET;
+	}
+
+	for( it = flat ; it && code == FMA_IEXPORTER_CODE_OK ; it = it->next ){
+		code = exporter_item_to_stream(
+				exporter, FMA_OBJECT_ITEM( it->data ), stream, format, it == flat, it->next == NULL, messages );
+	}
+
+	g_list_free( flat );
+
+	g_debug( "%s: returning code=%u", thisfn, code );
+	return( code );
+}
+
+/*
+ * depth-first walk of the tree, so that a menu is written before its
+ * subitems; the returned list is built in reverse order
+ */
+static GList *
+exporter_flatten_items( GList *items, gboolean recurse, GList *flat )
+{
+	GList *it;
+
+	for( it = items ; it ; it = it->next ){
+		if( FMA_IS_OBJECT_ITEM( it->data )){
+			flat = g_list_prepend( flat, it->data );
+
+			if( recurse && FMA_IS_OBJECT_MENU( it->data )){
+				flat = exporter_flatten_items( fma_object_get_items( it->data ), recurse, flat );
+			}
+		}
+	}
+
+	return( flat );
+}
+
+static guint
+exporter_item_to_stream( FMAIExporter *exporter, FMAObjectItem *item,
+		GOutputStream *stream, const gchar *format, gboolean first, gboolean last, GSList **messages )
+{
+	static const gchar *thisfn = "fma_exporter_item_to_stream";
+	guint code;
+	FMAIExporterStreamParmsv2 parms;
+	FMAIExporterBufferParmsv2 bparms;
+	GError *error;
+	gchar *msg;
+
+	code = FMA_IEXPORTER_CODE_OK;
+
+	if( FMA_IEXPORTER_GET_INTERFACE( exporter )->to_stream ){
+		parms.version = 2;
+		parms.content = 1;
+		parms.exported = item;
+		parms.stream = stream;
+		parms.format = ( gchar * ) format;
+		parms.first = first;
+		parms.last = last;
+		parms.messages = messages ? *messages : NULL;
+
+		code = FMA_IEXPORTER_GET_INTERFACE( exporter )->to_stream( exporter, &parms );
+
+		if( messages ){
+			*messages = parms.messages;
+		}
+
+	} else if( FMA_IEXPORTER_GET_INTERFACE( exporter )->to_buffer ){
+		bparms.version = 2;
+		bparms.content = 1;
+		bparms.exported = item;
+		bparms.format = ( gchar * ) format;
+		bparms.buffer = NULL;
+		bparms.messages = messages ? *messages : NULL;
+
+		code = FMA_IEXPORTER_GET_INTERFACE( exporter )->to_buffer( exporter, &bparms );
+
+		if( messages ){
+			*messages = bparms.messages;
+		}
+
+		if( code == FMA_IEXPORTER_CODE_OK && bparms.buffer ){
+			error = NULL;
+			if( !g_output_stream_write_all( stream, bparms.buffer, strlen( bparms.buffer ), NULL, NULL, &error )){
+				msg = g_strdup_printf( "%s: %s", thisfn, error->message );
+				g_warning( "%s", msg );
+				if( messages ){
+					*messages = g_slist_append( *messages, msg );
+				} else {
+					g_free( msg );
+				}
+				g_error_free( error );
+				code = FMA_IEXPORTER_CODE_UNABLE_TO_WRITE;
+			}
+		}
+
+		g_free( bparms.buffer );
+	}
+
+	return( code );
+}
+
 static gchar *
 exporter_get_name( const FMAIExporter *exporter )
 {
@@ -61,6 +61,20 @@ gchar        *fma_exporter_to_file        ( const FMAPivot *pivot,
                                             const gchar *format,
                                             GSList **messages );
 
+gchar        *fma_exporter_to_file_with_exporter
+                                          ( FMAIExporter *exporter,
+                                            const FMAObjectItem *item,
+                                            const gchar *folder_uri,
+                                            const gchar *format,
+                                            GSList **messages );
+
+guint         fma_exporter_to_stream      ( const FMAPivot *pivot,
+                                            GList *items,
+                                            gboolean recurse,
+                                            GOutputStream *stream,
+                                            const gchar *format,
+                                            GSList **messages );
+
 FMAIExporter *fma_exporter_find_for_format( const FMAPivot *pivot,
 		                                    const gchar *format );
 
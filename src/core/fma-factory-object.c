@@ -89,9 +89,40 @@ typedef struct {
 }
 	NafoDefaultIter;
 
+/* the edition status of an object, maintained on write
+ *
+ * - stamp is updated each time a data of the object is written; it lets
+ *   the duplicates of the object know that their origin has changed
+ * - when eq_tracked, 'modified' is the set of the names of the
+ *   comparable data which differ from those of 'origin', as it was at
+ *   'origin_stamp'
+ * - when valid_tracked, 'invalid' is the set of the names of the data
+ *   whose value is not valid, and mandatory_set is TRUE if all the
+ *   mandatory data are set
+ * - dirty is set when the status of this object or of one of its
+ *   descendants has to be rechecked; it is propagated to the parents
+ *   on write
+ */
+typedef struct {
+	guint                    stamp;
+	gboolean                 dirty;
+	gboolean                 eq_tracked;
+	const FMAIFactoryObject *origin;
+	guint                    origin_stamp;
+	GHashTable              *modified;
+	gboolean                 valid_tracked;
+	gboolean                 mandatory_set;
+	GHashTable              *invalid;
+}
+	NafoStatus;
+
+#define FMA_IFACTORY_OBJECT_PROP_STATUS			"fma-ifactory-object-prop-status"
+
 extern gboolean                   ifactory_object_initialized;
 extern gboolean                   ifactory_object_finalized;
 
+static gint                       st_stamp = 0;		/* atomically incremented, as providers may be read concurrently */
+
 static gboolean      define_class_properties_iter( const FMADataDef *def, GObjectClass *class );
 static gboolean      set_defaults_iter( FMADataDef *def, NafoDefaultIter *data );
 static gboolean      is_valid_mandatory_iter( const FMADataDef *def, NafoValidIter *data );
@@ -108,6 +139,11 @@ static guint         v_write_start( FMAIFactoryObject *serializable, const FMAIF
 static guint         v_write_done( FMAIFactoryObject *serializable, const FMAIFactoryProvider *reader, void *reader_data, GSList **messages );
 
 static void          attach_boxed_to_object( FMAIFactoryObject *object, FMADataBoxed *boxed );
+static NafoStatus   *status_get( const FMAIFactoryObject *object );
+static void          status_free( NafoStatus *status );
+static void          status_touch( const FMAIFactoryObject *object );
+static void          status_reset( const FMAIFactoryObject *object );
+static void          status_update_field( FMAIFactoryObject *object, FMADataBoxed *boxed );
 static void          free_data_boxed_list( FMAIFactoryObject *object );
 static void          iter_on_data_defs( const FMADataGroup *idgroups, guint mode, FMADataDefIterFunc pfn, void *user_data );
 
@@ -293,6 +329,7 @@ fma_factory_object_set_defaults( FMAIFactoryObject *object )
 		iter_on_data_defs( groups, DATA_DEF_ITER_SET_DEFAULTS, ( FMADataDefIterFunc ) set_defaults_iter, iter_data );
 
 		g_free( iter_data );
+		status_reset( object );
 	}
 }
 
@@ -343,6 +380,9 @@ fma_factory_object_move_boxed( FMAIFactoryObject *target, const FMAIFactoryObjec
 		const FMADataDef *src_def = fma_data_boxed_get_data_def( boxed );
 		FMADataDef *tgt_def = fma_factory_object_get_data_def( target, src_def->name );
 		fma_data_boxed_set_data_def( boxed, tgt_def );
+
+		status_reset( source );
+		status_reset( target );
 	}
 }
 
@@ -413,6 +453,8 @@ fma_factory_object_copy( FMAIFactoryObject *target, const FMAIFactoryObject *sou
 		}
 	}
 
+	status_reset( target );
+
 	v_copy( target, source );
 }
 
@@ -429,47 +471,67 @@ fma_factory_object_are_equal( const FMAIFactoryObject *a, const FMAIFactoryObjec
 	static const gchar *thisfn = "fma_factory_object_are_equal";
 	gboolean are_equal;
 	GList *a_list, *b_list, *ia, *ib;
+	NafoStatus *status;
 
-	are_equal = FALSE;
+	g_debug( "%s: a=%p, b=%p", thisfn, ( void * ) a, ( void * ) b );
 
-	a_list = g_object_get_data( G_OBJECT( a ), FMA_IFACTORY_OBJECT_PROP_DATA );
-	b_list = g_object_get_data( G_OBJECT( b ), FMA_IFACTORY_OBJECT_PROP_DATA );
+	status = status_get( b );
 
-	g_debug( "%s: a=%p, b=%p", thisfn, ( void * ) a, ( void * ) b );
+	/* if @a is the origin of @b, and has not been modified since we
+	 * have last compared them, then the set of modified data has been
+	 * maintained on each write
+	 */
+	if( status->eq_tracked && status->origin == a && status_get( a )->stamp == status->origin_stamp ){
+		are_equal = ( g_hash_table_size( status->modified ) == 0 );
 
-	are_equal = TRUE;
-	for( ia = a_list ; ia && are_equal ; ia = ia->next ){
+	} else {
+		a_list = g_object_get_data( G_OBJECT( a ), FMA_IFACTORY_OBJECT_PROP_DATA );
+		b_list = g_object_get_data( G_OBJECT( b ), FMA_IFACTORY_OBJECT_PROP_DATA );
 
-		FMADataBoxed *a_boxed = FMA_DATA_BOXED( ia->data );
-		const FMADataDef *a_def = fma_data_boxed_get_data_def( a_boxed );
-		if( a_def->comparable ){
+		g_hash_table_remove_all( status->modified );
 
-			FMADataBoxed *b_boxed = fma_ifactory_object_get_data_boxed( b, a_def->name );
-			if( b_boxed ){
-				are_equal = fma_boxed_are_equal( FMA_BOXED( a_boxed ), FMA_BOXED( b_boxed ));
-				if( !are_equal ){
-					g_debug( "%s: %s not equal as %s different", thisfn, G_OBJECT_TYPE_NAME( a ), a_def->name );
-				}
+		for( ia = a_list ; ia ; ia = ia->next ){
 
-			} else {
-				are_equal = FALSE;
-				g_debug( "%s: %s not equal as %s has disappeared", thisfn, G_OBJECT_TYPE_NAME( a ), a_def->name );
+			FMADataBoxed *a_boxed = FMA_DATA_BOXED( ia->data );
+			const FMADataDef *a_def = fma_data_boxed_get_data_def( a_boxed );
+			if( a_def->comparable ){
+
+				FMADataBoxed *b_boxed = fma_ifactory_object_get_data_boxed( b, a_def->name );
+				if( b_boxed ){
+					if( !fma_boxed_are_equal( FMA_BOXED( a_boxed ), FMA_BOXED( b_boxed ))){
+						g_debug( "%s: %s not equal as %s different", thisfn, G_OBJECT_TYPE_NAME( a ), a_def->name );
+						g_hash_table_add( status->modified, ( gpointer ) a_def->name );
+					}
+
+				} else {
+					g_debug( "%s: %s not equal as %s has disappeared", thisfn, G_OBJECT_TYPE_NAME( a ), a_def->name );
+					g_hash_table_add( status->modified, ( gpointer ) a_def->name );
+				}
 			}
 		}
-	}
 
-	for( ib = b_list ; ib && are_equal ; ib = ib->next ){
+		for( ib = b_list ; ib ; ib = ib->next ){
 
-		FMADataBoxed *b_boxed = FMA_DATA_BOXED( ib->data );
-		const FMADataDef *b_def = fma_data_boxed_get_data_def( b_boxed );
-		if( b_def->comparable ){
+			FMADataBoxed *b_boxed = FMA_DATA_BOXED( ib->data );
+			const FMADataDef *b_def = fma_data_boxed_get_data_def( b_boxed );
+			if( b_def->comparable ){
 
-			FMADataBoxed *a_boxed = fma_ifactory_object_get_data_boxed( a, b_def->name );
-			if( !a_boxed ){
-				are_equal = FALSE;
-				g_debug( "%s: %s not equal as %s was not set", thisfn, G_OBJECT_TYPE_NAME( a ), b_def->name );
+				FMADataBoxed *a_boxed = fma_ifactory_object_get_data_boxed( a, b_def->name );
+				if( !a_boxed ){
+					g_debug( "%s: %s not equal as %s was not set", thisfn, G_OBJECT_TYPE_NAME( a ), b_def->name );
+					g_hash_table_add( status->modified, ( gpointer ) b_def->name );
+				}
 			}
 		}
+
+		are_equal = ( g_hash_table_size( status->modified ) == 0 );
+
+		/* only track the comparison against the actual origin
+		 */
+		status->eq_tracked = FMA_IS_IDUPLICABLE( b ) &&
+				( const FMAIFactoryObject * ) fma_iduplicable_get_origin( FMA_IDUPLICABLE( b )) == a;
+		status->origin = a;
+		status->origin_stamp = status_get( a )->stamp;
 	}
 
 	are_equal &= v_are_equal( a, b );
@@ -490,30 +552,43 @@ fma_factory_object_is_valid( const FMAIFactoryObject *object )
 	gboolean is_valid;
 	FMADataGroup *groups;
 	GList *list, *iv;
+	NafoStatus *status;
 
 	g_return_val_if_fail( FMA_IS_IFACTORY_OBJECT( object ), FALSE );
 
 	g_debug( "%s: object=%p (%s)", thisfn, ( void * ) object, G_OBJECT_TYPE_NAME( object ));
 
-	list = g_object_get_data( G_OBJECT( object ), FMA_IFACTORY_OBJECT_PROP_DATA );
-	is_valid = TRUE;
+	status = status_get( object );
 
-	/* mandatory data must be set
-	 */
-	NafoValidIter iter_data;
-	iter_data.object = ( FMAIFactoryObject * ) object;
-	iter_data.is_valid = TRUE;
+	if( !status->valid_tracked ){
+		list = g_object_get_data( G_OBJECT( object ), FMA_IFACTORY_OBJECT_PROP_DATA );
 
-	groups = v_get_groups( object );
-	if( groups ){
-		iter_on_data_defs( groups, DATA_DEF_ITER_IS_VALID, ( FMADataDefIterFunc ) is_valid_mandatory_iter, &iter_data );
-	}
-	is_valid = iter_data.is_valid;
+		/* mandatory data must be set
+		 */
+		NafoValidIter iter_data;
+		iter_data.object = ( FMAIFactoryObject * ) object;
+		iter_data.is_valid = TRUE;
+
+		groups = v_get_groups( object );
+		if( groups ){
+			iter_on_data_defs( groups, DATA_DEF_ITER_IS_VALID, ( FMADataDefIterFunc ) is_valid_mandatory_iter, &iter_data );
+		}
+		status->mandatory_set = iter_data.is_valid;
 
-	for( iv = list ; iv && is_valid ; iv = iv->next ){
-		is_valid = fma_data_boxed_is_valid( FMA_DATA_BOXED( iv->data ));
+		g_hash_table_remove_all( status->invalid );
+
+		for( iv = list ; iv ; iv = iv->next ){
+			if( !fma_data_boxed_is_valid( FMA_DATA_BOXED( iv->data ))){
+				g_hash_table_add( status->invalid,
+						( gpointer ) fma_data_boxed_get_data_def( FMA_DATA_BOXED( iv->data ))->name );
+			}
+		}
+
+		status->valid_tracked = TRUE;
 	}
 
+	is_valid = status->mandatory_set && g_hash_table_size( status->invalid ) == 0;
+
 	is_valid &= v_is_valid( object );
 
 	return( is_valid );
@@ -606,6 +681,8 @@ fma_factory_object_read_item( FMAIFactoryObject *object, const FMAIFactoryProvid
 	FMADataGroup *groups = v_get_groups( object );
 
 	if( groups ){
+		status_reset( object );
+
 		v_read_start( object, reader, reader_data, messages );
 
 		NafoReadIter *iter = g_new0( NafoReadIter, 1 );
@@ -620,6 +697,8 @@ fma_factory_object_read_item( FMAIFactoryObject *object, const FMAIFactoryProvid
 
 		v_read_done( object, reader, reader_data, messages );
 
+		status_reset( object );
+
 	} else {
 		g_warning( "%s: class %s doesn't return any FMADataGroup structure",
 				thisfn, G_OBJECT_TYPE_NAME( object ));
@@ -815,6 +894,7 @@ fma_factory_object_set_from_value( FMAIFactoryObject *object, const gchar *name,
 	FMADataBoxed *boxed = fma_ifactory_object_get_data_boxed( object, name );
 	if( boxed ){
 		fma_boxed_set_from_value( FMA_BOXED( boxed ), value );
+		status_update_field( object, boxed );
 
 	} else {
 		FMADataDef *def = fma_factory_object_get_data_def( object, name );
@@ -825,6 +905,7 @@ fma_factory_object_set_from_value( FMAIFactoryObject *object, const gchar *name,
 			boxed = fma_data_boxed_new( def );
 			fma_boxed_set_from_value( FMA_BOXED( boxed ), value );
 			attach_boxed_to_object( object, boxed );
+			status_update_field( object, boxed );
 		}
 	}
 }
@@ -847,6 +928,7 @@ fma_factory_object_set_from_void( FMAIFactoryObject *object, const gchar *name,
 	FMADataBoxed *boxed = fma_ifactory_object_get_data_boxed( object, name );
 	if( boxed ){
 		fma_boxed_set_from_void( FMA_BOXED( boxed ), data );
+		status_update_field( object, boxed );
 
 	} else {
 		FMADataDef *def = fma_factory_object_get_data_def( object, name );
@@ -857,10 +939,56 @@ fma_factory_object_set_from_void( FMAIFactoryObject *object, const gchar *name,
 			boxed = fma_data_boxed_new( def );
 			fma_boxed_set_from_void( FMA_BOXED( boxed ), data );
 			attach_boxed_to_object( object, boxed );
+			status_update_field( object, boxed );
 		}
 	}
 }
 
+/*
+ * fma_factory_object_set_dirty:
+ * @object: this #FMAIFactoryObject instance.
+ *
+ * Marks the edition status of @object as having to be rechecked, without
+ * any of its data having been written.
+ */
+void
+fma_factory_object_set_dirty( FMAIFactoryObject *object )
+{
+	g_return_if_fail( FMA_IS_IFACTORY_OBJECT( object ));
+
+	status_reset( object );
+}
+
+/*
+ * fma_factory_object_is_dirty:
+ * @object: this #FMAIFactoryObject instance.
+ *
+ * Returns: %TRUE if the edition status of @object, or of one of its
+ * descendants, may have changed since the last fma_factory_object_set_clean().
+ */
+gboolean
+fma_factory_object_is_dirty( const FMAIFactoryObject *object )
+{
+	g_return_val_if_fail( FMA_IS_IFACTORY_OBJECT( object ), TRUE );
+
+	return( status_get( object )->dirty );
+}
+
+/*
+ * fma_factory_object_set_clean:
+ * @object: this #FMAIFactoryObject instance.
+ *
+ * Records that the edition status of @object and of its descendants is
+ * up to date.
+ */
+void
+fma_factory_object_set_clean( FMAIFactoryObject *object )
+{
+	g_return_if_fail( FMA_IS_IFACTORY_OBJECT( object ));
+
+	status_get( object )->dirty = FALSE;
+}
+
 static FMADataGroup *
 v_get_groups( const FMAIFactoryObject *object )
 {
@@ -947,6 +1075,121 @@ attach_boxed_to_object( FMAIFactoryObject *object, FMADataBoxed *boxed )
 	g_object_set_data( G_OBJECT( object ), FMA_IFACTORY_OBJECT_PROP_DATA, list );
 }
 
+static NafoStatus *
+status_get( const FMAIFactoryObject *object )
+{
+	NafoStatus *status;
+
+	status = g_object_get_data( G_OBJECT( object ), FMA_IFACTORY_OBJECT_PROP_STATUS );
+
+	if( !status ){
+		status = g_new0( NafoStatus, 1 );
+		status->stamp = ( guint ) g_atomic_int_add( &st_stamp, 1 ) + 1;
+		status->dirty = TRUE;
+		status->eq_tracked = FALSE;
+		status->modified = g_hash_table_new( g_str_hash, g_str_equal );
+		status->valid_tracked = FALSE;
+		status->invalid = g_hash_table_new( g_str_hash, g_str_equal );
+		g_object_set_data_full( G_OBJECT( object ), FMA_IFACTORY_OBJECT_PROP_STATUS, status, ( GDestroyNotify ) status_free );
+	}
+
+	return( status );
+}
+
+static void
+status_free( NafoStatus *status )
+{
+	g_hash_table_destroy( status->modified );
+	g_hash_table_destroy( status->invalid );
+	g_free( status );
+}
+
+/*
+ * a data of @object has been written: the status of the object has to
+ * be rechecked, and so has the status of all its parents
+ */
+static void
+status_touch( const FMAIFactoryObject *object )
+{
+	NafoStatus *status;
+	FMAObjectItem *parent;
+
+	status = status_get( object );
+	status->stamp = ( guint ) g_atomic_int_add( &st_stamp, 1 ) + 1;
+	status->dirty = TRUE;
+
+	for( parent = fma_object_get_parent( object ) ; parent ; parent = fma_object_get_parent( parent )){
+		status = status_get( FMA_IFACTORY_OBJECT( parent ));
+		if( status->dirty ){
+			break;
+		}
+		status->dirty = TRUE;
+	}
+}
+
+/*
+ * the data of @object have been written in a way which does not let us
+ * maintain the status: it will be fully rechecked
+ */
+static void
+status_reset( const FMAIFactoryObject *object )
+{
+	NafoStatus *status;
+
+	status_touch( object );
+
+	status = status_get( object );
+	status->eq_tracked = FALSE;
+	status->valid_tracked = FALSE;
+}
+
+/*
+ * @boxed, attached to @object, has just been written: only compare this
+ * elementary data against the origin of @object
+ */
+static void
+status_update_field( FMAIFactoryObject *object, FMADataBoxed *boxed )
+{
+	NafoStatus *status;
+	const FMADataDef *def;
+	const FMAIFactoryObject *origin;
+	FMADataBoxed *origin_boxed;
+
+	status_touch( object );
+
+	status = status_get( object );
+	def = fma_data_boxed_get_data_def( boxed );
+
+	if( status->eq_tracked ){
+		origin = FMA_IS_IDUPLICABLE( object ) ?
+				( const FMAIFactoryObject * ) fma_iduplicable_get_origin( FMA_IDUPLICABLE( object )) : NULL;
+
+		if( origin != status->origin || status_get( origin )->stamp != status->origin_stamp ){
+			status->eq_tracked = FALSE;
+
+		} else if( def->comparable ){
+			origin_boxed = fma_ifactory_object_get_data_boxed( origin, def->name );
+			if( origin_boxed && fma_boxed_are_equal( FMA_BOXED( origin_boxed ), FMA_BOXED( boxed ))){
+				g_hash_table_remove( status->modified, def->name );
+			} else {
+				g_hash_table_add( status->modified, ( gpointer ) def->name );
+			}
+		}
+	}
+
+	if( status->valid_tracked ){
+		if( def->mandatory && !status->mandatory_set ){
+			status->valid_tracked = FALSE;
+
+		} else if( fma_data_boxed_is_valid( boxed )){
+			g_hash_table_remove( status->invalid, def->name );
+
+		} else {
+			g_hash_table_add( status->invalid, ( gpointer ) def->name );
+		}
+	}
+}
+
 static void
 free_data_boxed_list( FMAIFactoryObject *object )
 {
@@ -72,6 +72,10 @@ gboolean      fma_factory_object_is_set           ( const FMAIFactoryObject *obj
 void          fma_factory_object_set_from_value   ( FMAIFactoryObject *object, const gchar *name, const GValue *value );
 void          fma_factory_object_set_from_void    ( FMAIFactoryObject *object, const gchar *name, const void *data );
 
+void          fma_factory_object_set_dirty        ( FMAIFactoryObject *object );
+gboolean      fma_factory_object_is_dirty         ( const FMAIFactoryObject *object );
+void          fma_factory_object_set_clean        ( FMAIFactoryObject *object );
+
 G_END_DECLS
 
 #endif /* __CORE_FMA_FACTORY_OBJECT_H__ */
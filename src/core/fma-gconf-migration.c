@@ -31,10 +31,31 @@
 #include <config.h>
 #endif
 
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include <glib/gstdio.h>
+
 #include "fma-gconf-migration.h"
 
 #define MIGRATION_COMMAND				PKGLIBEXECDIR "/fma-gconf2key.sh -delete -nodummy -verbose"
 
+/* the marker records the stamp of the user GConf tree as it was after
+ * the last successful migration; the migration is only run again when
+ * this stamp has changed
+ */
+#define MIGRATION_MARKER				"gconf-migration.stamp"
+
+#ifdef HAVE_GCONF
+static gchar   *get_gconf_stamp( void );
+static void     get_gconf_stamp_rec( const gchar *path, time_t *stamp );
+static gboolean is_exit_ok( gint status, GError **error );
+static gchar   *get_marker_path( void );
+static gboolean is_already_migrated( const gchar *marker, const gchar *stamp );
+static void     set_migrated( const gchar *marker );
+#endif /* HAVE_GCONF */
+
 /**
  * fma_gconf_migration_run:
  *
@@ -42,6 +63,9 @@
  * Disable GConf I/O provider both for reading and writing.
  * Migrate users preferences to FMASettings.
  *
+ * Since 3.5, the migration is skipped when the user GConf tree has not
+ * been modified since the last successful migration.
+ *
  * Since: 3.1
  */
 void
@@ -50,23 +74,167 @@ fma_gconf_migration_run( void )
 	static const gchar *thisfn = "fma_gconf_migration_run";
 #ifdef HAVE_GCONF
 	gchar *out, *err;
+	gchar *marker, *stamp;
+	gint status;
 	GError *error;
 
-	g_debug( "%s: running %s", thisfn, MIGRATION_COMMAND );
+	marker = get_marker_path();
+	stamp = get_gconf_stamp();
 
-	error = NULL;
-	if( !g_spawn_command_line_sync( MIGRATION_COMMAND, &out, &err, NULL, &error )){
-		g_warning( "%s: %s", thisfn, error->message );
-		g_error_free( error );
-		error = NULL;
+	if( is_already_migrated( marker, stamp )){
+		g_debug( "%s: GConf tree unchanged since last migration (stamp=%s)", thisfn, stamp );
 
 	} else {
-		g_debug( "%s: out=%s", thisfn, out );
-		g_debug( "%s: err=%s", thisfn, err );
-		g_free( out );
-		g_free( err );
+		g_debug( "%s: running %s", thisfn, MIGRATION_COMMAND );
+
+		error = NULL;
+		if( !g_spawn_command_line_sync( MIGRATION_COMMAND, &out, &err, &status, &error )){
+			g_warning( "%s: %s", thisfn, error->message );
+			g_error_free( error );
+			error = NULL;
+
+		} else {
+			g_debug( "%s: out=%s", thisfn, out );
+			g_debug( "%s: err=%s", thisfn, err );
+			g_free( out );
+			g_free( err );
+
+			if( is_exit_ok( status, &error )){
+				set_migrated( marker );
+
+			} else {
+				g_warning( "%s: %s", thisfn, error->message );
+				g_error_free( error );
+			}
+		}
 	}
+
+	g_free( stamp );
+	g_free( marker );
 #else
 	g_debug( "%s: GConf support is disabled, no migration", thisfn );
 #endif /* HAVE_GCONF */
 }
+
+#ifdef HAVE_GCONF
+/*
+ * g_spawn_check_exit_status() is only available since GLib 2.34
+ */
+static gboolean
+is_exit_ok( gint status, GError **error )
+{
+#if GLIB_CHECK_VERSION( 2, 34, 0 )
+	return( g_spawn_check_exit_status( status, error ));
+#else
+	if( WIFEXITED( status ) && WEXITSTATUS( status ) == 0 ){
+		return( TRUE );
+	}
+
+	g_set_error( error, G_SPAWN_ERROR, G_SPAWN_ERROR_FAILED,
+			"%s: abnormal exit status %d", MIGRATION_COMMAND, status );
+
+	return( FALSE );
+#endif
+}
+
+/*
+ * the stamp of the user GConf tree is the most recent modification time
+ * of the package directory, of all its subdirectories down to the leaf
+ * ones, and of the %gconf.xml files they contain; it is "0" when the tree
+ * doesn't exist
+ */
+static gchar *
+get_gconf_stamp( void )
+{
+	gchar *root;
+	time_t stamp;
+
+	stamp = 0;
+	root = g_build_filename( g_get_home_dir(), ".gconf", "apps", PACKAGE, NULL );
+
+	get_gconf_stamp_rec( root, &stamp );
+
+	g_free( root );
+
+	return( g_strdup_printf( "%" G_GINT64_FORMAT, ( gint64 ) stamp ));
+}
+
+static void
+get_gconf_stamp_rec( const gchar *path, time_t *stamp )
+{
+	GStatBuf st;
+	GDir *dir_handle;
+	const gchar *name;
+	gchar *child;
+
+	if( g_lstat( path, &st ) == 0 ){
+		if( st.st_mtime > *stamp ){
+			*stamp = st.st_mtime;
+		}
+
+		if( S_ISDIR( st.st_mode )){
+			dir_handle = g_dir_open( path, 0, NULL );
+
+			if( dir_handle ){
+				while(( name = g_dir_read_name( dir_handle ))){
+					child = g_build_filename( path, name, NULL );
+					get_gconf_stamp_rec( child, stamp );
+					g_free( child );
+				}
+				g_dir_close( dir_handle );
+			}
+		}
+	}
+}
+
+static gchar *
+get_marker_path( void )
+{
+	return( g_build_filename( g_get_user_config_dir(), PACKAGE, MIGRATION_MARKER, NULL ));
+}
+
+static gboolean
+is_already_migrated( const gchar *marker, const gchar *stamp )
+{
+	gchar *contents;
+	gboolean migrated;
+
+	migrated = FALSE;
+
+	if( g_file_get_contents( marker, &contents, NULL, NULL )){
+		migrated = ( strcmp( g_strstrip( contents ), stamp ) == 0 );
+		g_free( contents );
+	}
+
+	return( migrated );
+}
+
+/*
+ * the stamp is computed again as the migration has most probably
+ * removed the GConf tree
+ */
+static void
+set_migrated( const gchar *marker )
+{
+	static const gchar *thisfn = "fma_gconf_migration_set_migrated";
+	gchar *dir, *stamp;
+	GError *error;
+
+	dir = g_path_get_dirname( marker );
+	g_mkdir_with_parents( dir, 0750 );
+	g_free( dir );
+
+	stamp = get_gconf_stamp();
+	error = NULL;
+
+	if( !g_file_set_contents( marker, stamp, -1, &error )){
+		g_warning( "%s: %s: %s", thisfn, marker, error->message );
+		g_error_free( error );
+
+	} else {
+		g_debug( "%s: stamp=%s", thisfn, stamp );
+	}
+
+	g_free( stamp );
+}
+#endif /* HAVE_GCONF */
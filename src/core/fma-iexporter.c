@@ -112,6 +112,7 @@ interface_base_init( FMAIExporterInterface *klass )
 		klass->get_formats = NULL;
 		klass->to_file = NULL;
 		klass->to_buffer = NULL;
+		klass->to_stream = NULL;
 	}
 
 	st_initializations += 1;
@@ -126,6 +126,11 @@ interface_base_init( FMAIIOProviderInterface *klass )
 		klass->write_item = NULL;
 		klass->delete_item = NULL;
 		klass->duplicate_data = NULL;
+		klass->write_items_start = NULL;
+		klass->write_items_done = NULL;
+		klass->write_items_abort = NULL;
+		klass->read_item = NULL;
+		klass->read_items_is_thread_safe = NULL;
 
 		/**
 		 * FMAIIOProvider::io-provider-item-changed:
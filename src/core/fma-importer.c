@@ -89,7 +89,7 @@ static FMAImportModeStr st_import_ask_mode = {
 			"fma-import-mode-ask.png"
 };
 
-static FMAImporterResult *import_from_uri( const FMAPivot *pivot, GList *modules, const gchar *uri );
+static GList             *import_from_uri( const FMAPivot *pivot, GList *modules, const gchar *uri, GList *results );
 static void               manage_import_mode( FMAImporterParms *parms, GList *results, FMAImporterAskUserParms *ask_parms, FMAImporterResult *result );
 static FMAObjectItem     *is_importing_already_exists( FMAImporterParms *parms, GList *results, FMAImporterResult *result );
 static void               renumber_label_item( FMAObjectItem *item );
@@ -120,6 +120,9 @@ static FMAIOption        *get_mode_from_struct( const FMAImportModeStr *str );
  * - a #FMAObjectItem item if import was successful, or %NULL
  * - a list of error messages, or %NULL.
  *
+ * An URI which holds a bundle of several items gives one result per
+ * imported item, the messages being attached to the first one.
+ *
  * Returns: a #GList of #FMAImporterResult structures
  * (was the last import operation code up to 3.2).
  *
@@ -148,8 +151,7 @@ fma_importer_import_from_uris( const FMAPivot *pivot, FMAImporterParms *parms )
 	modules = fma_pivot_get_providers( pivot, FMA_TYPE_IIMPORTER );
 
 	for( uri = parms->uris ; uri ; uri = uri->next ){
-		import_result = import_from_uri( pivot, modules, ( const gchar * ) uri->data );
-		results = g_list_prepend( results, import_result );
+		results = import_from_uri( pivot, modules, ( const gchar * ) uri->data, results );
 	}
 
 	fma_pivot_free_providers( modules );
@@ -211,13 +213,15 @@ fma_importer_free_result( FMAImporterResult *result )
  * We so let each interface push its messages in the list, but be ready to
  * only keep the messages provided by the interface which has successfully
  * imported the item.
+ *
+ * The results are prepended to the provided list, which is returned.
  */
-static FMAImporterResult *
-import_from_uri( const FMAPivot *pivot, GList *modules, const gchar *uri )
+static GList *
+import_from_uri( const FMAPivot *pivot, GList *modules, const gchar *uri, GList *results )
 {
 	FMAImporterResult *result;
 	FMAIImporterImportFromUriParmsv2 provider_parms;
-	GList *im;
+	GList *im, *ib;
 	guint code;
 	GSList *all_messages;
 	FMAIImporter *provider;
@@ -229,7 +233,7 @@ import_from_uri( const FMAPivot *pivot, GList *modules, const gchar *uri )
 
 	memset( &provider_parms, '\0', sizeof( FMAIImporterImportFromUriParmsv2 ));
 	provider_parms.version = 2;
-	provider_parms.content = 1;
+	provider_parms.content = 2;
 	provider_parms.uri = uri;
 
 	for( im = modules ;
@@ -261,8 +265,19 @@ import_from_uri( const FMAPivot *pivot, GList *modules, const gchar *uri )
 	result->imported = provider_parms.imported;
 	result->importer = provider;
 	result->messages = all_messages;
+	results = g_list_prepend( results, result );
+
+	for( ib = provider_parms.bundled ; ib ; ib = ib->next ){
+		result = g_new0( FMAImporterResult, 1 );
+		result->uri = g_strdup( uri );
+		result->imported = FMA_OBJECT_ITEM( ib->data );
+		result->importer = provider;
+		results = g_list_prepend( results, result );
+	}
 
-	return( result );
+	g_list_free( provider_parms.bundled );
+
+	return( results );
 }
 
 /*
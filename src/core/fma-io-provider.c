@@ -56,6 +56,8 @@ struct _FMAIOProviderPrivate {
 	gulong          item_changed_handler;
 	gboolean        writable;
 	guint           reason;
+	const FMAPivot *pivot;				/* only set while the plugin is deferred */
+	gboolean        deferred;			/* whether the plugin is still to be loaded */
 };
 
 /* FMAIOProvider properties
@@ -66,6 +68,19 @@ enum {
 
 #define IO_PROVIDER_PROP_ID				"fma-io-provider-prop-id"
 
+/* the reading of an I/O provider, which may happen in its own thread
+ * if the provider says it is thread-safe
+ */
+typedef struct {
+	const FMAIOProvider  *provider_object;
+	const FMAIIOProvider *provider_module;
+	GThread              *thread;
+	GList                *items;
+	GSList               *messages;
+	gboolean              want_messages;
+}
+	ProviderRead;
+
 static const gchar   *st_enter_bug    = N_( "Please, be kind enough to fill out a bug report on "
 											"https://gitlab.gnome.org/GNOME/filemanager-actions/issues." );
 
@@ -86,6 +101,7 @@ static void           dump( const FMAIOProvider *provider );
 static void           dump_providers_list( GList *providers );
 #endif
 static FMAIOProvider *io_provider_new( const FMAPivot *pivot, FMAIIOProvider *module, const gchar *id );
+static FMAIIOProvider *io_provider_get_module( const FMAIOProvider *provider );
 static GList         *io_providers_list_add_from_plugins( const FMAPivot *pivot, GList *list );
 static GList         *io_providers_list_add_from_prefs( const FMAPivot *pivot, GList *objects_list );
 static GSList        *io_providers_get_from_prefs( void );
@@ -97,9 +113,13 @@ static gboolean       is_finally_writable( const FMAIOProvider *provider, const
 static GList         *load_items_filter_unwanted_items( const FMAPivot *pivot, GList *merged, guint loadable_set );
 static GList         *load_items_filter_unwanted_items_rec( GList *merged, guint loadable_set );
 static GList         *load_items_get_merged_list( const FMAPivot *pivot, guint loadable_set, GSList **messages );
+static gboolean       load_items_is_thread_safe( const ProviderRead *read );
+static gpointer       load_items_read_provider( ProviderRead *read );
 static GList         *load_items_hierarchy_build( GList **tree, GSList *level_zero, gboolean list_if_empty, FMAObjectItem *parent );
+static GList         *load_items_hierarchy_build_rec( GList **tree, GHashTable *index, GSList *ids, FMAObjectItem *parent );
 static GList         *load_items_hierarchy_sort( const FMAPivot *pivot, GList *tree, GCompareFunc fn );
-static gint           peek_item_by_id_compare( const FMAObject *obj, const gchar *id );
+static FMAObjectItem *load_item_get_from_tree( GList *tree, const gchar *id );
+static gboolean       load_item_is_level_zero( const gchar *id );
 static FMAIOProvider *peek_provider_by_id( const GList *providers, const gchar *id );
 
 GType
@@ -188,6 +208,8 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->item_changed_handler = 0;
 	self->private->writable = FALSE;
 	self->private->reason = IIO_PROVIDER_STATUS_UNAVAILABLE;
+	self->private->pivot = NULL;
+	self->private->deferred = FALSE;
 }
 
 static void
@@ -327,6 +349,7 @@ fma_io_provider_find_writable_io_provider( const FMAPivot *pivot )
 
 	for( ip = providers ; ip ; ip = ip->next ){
 		provider = ( FMAIOProvider * ) ip->data;
+		io_provider_get_module( provider );
 		if( provider->private->writable ){
 			return( provider );
 		}
@@ -429,6 +452,10 @@ io_providers_list_add_from_write_order( const FMAPivot *pivot, GList *objects_li
 /*
  * add to the list a FMAIOProvider object for each loaded plugin which claim
  * to implement the FMAIIOProvider interface
+ *
+ * plugins which declare the FMAIIOProvider interface in their manifest
+ * are not loaded here, but only when the FMAIOProvider first needs them,
+ * so that unreadable I/O providers are not loaded in the file manager
  */
 static GList *
 io_providers_list_add_from_plugins( const FMAPivot *pivot, GList *objects_list )
@@ -436,11 +463,26 @@ io_providers_list_add_from_plugins( const FMAPivot *pivot, GList *objects_list )
 	static const gchar *thisfn = "fma_io_provider_io_providers_list_add_from_plugins";
 	GList *merged;
 	GList *modules_list, *im;
+	GSList *deferred, *is;
 	gchar *id;
 	FMAIIOProvider *provider_module;
+	FMAIOProvider *provider_object;
 
 	merged = objects_list;
-	modules_list = fma_pivot_get_providers( pivot, FMA_TYPE_IIO_PROVIDER );
+	deferred = fma_pivot_get_deferred_ids( pivot, FMA_TYPE_IIO_PROVIDER );
+
+	for( is = deferred ; is ; is = is->next ){
+		merged = io_providers_list_append_object( pivot, merged, NULL, ( const gchar * ) is->data );
+		provider_object = peek_provider_by_id( merged, ( const gchar * ) is->data );
+		if( !provider_object->private->provider ){
+			provider_object->private->pivot = pivot;
+			provider_object->private->deferred = TRUE;
+		}
+	}
+
+	fma_core_utils_slist_free( deferred );
+
+	modules_list = fma_pivot_get_loaded_providers( pivot, FMA_TYPE_IIO_PROVIDER );
 
 	for( im = modules_list ; im ; im = im->next ){
 
@@ -599,6 +641,37 @@ io_provider_new( const FMAPivot *pivot, FMAIIOProvider *module, const gchar *id
 	return( object );
 }
 
+/*
+ * returns the FMAIIOProvider plugin associated with the FMAIOProvider
+ * object, first loading it if it has been deferred
+ */
+static FMAIIOProvider *
+io_provider_get_module( const FMAIOProvider *provider )
+{
+	static const gchar *thisfn = "fma_io_provider_get_module";
+	FMAIOProvider *self;
+	GList *modules_list;
+
+	self = ( FMAIOProvider * ) provider;
+
+	if( self->private->deferred ){
+		self->private->deferred = FALSE;
+		g_debug( "%s: loading %s plugin", thisfn, self->private->id );
+
+		modules_list = fma_pivot_get_providers_for_id( self->private->pivot, FMA_TYPE_IIO_PROVIDER, self->private->id );
+		if( modules_list ){
+			io_providers_list_set_module( self->private->pivot, self, FMA_IIO_PROVIDER( modules_list->data ));
+		} else {
+			g_warning( "%s: %s: plugin doesn't implement FMAIIOProvider interface", thisfn, self->private->id );
+		}
+		fma_pivot_free_providers( modules_list );
+
+		self->private->pivot = NULL;
+	}
+
+	return( self->private->provider );
+}
+
 /*
  * when a IIOProvider plugin is associated with the FMAIOProvider object,
  * we connect the FMAPivot callback to the 'item-changed' signal
@@ -721,6 +794,7 @@ fma_io_provider_is_available( const FMAIOProvider *provider )
 
 	if( !provider->private->dispose_has_run ){
 
+		io_provider_get_module( provider );
 		is_available = ( provider->private->provider && FMA_IS_IIO_PROVIDER( provider->private->provider ));
 	}
 
@@ -821,6 +895,7 @@ fma_io_provider_is_finally_writable( const FMAIOProvider *provider, guint *reaso
 
 	if( !provider->private->dispose_has_run ){
 
+		io_provider_get_module( provider );
 		is_writable = provider->private->writable;
 		if( reason ){
 			*reason = provider->private->reason;
@@ -916,6 +991,113 @@ fma_io_provider_load_items( const FMAPivot *pivot, guint loadable_set, GSList **
 	return( filtered );
 }
 
+/*
+ * fma_io_provider_load_item:
+ * @pivot: the #FMAPivot object which owns the list of registered I/O
+ *  storage providers.
+ * @id: the identifier of the searched item.
+ * @loadable_set: the set of loadable items.
+ * @messages: error messages.
+ *
+ * Loads the single item identified by @id, asking each available and
+ * readable I/O provider in turn, so that the whole tree does not have to
+ * be read, ordered and filtered.
+ *
+ * As the content and the validity of a menu depend on its subitems, as
+ * an action which is a child of a disabled or invalid menu is not
+ * loadable either, and as an I/O provider may not be able to read a
+ * single item, we fall back to fma_io_provider_load_items() when the
+ * item is a menu, or an action which is not known to be at level zero,
+ * or when a provider is not able to read a single item.
+ *
+ * Returns: a newly allocated #FMAObjectItem, or %NULL if not found or
+ * not loadable. It should be fma_object_unref() by the caller.
+ */
+FMAObjectItem *
+fma_io_provider_load_item( const FMAPivot *pivot, const gchar *id, guint loadable_set, GSList **messages )
+{
+	static const gchar *thisfn = "fma_io_provider_load_item";
+	const GList *providers, *ip;
+	const FMAIOProvider *provider_object;
+	const FMAIIOProvider *provider_module;
+	FMAObjectItem *item;
+	GList *list, *filtered, *tree;
+	gboolean found, fallback;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), NULL );
+	g_return_val_if_fail( id && strlen( id ), NULL );
+
+	g_debug( "%s: pivot=%p, id=%s, loadable_set=%d, messages=%p",
+			thisfn, ( void * ) pivot, id, loadable_set, ( void * ) messages );
+
+	item = NULL;
+	found = FALSE;
+	fallback = FALSE;
+	providers = fma_io_provider_get_io_providers_list( pivot );
+
+	for( ip = providers ; ip && !found && !fallback ; ip = ip->next ){
+		provider_object = FMA_IO_PROVIDER( ip->data );
+
+		if( !fma_io_provider_is_conf_readable( provider_object, pivot, NULL )){
+			continue;
+		}
+
+		provider_module = io_provider_get_module( provider_object );
+
+		if( !provider_module ||
+			!FMA_IIO_PROVIDER_GET_INTERFACE( provider_module )->read_items ){
+			continue;
+		}
+
+		if( !FMA_IIO_PROVIDER_GET_INTERFACE( provider_module )->read_item ){
+			g_debug( "%s: %s: unable to read a single item", thisfn, provider_object->private->id );
+			fallback = TRUE;
+			continue;
+		}
+
+		item = FMA_IIO_PROVIDER_GET_INTERFACE( provider_module )->read_item( provider_module, id, messages );
+
+		if( item ){
+			found = TRUE;
+
+			/* an action which may be a child of a menu is only loadable
+			 * if all its parents are themselves enabled and valid: only
+			 * the whole tree tells it
+			 */
+			if( FMA_IS_OBJECT_MENU( item ) || !load_item_is_level_zero( id )){
+				fma_object_unref( item );
+				item = NULL;
+				fallback = TRUE;
+
+			} else {
+				fma_object_set_provider( item, provider_object );
+				fma_object_dump( item );
+
+				list = g_list_prepend( NULL, item );
+				filtered = load_items_filter_unwanted_items( pivot, list, loadable_set );
+				item = filtered ? FMA_OBJECT_ITEM( filtered->data ) : NULL;
+				g_list_free( filtered );
+				g_list_free( list );
+			}
+		}
+	}
+
+	if( fallback ){
+		g_debug( "%s: falling back to loading the whole tree", thisfn );
+		tree = fma_io_provider_load_items( pivot, loadable_set, messages );
+		item = load_item_get_from_tree( tree, id );
+
+		if( item ){
+			fma_object_ref( item );
+			fma_object_set_parent( item, NULL );
+		}
+
+		fma_object_free_items( tree );
+	}
+
+	return( item );
+}
+
 #if 0
 static void
 dump( const FMAIOProvider *provider )
@@ -1099,79 +1281,168 @@ load_items_filter_unwanted_items_rec( GList *hierarchy, guint loadable_set )
  * - i/o providers which appear unavailable at runtime
  * - i/o providers marked as unreadable
  * - items (actions or menus) which do not satisfy the defined loadable set
+ *
+ * each readable and thread-safe i/o provider is read in its own thread,
+ * while the others are read in the calling thread; results are then
+ * merged in the order of the providers list, so that precedence is not
+ * changed
  */
 static GList *
 load_items_get_merged_list( const FMAPivot *pivot, guint loadable_set, GSList **messages )
 {
+	static const gchar *thisfn = "fma_io_provider_load_items_get_merged_list";
 	const GList *providers;
 	const GList *ip;
-	GList *merged, *items, *it;
+	GList *merged, *reads, *ir, *it;
 	const FMAIOProvider *provider_object;
 	const FMAIIOProvider *provider_module;
+	ProviderRead *read;
+	GError *error;
 
 	merged = NULL;
+	reads = NULL;
 	providers = fma_io_provider_get_io_providers_list( pivot );
 
 	for( ip = providers ; ip ; ip = ip->next ){
 		provider_object = FMA_IO_PROVIDER( ip->data );
-		provider_module = provider_object->private->provider;
+
+		/* do not load a deferred plugin which will not be read anyway
+		 */
+		provider_module = fma_io_provider_is_conf_readable( provider_object, pivot, NULL ) ?
+				io_provider_get_module( provider_object ) : NULL;
 
 		if( provider_module &&
-			FMA_IIO_PROVIDER_GET_INTERFACE( provider_module )->read_items &&
-			fma_io_provider_is_conf_readable( provider_object, pivot, NULL )){
+			FMA_IIO_PROVIDER_GET_INTERFACE( provider_module )->read_items ){
+
+			read = g_new0( ProviderRead, 1 );
+			read->provider_object = provider_object;
+			read->provider_module = provider_module;
+			read->want_messages = ( messages != NULL );
+			reads = g_list_prepend( reads, read );
+		}
+	}
 
-			items = FMA_IIO_PROVIDER_GET_INTERFACE( provider_module )->read_items( provider_module, messages );
+	reads = g_list_reverse( reads );
 
-			for( it = items ; it ; it = it->next ){
-				fma_object_set_provider( it->data, provider_object );
-				fma_object_dump( it->data );
+	/* each thread-safe provider is read in its own thread, unless it is
+	 * the only one, as the calling thread would then only wait for it
+	 */
+	for( ir = reads ; ir && reads->next ; ir = ir->next ){
+		read = ( ProviderRead * ) ir->data;
+
+		if( load_items_is_thread_safe( read )){
+			error = NULL;
+			read->thread = g_thread_try_new( "fma-io-provider-read", ( GThreadFunc ) load_items_read_provider, read, &error );
+			if( !read->thread ){
+				g_warning( "%s: %s", thisfn, error->message );
+				g_error_free( error );
 			}
+		}
+	}
+
+	/* the other providers are read in the calling thread, while the
+	 * threads are running
+	 */
+	for( ir = reads ; ir ; ir = ir->next ){
+		read = ( ProviderRead * ) ir->data;
 
-			merged = g_list_concat( merged, items );
+		if( !read->thread ){
+			load_items_read_provider( read );
 		}
 	}
 
+	for( ir = reads ; ir ; ir = ir->next ){
+		read = ( ProviderRead * ) ir->data;
+
+		if( read->thread ){
+			g_thread_join( read->thread );
+		}
+
+		for( it = read->items ; it ; it = it->next ){
+			fma_object_set_provider( it->data, read->provider_object );
+			fma_object_dump( it->data );
+		}
+
+		merged = g_list_concat( merged, read->items );
+
+		if( messages ){
+			*messages = g_slist_concat( *messages, read->messages );
+		}
+
+		g_free( read );
+	}
+
+	g_list_free( reads );
+
 	return( merged );
 }
 
+/*
+ * whether the i/o provider may be read in a dedicated thread
+ */
+static gboolean
+load_items_is_thread_safe( const ProviderRead *read )
+{
+	FMAIIOProviderInterface *iface;
+
+	iface = FMA_IIO_PROVIDER_GET_INTERFACE( read->provider_module );
+
+	return( iface->read_items_is_thread_safe && iface->read_items_is_thread_safe( read->provider_module ));
+}
+
+/*
+ * reads all the items of an i/o provider
+ * this may be run in a dedicated thread: the items are only attached
+ * to their provider when back in the calling thread
+ */
+static gpointer
+load_items_read_provider( ProviderRead *read )
+{
+	read->items = FMA_IIO_PROVIDER_GET_INTERFACE( read->provider_module )->read_items(
+			read->provider_module, read->want_messages ? &read->messages : NULL );
+
+	return( NULL );
+}
+
 /*
  * builds the hierarchy
  *
- * this is a recursive function which _moves_ items from input 'tree' to
- * output list.
+ * this _moves_ items from input 'tree' to output list.
+ *
+ * the flat list is first indexed by id; as the same id may be provided
+ * by several i/o providers, each id is mapped to the queue of its links
+ * in list order, so that the first provider still takes precedence
  */
 static GList *
 load_items_hierarchy_build( GList **tree, GSList *level_zero, gboolean list_if_empty, FMAObjectItem *parent )
 {
-	static const gchar *thisfn = "fma_io_provider_load_items_hierarchy_build";
 	GList *hierarchy, *it;
-	GSList *ilevel;
-	GSList *subitems_ids;
-	GList *subitems;
+	GHashTable *index;
+	GQueue *links;
+	gchar *id;
 
 	hierarchy = NULL;
 
-	if( g_slist_length( level_zero )){
-		for( ilevel = level_zero ; ilevel ; ilevel = ilevel->next ){
-			/*g_debug( "%s: id=%s", thisfn, ( gchar * ) ilevel->data );*/
-			it = g_list_find_custom( *tree, ilevel->data, ( GCompareFunc ) peek_item_by_id_compare );
-			if( it ){
-				hierarchy = g_list_append( hierarchy, it->data );
-				fma_object_set_parent( it->data, parent );
-
-				g_debug( "%s: id=%s: %s (%p) appended to hierarchy %p",
-						thisfn, ( gchar * ) ilevel->data, G_OBJECT_TYPE_NAME( it->data ), ( void * ) it->data, ( void * ) hierarchy );
+	if( level_zero ){
+		index = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) g_queue_free );
 
-				*tree = g_list_remove_link( *tree, it );
-
-				if( FMA_IS_OBJECT_MENU( it->data )){
-					subitems_ids = fma_object_get_items_slist( it->data );
-					subitems = load_items_hierarchy_build( tree, subitems_ids, FALSE, FMA_OBJECT_ITEM( it->data ));
-					fma_object_set_items( it->data, subitems );
-					fma_core_utils_slist_free( subitems_ids );
+		for( it = *tree ; it ; it = it->next ){
+			if( FMA_IS_OBJECT_ITEM( it->data )){
+				id = fma_object_get_id( it->data );
+				links = ( GQueue * ) g_hash_table_lookup( index, id );
+				if( links ){
+					g_free( id );
+				} else {
+					links = g_queue_new();
+					g_hash_table_insert( index, id, links );
 				}
+				g_queue_push_tail( links, it );
 			}
 		}
+
+		hierarchy = load_items_hierarchy_build_rec( tree, index, level_zero, parent );
+
+		g_hash_table_destroy( index );
 	}
 
 	/* if level-zero list is empty,
@@ -1179,16 +1450,59 @@ load_items_hierarchy_build( GList **tree, GSList *level_zero, gboolean list_if_e
 	 */
 	else if( list_if_empty ){
 		for( it = *tree ; it ; it = it->next ){
-			hierarchy = g_list_append( hierarchy, it->data );
 			fma_object_set_parent( it->data, parent );
 		}
-		g_list_free( *tree );
+		hierarchy = *tree;
 		*tree = NULL;
 	}
 
 	return( hierarchy );
 }
 
+/*
+ * this is a recursive function which _moves_ the items whose id is in
+ * 'ids' from input 'tree' to output list
+ */
+static GList *
+load_items_hierarchy_build_rec( GList **tree, GHashTable *index, GSList *ids, FMAObjectItem *parent )
+{
+	static const gchar *thisfn = "fma_io_provider_load_items_hierarchy_build_rec";
+	GList *hierarchy, *it;
+	GSList *ilevel;
+	GSList *subitems_ids;
+	GList *subitems;
+	GQueue *links;
+	FMAObjectItem *item;
+
+	hierarchy = NULL;
+
+	for( ilevel = ids ; ilevel ; ilevel = ilevel->next ){
+		/*g_debug( "%s: id=%s", thisfn, ( gchar * ) ilevel->data );*/
+		links = ( GQueue * ) g_hash_table_lookup( index, ilevel->data );
+		it = links ? ( GList * ) g_queue_pop_head( links ) : NULL;
+
+		if( it ){
+			item = FMA_OBJECT_ITEM( it->data );
+			*tree = g_list_delete_link( *tree, it );
+
+			hierarchy = g_list_prepend( hierarchy, item );
+			fma_object_set_parent( item, parent );
+
+			g_debug( "%s: id=%s: %s (%p) appended to hierarchy %p",
+					thisfn, ( gchar * ) ilevel->data, G_OBJECT_TYPE_NAME( item ), ( void * ) item, ( void * ) hierarchy );
+
+			if( FMA_IS_OBJECT_MENU( item )){
+				subitems_ids = fma_object_get_items_slist( item );
+				subitems = load_items_hierarchy_build_rec( tree, index, subitems_ids, item );
+				fma_object_set_items( item, subitems );
+				fma_core_utils_slist_free( subitems_ids );
+			}
+		}
+	}
+
+	return( g_list_reverse( hierarchy ));
+}
+
 static GList *
 load_items_hierarchy_sort( const FMAPivot *pivot, GList *tree, GCompareFunc fn )
 {
@@ -1211,21 +1525,55 @@ load_items_hierarchy_sort( const FMAPivot *pivot, GList *tree, GCompareFunc fn )
 }
 
 /*
- * returns zero when @obj has the required @id
+ * whether the item is known to be at level zero, i.e. to have no parent
+ * menu; when the level-zero list is empty, the hierarchy is only known
+ * after having read all the items
  */
-static gint
-peek_item_by_id_compare( const FMAObject *obj, const gchar *id )
+static gboolean
+load_item_is_level_zero( const gchar *id )
 {
-	gchar *obj_id;
-	gint ret = 1;
+	GSList *level_zero, *it;
+	gboolean found;
 
-	if( FMA_IS_OBJECT_ITEM( obj )){
-		obj_id = fma_object_get_id( obj );
-		ret = strcmp( obj_id, id );
-		g_free( obj_id );
+	level_zero = fma_settings_get_string_list( IPREFS_ITEMS_LEVEL_ZERO_ORDER, NULL, NULL );
+	found = FALSE;
+
+	for( it = level_zero ; it && !found ; it = it->next ){
+		found = !g_ascii_strcasecmp(( const gchar * ) it->data, id );
 	}
 
-	return( ret );
+	fma_core_utils_slist_free( level_zero );
+
+	return( found );
+}
+
+/*
+ * recursively searches the @tree for the item whose id is @id
+ */
+static FMAObjectItem *
+load_item_get_from_tree( GList *tree, const gchar *id )
+{
+	GList *it;
+	FMAObjectItem *found;
+	gchar *it_id;
+
+	found = NULL;
+
+	for( it = tree ; it && !found ; it = it->next ){
+		if( FMA_IS_OBJECT_ITEM( it->data )){
+			it_id = fma_object_get_id( it->data );
+			if( !g_ascii_strcasecmp( id, it_id )){
+				found = FMA_OBJECT_ITEM( it->data );
+			}
+			g_free( it_id );
+
+			if( !found ){
+				found = load_item_get_from_tree( fma_object_get_items( it->data ), id );
+			}
+		}
+	}
+
+	return( found );
 }
 
 /*
@@ -1258,6 +1606,8 @@ fma_io_provider_write_item( const FMAIOProvider *provider, const FMAObjectItem *
 
 	g_return_val_if_fail( FMA_IS_IO_PROVIDER( provider ), ret );
 	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( item ), ret );
+
+	io_provider_get_module( provider );
 	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider->private->provider ), ret );
 	g_return_val_if_fail( FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_item, ret );
 
@@ -1295,6 +1645,8 @@ fma_io_provider_delete_item( const FMAIOProvider *provider, const FMAObjectItem
 
 	g_return_val_if_fail( FMA_IS_IO_PROVIDER( provider ), ret );
 	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( item ), ret );
+
+	io_provider_get_module( provider );
 	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider->private->provider ), ret );
 	g_return_val_if_fail( FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->delete_item, ret );
 
@@ -1332,6 +1684,8 @@ fma_io_provider_duplicate_data( const FMAIOProvider *provider, FMAObjectItem *de
 	g_return_val_if_fail( FMA_IS_IO_PROVIDER( provider ), ret );
 	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( dest ), ret );
 	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( source ), ret );
+
+	io_provider_get_module( provider );
 	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider->private->provider ), ret );
 
 	fma_object_set_provider_data( dest, NULL );
@@ -1345,6 +1699,114 @@ fma_io_provider_duplicate_data( const FMAIOProvider *provider, FMAObjectItem *de
 	return( ret );
 }
 
+/*
+ * fma_io_provider_write_items_start:
+ * @provider: this #FMAIOProvider object.
+ * @messages: error messages.
+ *
+ * Lets the I/O provider know that a set of items is about to be written.
+ *
+ * Returns: the FMAIIOProvider return code; IIO_PROVIDER_CODE_OK if the
+ * I/O provider does not implement the method.
+ */
+guint
+fma_io_provider_write_items_start( const FMAIOProvider *provider, GSList **messages )
+{
+	static const gchar *thisfn = "fma_io_provider_write_items_start";
+	guint ret;
+
+	g_debug( "%s: provider=%p (%s), messages=%p", thisfn,
+			( void * ) provider, G_OBJECT_TYPE_NAME( provider ), ( void * ) messages );
+
+	ret = IIO_PROVIDER_CODE_PROGRAM_ERROR;
+
+	g_return_val_if_fail( FMA_IS_IO_PROVIDER( provider ), ret );
+
+	io_provider_get_module( provider );
+	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider->private->provider ), ret );
+
+	ret = IIO_PROVIDER_CODE_OK;
+
+	if( FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_items_start ){
+		ret = FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_items_start( provider->private->provider, messages );
+	}
+
+	return( ret );
+}
+
+/*
+ * fma_io_provider_write_items_done:
+ * @provider: this #FMAIOProvider object.
+ * @messages: error messages.
+ *
+ * Lets the I/O provider commit the set of items which has been written
+ * since fma_io_provider_write_items_start().
+ *
+ * Returns: the FMAIIOProvider return code; IIO_PROVIDER_CODE_OK if the
+ * I/O provider does not implement the method.
+ */
+guint
+fma_io_provider_write_items_done( const FMAIOProvider *provider, GSList **messages )
+{
+	static const gchar *thisfn = "fma_io_provider_write_items_done";
+	guint ret;
+
+	g_debug( "%s: provider=%p (%s), messages=%p", thisfn,
+			( void * ) provider, G_OBJECT_TYPE_NAME( provider ), ( void * ) messages );
+
+	ret = IIO_PROVIDER_CODE_PROGRAM_ERROR;
+
+	g_return_val_if_fail( FMA_IS_IO_PROVIDER( provider ), ret );
+
+	io_provider_get_module( provider );
+	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider->private->provider ), ret );
+
+	ret = IIO_PROVIDER_CODE_OK;
+
+	if( FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_items_done ){
+		ret = FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_items_done( provider->private->provider, messages );
+	}
+
+	return( ret );
+}
+
+/*
+ * fma_io_provider_write_items_abort:
+ * @provider: this #FMAIOProvider object.
+ * @messages: error messages.
+ *
+ * Lets the I/O provider discard the set of items which has been written
+ * since fma_io_provider_write_items_start().
+ *
+ * Returns: the FMAIIOProvider return code; IIO_PROVIDER_CODE_NOT_WILLING_TO_RUN
+ * if the I/O provider does not implement the method, in which case the
+ * caller has to restore the written items itself.
+ */
+guint
+fma_io_provider_write_items_abort( const FMAIOProvider *provider, GSList **messages )
+{
+	static const gchar *thisfn = "fma_io_provider_write_items_abort";
+	guint ret;
+
+	g_debug( "%s: provider=%p (%s), messages=%p", thisfn,
+			( void * ) provider, G_OBJECT_TYPE_NAME( provider ), ( void * ) messages );
+
+	ret = IIO_PROVIDER_CODE_PROGRAM_ERROR;
+
+	g_return_val_if_fail( FMA_IS_IO_PROVIDER( provider ), ret );
+
+	io_provider_get_module( provider );
+	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider->private->provider ), ret );
+
+	ret = IIO_PROVIDER_CODE_NOT_WILLING_TO_RUN;
+
+	if( FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_items_abort ){
+		ret = FMA_IIO_PROVIDER_GET_INTERFACE( provider->private->provider )->write_items_abort( provider->private->provider, messages );
+	}
+
+	return( ret );
+}
+
 /*
  * fma_io_provider_get_readonly_tooltip:
  * @reason: the reason for why an item is not writable.
@@ -108,10 +108,14 @@ gboolean       fma_io_provider_is_conf_writable         ( const FMAIOProvider *p
 gboolean       fma_io_provider_is_finally_writable      ( const FMAIOProvider *provider, guint *reason );
 
 GList         *fma_io_provider_load_items               ( const FMAPivot *pivot, guint loadable_set, GSList **messages );
+FMAObjectItem *fma_io_provider_load_item                ( const FMAPivot *pivot, const gchar *id, guint loadable_set, GSList **messages );
 
 guint          fma_io_provider_write_item               ( const FMAIOProvider *provider, const FMAObjectItem *item, GSList **messages );
 guint          fma_io_provider_delete_item              ( const FMAIOProvider *provider, const FMAObjectItem *item, GSList **messages );
 guint          fma_io_provider_duplicate_data           ( const FMAIOProvider *provider, FMAObjectItem *dest, const FMAObjectItem *source, GSList **messages );
+guint          fma_io_provider_write_items_start        ( const FMAIOProvider *provider, GSList **messages );
+guint          fma_io_provider_write_items_done         ( const FMAIOProvider *provider, GSList **messages );
+guint          fma_io_provider_write_items_abort        ( const FMAIOProvider *provider, GSList **messages );
 
 gchar         *fma_io_provider_get_readonly_tooltip     ( guint reason );
 gchar         *fma_io_provider_get_return_code_label    ( guint code );
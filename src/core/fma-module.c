@@ -32,6 +32,7 @@
 #endif
 
 #include <gmodule.h>
+#include <string.h>
 
 #include <api/fma-core-utils.h>
 
@@ -52,6 +53,13 @@ struct _FMAModulePrivate {
 	GModule  *library;
 	GList    *objects;
 
+	/* manifest
+	 */
+	gchar    *id;						/* identifier declared by the module */
+	gchar   **interfaces;				/* names of the implemented interfaces */
+	gboolean  deferred;					/* whether the library is still to be loaded */
+	gboolean  used;						/* whether the library has been successfully loaded */
+
 	/* api
 	 */
 	gboolean ( *startup )    ( GTypeModule *module );
@@ -60,6 +68,21 @@ struct _FMAModulePrivate {
 	void     ( *shutdown )   ( void );
 };
 
+/* a plugin may come with a manifest, which is a keyed file with the
+ * same basename than the library, e.g.:
+ *
+ *   [FileManager-Actions Plugin]
+ *   Id=io-desktop
+ *   Interfaces=FMAIIOProvider;FMAIExporter;
+ *
+ * Such a plugin is only loaded when one of its interfaces is requested.
+ * Plugins without manifest are loaded at startup.
+ */
+#define MODULE_MANIFEST_SUFFIX			".plugin"
+#define MODULE_MANIFEST_GROUP			"FileManager-Actions Plugin"
+#define MODULE_MANIFEST_ID				"Id"
+#define MODULE_MANIFEST_INTERFACES		"Interfaces"
+
 static GTypeModuleClass *st_parent_class = NULL;
 
 static GType      register_type( void );
@@ -69,6 +92,10 @@ static void       instance_dispose( GObject *object );
 static void       instance_finalize( GObject *object );
 
 static FMAModule *module_new( const gchar *filename );
+static FMAModule *module_new_from_manifest( const gchar *filename, const gchar *manifest );
+static void       module_load_deferred( FMAModule *module );
+static gboolean   module_declares( const FMAModule *module, GType type );
+static GList     *get_extensions( GList *modules, GType type, const gchar *id, gboolean load );
 static gboolean   on_module_load( GTypeModule *gmodule );
 static gboolean   is_a_na_plugin( FMAModule *module );
 static gboolean   plugin_check( FMAModule *module, const gchar *symbol, gpointer *pfn );
@@ -191,6 +218,8 @@ instance_finalize( GObject *object )
 
 	g_free( self->private->path );
 	g_free( self->private->name );
+	g_free( self->private->id );
+	g_strfreev( self->private->interfaces );
 
 	g_free( self->private );
 
@@ -215,6 +244,8 @@ fma_module_dump( const FMAModule *module )
 	g_debug( "%s:    path=%s", thisfn, module->private->path );
 	g_debug( "%s:    name=%s", thisfn, module->private->name );
 	g_debug( "%s: library=%p", thisfn, ( void * ) module->private->library );
+	g_debug( "%s:      id=%s", thisfn, module->private->id );
+	g_debug( "%s:deferred=%s", thisfn, module->private->deferred ? "True":"False" );
 	g_debug( "%s: objects=%p (count=%d)", thisfn, ( void * ) module->private->objects, g_list_length( module->private->objects ));
 	for( iobj = module->private->objects ; iobj ; iobj = iobj->next ){
 		g_debug( "%s:    iobj=%p (%s)", thisfn, ( void * ) iobj->data, G_OBJECT_TYPE_NAME( iobj->data ));
@@ -226,6 +257,9 @@ fma_module_dump( const FMAModule *module )
  *
  * Load availables dynamically loadable extension libraries (plugins).
  *
+ * Plugins which come with a manifest are not loaded here, but only
+ * when one of their interfaces is first requested.
+ *
  * Returns: a #GList of #FMAModule, each object representing a dynamically
  * loaded library. The list should be fma_module_release_modules() by the
  * caller after use.
@@ -240,7 +274,7 @@ fma_module_load_modules( void )
 	GDir *api_dir;
 	GError *error;
 	const gchar *entry;
-	gchar *fname;
+	gchar *fname, *name, *manifest;
 	FMAModule *module;
 
 	g_debug( "%s", thisfn );
@@ -258,12 +292,24 @@ fma_module_load_modules( void )
 		while(( entry = g_dir_read_name( api_dir )) != NULL ){
 			if( g_str_has_suffix( entry, suffix )){
 				fname = g_build_filename( dirname, entry, NULL );
-				module = module_new( fname );
+				name = fma_core_utils_str_remove_suffix( entry, suffix );
+				manifest = g_strdup_printf( "%s/%s%s", dirname, name, MODULE_MANIFEST_SUFFIX );
+				module = module_new_from_manifest( fname, manifest );
 				if( module ){
-					module->private->name = fma_core_utils_str_remove_suffix( entry, suffix );
+					g_debug( "%s: module %s deferred until first used", thisfn, entry );
+				} else {
+					module = module_new( fname );
+					if( module ){
+						g_debug( "%s: module %s successfully loaded", thisfn, entry );
+					}
+				}
+				if( module ){
+					module->private->name = name;
 					modules = g_list_prepend( modules, module );
-					g_debug( "%s: module %s successfully loaded", thisfn, entry );
+				} else {
+					g_free( name );
 				}
+				g_free( manifest );
 				g_free( fname );
 			}
 		}
@@ -290,10 +336,106 @@ module_new( const gchar *fname )
 	}
 
 	register_module_types( module );
+	module->private->used = TRUE;
+
+	return( module );
+}
+
+/*
+ * @fname: full pathname of the dynamic library.
+ * @manifest: full pathname of its manifest.
+ *
+ * Returns: a new #FMAModule whose library is not loaded yet, or %NULL if
+ * the manifest doesn't exist or is not valid.
+ */
+static FMAModule *
+module_new_from_manifest( const gchar *fname, const gchar *manifest )
+{
+	static const gchar *thisfn = "fma_module_module_new_from_manifest";
+	FMAModule *module;
+	GKeyFile *key_file;
+	GError *error;
+	gchar **interfaces;
+
+	if( !g_file_test( manifest, G_FILE_TEST_EXISTS )){
+		return( NULL );
+	}
+
+	module = NULL;
+	error = NULL;
+	key_file = g_key_file_new();
+
+	if( !g_key_file_load_from_file( key_file, manifest, G_KEY_FILE_NONE, &error )){
+		g_warning( "%s: %s: %s", thisfn, manifest, error->message );
+		g_error_free( error );
+
+	} else {
+		interfaces = g_key_file_get_string_list( key_file, MODULE_MANIFEST_GROUP, MODULE_MANIFEST_INTERFACES, NULL, &error );
+
+		if( !interfaces ){
+			g_warning( "%s: %s: %s", thisfn, manifest, error->message );
+			g_error_free( error );
+
+		} else {
+			module = g_object_new( FMA_TYPE_MODULE, NULL );
+			module->private->path = g_strdup( fname );
+			module->private->id = g_key_file_get_string( key_file, MODULE_MANIFEST_GROUP, MODULE_MANIFEST_ID, NULL );
+			module->private->interfaces = interfaces;
+			module->private->deferred = TRUE;
+		}
+	}
+
+	g_key_file_free( key_file );
 
 	return( module );
 }
 
+/*
+ * actually loads the library of a module which has been deferred
+ *
+ * the module is kept in the list even if it fails to load, so that we
+ * do not try again
+ */
+static void
+module_load_deferred( FMAModule *module )
+{
+	static const gchar *thisfn = "fma_module_module_load_deferred";
+
+	module->private->deferred = FALSE;
+
+	g_debug( "%s: path=%s", thisfn, module->private->path );
+
+	if( g_type_module_use( G_TYPE_MODULE( module ))){
+		if( is_a_na_plugin( module )){
+			register_module_types( module );
+			module->private->used = TRUE;
+
+		} else {
+			g_type_module_unuse( G_TYPE_MODULE( module ));
+		}
+	}
+}
+
+/*
+ * whether the manifest of the module declares the @type interface
+ */
+static gboolean
+module_declares( const FMAModule *module, GType type )
+{
+	const gchar *name;
+	guint i;
+
+	name = g_type_name( type );
+
+	for( i = 0 ; module->private->interfaces && module->private->interfaces[i] ; ++i ){
+		if( !strcmp( module->private->interfaces[i], name )){
+			return( TRUE );
+		}
+	}
+
+	return( FALSE );
+}
+
 /*
  * triggered by GTypeModule base class when first loading the library,
  * which is itself triggered by module_new:g_type_module_use()
@@ -454,12 +596,93 @@ on_module_unload( GTypeModule *gmodule )
  * fma_module_get_extensions_for_type:
  * @type: the serched GType.
  *
+ * The deferred modules which declare the @type interface in their
+ * manifest are loaded here.
+ *
  * Returns: a list of loaded modules willing to deal with requested @type.
  *
  * The returned list should be fma_module_free_extensions_list() by the caller.
  */
 GList *
 fma_module_get_extensions_for_type( GList *modules, GType type )
+{
+	return( get_extensions( modules, type, NULL, TRUE ));
+}
+
+/*
+ * fma_module_get_loaded_extensions_for_type:
+ * @type: the serched GType.
+ *
+ * Returns: a list of already loaded modules willing to deal with
+ * requested @type, without loading any deferred module.
+ *
+ * The returned list should be fma_module_free_extensions_list() by the caller.
+ *
+ * Since: 3.5
+ */
+GList *
+fma_module_get_loaded_extensions_for_type( GList *modules, GType type )
+{
+	return( get_extensions( modules, type, NULL, FALSE ));
+}
+
+/*
+ * fma_module_get_extensions_for_id:
+ * @type: the serched GType.
+ * @id: the identifier declared in the manifest of the module.
+ *
+ * Only loads the module identified by @id, if it is deferred and
+ * declares the @type interface.
+ *
+ * Returns: a list of the objects of this module willing to deal with
+ * requested @type.
+ *
+ * The returned list should be fma_module_free_extensions_list() by the caller.
+ *
+ * Since: 3.5
+ */
+GList *
+fma_module_get_extensions_for_id( GList *modules, GType type, const gchar *id )
+{
+	g_return_val_if_fail( id && strlen( id ), NULL );
+
+	return( get_extensions( modules, type, id, TRUE ));
+}
+
+/*
+ * fma_module_get_deferred_ids_for_type:
+ * @type: the serched GType.
+ *
+ * Returns: the list of the identifiers of the not-yet loaded modules
+ * which declare the @type interface in their manifest.
+ *
+ * The returned list should be fma_core_utils_slist_free() by the caller.
+ *
+ * Since: 3.5
+ */
+GSList *
+fma_module_get_deferred_ids_for_type( GList *modules, GType type )
+{
+	GSList *ids;
+	GList *im;
+	FMAModule *a_modul;
+
+	ids = NULL;
+
+	for( im = modules; im ; im = im->next ){
+		a_modul = FMA_MODULE( im->data );
+		if( a_modul->private->deferred &&
+				a_modul->private->id &&
+				module_declares( a_modul, type )){
+			ids = g_slist_prepend( ids, g_strdup( a_modul->private->id ));
+		}
+	}
+
+	return( g_slist_reverse( ids ));
+}
+
+static GList *
+get_extensions( GList *modules, GType type, const gchar *id, gboolean load )
 {
 	GList *willing_to, *im, *io;
 	FMAModule *a_modul;
@@ -468,6 +691,15 @@ fma_module_get_extensions_for_type( GList *modules, GType type )
 
 	for( im = modules; im ; im = im->next ){
 		a_modul = FMA_MODULE( im->data );
+
+		if( id && g_strcmp0( a_modul->private->id, id )){
+			continue;
+		}
+
+		if( load && a_modul->private->deferred && module_declares( a_modul, type )){
+			module_load_deferred( a_modul );
+		}
+
 		for( io = a_modul->private->objects ; io ; io = io->next ){
 			if( G_TYPE_CHECK_INSTANCE_TYPE( G_OBJECT( io->data ), type )){
 				willing_to = g_list_prepend( willing_to, g_object_ref( io->data ));
@@ -536,7 +768,9 @@ fma_module_release_modules( GList *modules )
 			g_object_unref( iobj->data );
 		}
 
-		g_type_module_unuse( G_TYPE_MODULE( module ));
+		if( module->private->used ){
+			g_type_module_unuse( G_TYPE_MODULE( module ));
+		}
 	}
 
 	g_list_free( modules );
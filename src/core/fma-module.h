@@ -50,7 +50,9 @@
  *
  * So the dynamic is as follows:
  * - FMAPivot scans for the PKGLIBDIR directory, trying to dynamically
- *   load all found libraries
+ *   load all found libraries; a library which comes with a manifest
+ *   (the identifier of the module and the interfaces it implements) is
+ *   only loaded when one of these interfaces is first requested
  * - to be considered as a FMA plugin, a library must implement some
  *   functions (see api/fma-extension.h)
  * - for each found plugin, FMAPivot calls fma_extension_list_types()
@@ -92,17 +94,20 @@ typedef struct {
 }
 	FMAModuleClass;
 
-GType    fma_module_get_type               ( void );
+GType    fma_module_get_type                      ( void );
 
-void     fma_module_dump                   ( const FMAModule *module );
-GList   *fma_module_load_modules           ( void );
+void     fma_module_dump                          ( const FMAModule *module );
+GList   *fma_module_load_modules                  ( void );
 
-GList   *fma_module_get_extensions_for_type( GList *modules, GType type );
-void     fma_module_free_extensions_list   ( GList *extensions );
+GList   *fma_module_get_extensions_for_type       ( GList *modules, GType type );
+GList   *fma_module_get_loaded_extensions_for_type( GList *modules, GType type );
+GList   *fma_module_get_extensions_for_id         ( GList *modules, GType type, const gchar *id );
+GSList  *fma_module_get_deferred_ids_for_type     ( GList *modules, GType type );
+void     fma_module_free_extensions_list          ( GList *extensions );
 
-gboolean fma_module_has_id                 ( FMAModule *module, const gchar *id );
+gboolean fma_module_has_id                        ( FMAModule *module, const gchar *id );
 
-void     fma_module_release_modules        ( GList *modules );
+void     fma_module_release_modules               ( GList *modules );
 
 G_END_DECLS
 
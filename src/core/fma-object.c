@@ -62,7 +62,7 @@ static void     iduplicable_copy( FMAIDuplicable *target, const FMAIDuplicable *
 static gboolean iduplicable_are_equal( const FMAIDuplicable *a, const FMAIDuplicable *b );
 static gboolean iduplicable_is_valid( const FMAIDuplicable *object );
 
-static void     check_status_down_rec( const FMAObject *object );
+static void     check_status_down_rec( const FMAObject *object, gboolean force );
 static void     check_status_up_rec( const FMAObject *object, gboolean was_modified, gboolean was_valid );
 static void     v_copy( FMAObject *target, const FMAObject *source, guint mode );
 static gboolean v_are_equal( const FMAObject *a, const FMAObject *b );
@@ -350,6 +350,12 @@ iduplicable_is_valid( const FMAIDuplicable *object )
  *   that edition status of children is actually checked before those of
  *   the parent.
  *
+ *   Each write of an elementary data marks the object and its parents as
+ *   dirty, and incrementally updates the comparison of the object against
+ *   its origin. Descendants which have not been written to since their
+ *   last check are so skipped, and the check of a written object does not
+ *   compare all its data again.
+ *
  * <formalpara>
  *  <title>
  *   As of 3.1.0:
@@ -387,22 +393,37 @@ fma_object_object_check_status_rec( const FMAObject *object )
 
 		was_modified = fma_object_is_modified( object );
 		was_valid = fma_object_is_valid( object );
-		check_status_down_rec( object );
+		check_status_down_rec( object, TRUE );
 		check_status_up_rec( object, was_modified, was_valid );
 	}
 }
 
 /*
  * recursively checks the status downstream
+ * only descends into the children which have been marked dirty, i.e.
+ * which themselves or one of their descendants have been modified
+ * since the last check
  */
 static void
-check_status_down_rec( const FMAObject *object )
+check_status_down_rec( const FMAObject *object, gboolean force )
 {
+	GList *ic;
+
+	if( !force && FMA_IS_IFACTORY_OBJECT( object ) && !fma_factory_object_is_dirty( FMA_IFACTORY_OBJECT( object ))){
+		return;
+	}
+
 	if( FMA_IS_OBJECT_ITEM( object )){
-		g_list_foreach( fma_object_get_items( object ), ( GFunc ) check_status_down_rec, NULL );
+		for( ic = fma_object_get_items( object ) ; ic ; ic = ic->next ){
+			check_status_down_rec( FMA_OBJECT( ic->data ), FALSE );
+		}
 	}
 
 	fma_iduplicable_check_status( FMA_IDUPLICABLE( object ));
+
+	if( FMA_IS_IFACTORY_OBJECT( object )){
+		fma_factory_object_set_clean( FMA_IFACTORY_OBJECT( object ));
+	}
 }
 
 /*
@@ -596,6 +617,10 @@ fma_object_object_reset_origin( FMAObject *object, const FMAObject *origin )
 
 		fma_iduplicable_set_origin( FMA_IDUPLICABLE( object ), FMA_IDUPLICABLE( origin ));
 		fma_iduplicable_set_origin( FMA_IDUPLICABLE( origin ), NULL );
+
+		if( FMA_IS_IFACTORY_OBJECT( object )){
+			fma_factory_object_set_dirty( FMA_IFACTORY_OBJECT( object ));
+		}
 	}
 }
 
@@ -87,6 +87,7 @@ enum {
 
 static GObjectClass  *st_parent_class           = NULL;
 static gint           st_burst_timeout          = 100;		/* burst timeout in msec */
+static gint           st_burst_max_wait         = 1000;		/* max burst duration in msec */
 static gint           st_signals[ LAST_SIGNAL ] = { 0 };
 
 static GType          register_type( void );
@@ -217,9 +218,9 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	/* initialize timeout parameters for 'item-changed' handler
 	 */
 	self->private->change_timeout.timeout = st_burst_timeout;
+	fma_timeout_set_max_wait( &self->private->change_timeout, st_burst_max_wait );
 	self->private->change_timeout.handler = ( FMATimeoutFunc ) on_items_changed_timeout;
 	self->private->change_timeout.user_data = self;
-	self->private->change_timeout.source_id = 0;
 }
 
 static void
@@ -318,6 +319,8 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
+		fma_timeout_cancel( &self->private->change_timeout );
+
 		/* release modules */
 		fma_module_release_modules( self->private->modules );
 		self->private->modules = NULL;
@@ -453,6 +456,93 @@ fma_pivot_get_providers( const FMAPivot *pivot, GType type )
 	return( list );
 }
 
+/*
+ * fma_pivot_get_loaded_providers:
+ * @pivot: this #FMAPivot instance.
+ * @type: the type of searched interface.
+ *
+ * Contrarily to fma_pivot_get_providers(), this doesn't load the plugins
+ * which have been deferred until first use.
+ *
+ * Returns: a newly allocated list of the already loaded providers of
+ * the required interface, which should be released by calling
+ * fma_pivot_free_providers().
+ *
+ * Since: 3.5
+ */
+GList *
+fma_pivot_get_loaded_providers( const FMAPivot *pivot, GType type )
+{
+	GList *list = NULL;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), NULL );
+
+	if( !pivot->private->dispose_has_run ){
+
+		list = fma_module_get_loaded_extensions_for_type( pivot->private->modules, type );
+	}
+
+	return( list );
+}
+
+/*
+ * fma_pivot_get_providers_for_id:
+ * @pivot: this #FMAPivot instance.
+ * @type: the type of searched interface.
+ * @id: the identifier of the plugin, as declared in its manifest.
+ *
+ * Loads the @id plugin if it has been deferred until first use.
+ *
+ * Returns: a newly allocated list of the providers of the required
+ * interface implemented by the @id plugin, which should be released
+ * by calling fma_pivot_free_providers().
+ *
+ * Since: 3.5
+ */
+GList *
+fma_pivot_get_providers_for_id( const FMAPivot *pivot, GType type, const gchar *id )
+{
+	static const gchar *thisfn = "fma_pivot_get_providers_for_id";
+	GList *list = NULL;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), NULL );
+
+	if( !pivot->private->dispose_has_run ){
+
+		g_debug( "%s: pivot=%p, type=%s, id=%s", thisfn, ( void * ) pivot, g_type_name( type ), id );
+
+		list = fma_module_get_extensions_for_id( pivot->private->modules, type, id );
+	}
+
+	return( list );
+}
+
+/*
+ * fma_pivot_get_deferred_ids:
+ * @pivot: this #FMAPivot instance.
+ * @type: the type of searched interface.
+ *
+ * Returns: the list of the identifiers of the plugins which declare
+ * the required interface in their manifest, but have not been loaded
+ * yet. This list should be fma_core_utils_slist_free() by the caller.
+ *
+ * Since: 3.5
+ */
+GSList *
+fma_pivot_get_deferred_ids( const FMAPivot *pivot, GType type )
+{
+	GSList *ids = NULL;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), NULL );
+
+	if( !pivot->private->dispose_has_run ){
+
+		ids = fma_module_get_deferred_ids_for_type( pivot->private->modules, type );
+	}
+
+	return( ids );
+}
+
 /*
  * fma_pivot_free_providers:
  * @providers: a list of providers.
@@ -514,6 +604,7 @@ get_item_from_tree( const FMAPivot *pivot, GList *tree, const gchar *id )
 		if( !g_ascii_strcasecmp( id, i_id )){
 			found = FMA_OBJECT_ITEM( ia->data );
 		}
+		g_free( i_id );
 
 		if( !found && FMA_IS_OBJECT_ITEM( ia->data )){
 			subitems = fma_object_get_items( ia->data );
@@ -580,6 +671,62 @@ fma_pivot_load_items( FMAPivot *pivot )
 	}
 }
 
+/*
+ * fma_pivot_load_item_by_id:
+ * @pivot: this #FMAPivot instance.
+ * @id: the required item identifier.
+ *
+ * Loads the specified item from I/O providers, without loading the
+ * whole hierarchy when the I/O providers are able to read a single
+ * item. The loaded item is appended to the current tree, so that it
+ * is also available through fma_pivot_get_item().
+ *
+ * Returns: the required #FMAObjectItem-derived object, or %NULL if not
+ * found or not loadable.
+ *
+ * The returned pointer is owned by #FMAPivot, and should not be
+ * g_free() nor g_object_unref() by the caller.
+ */
+FMAObjectItem *
+fma_pivot_load_item_by_id( FMAPivot *pivot, const gchar *id )
+{
+	static const gchar *thisfn = "fma_pivot_load_item_by_id";
+	FMAObjectItem *item;
+	GSList *messages, *im;
+
+	g_return_val_if_fail( FMA_IS_PIVOT( pivot ), NULL );
+
+	item = NULL;
+
+	if( !pivot->private->dispose_has_run ){
+
+		if( !id || !strlen( id )){
+			return( NULL );
+		}
+
+		g_debug( "%s: pivot=%p, id=%s", thisfn, ( void * ) pivot, id );
+
+		item = get_item_from_tree( pivot, pivot->private->tree, id );
+
+		if( !item ){
+			messages = NULL;
+			item = fma_io_provider_load_item( pivot, id, pivot->private->loadable_set, &messages );
+
+			if( item ){
+				pivot->private->tree = g_list_append( pivot->private->tree, item );
+			}
+
+			for( im = messages ; im ; im = im->next ){
+				g_warning( "%s: %s", thisfn, ( const gchar * ) im->data );
+			}
+
+			fma_core_utils_slist_free( messages );
+		}
+	}
+
+	return( item );
+}
+
 /*
  * fma_pivot_set_new_items:
  * @pivot: this #FMAPivot instance.
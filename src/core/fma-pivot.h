@@ -141,6 +141,9 @@ void           fma_pivot_dump                   ( const FMAPivot *pivot );
  * As of 2.30, these may be FMAIIOProvider, FMAIImporter or FMAIExporter
  */
 GList         *fma_pivot_get_providers          ( const FMAPivot *pivot, GType type );
+GList         *fma_pivot_get_loaded_providers   ( const FMAPivot *pivot, GType type );
+GList         *fma_pivot_get_providers_for_id   ( const FMAPivot *pivot, GType type, const gchar *id );
+GSList        *fma_pivot_get_deferred_ids       ( const FMAPivot *pivot, GType type );
 void           fma_pivot_free_providers         ( GList *providers );
 
 /* Items, menus and actions, management
@@ -148,6 +151,7 @@ void           fma_pivot_free_providers         ( GList *providers );
 FMAObjectItem *fma_pivot_get_item               ( const FMAPivot *pivot, const gchar *id );
 GList         *fma_pivot_get_items              ( const FMAPivot *pivot );
 void           fma_pivot_load_items             ( FMAPivot *pivot );
+FMAObjectItem *fma_pivot_load_item_by_id        ( FMAPivot *pivot, const gchar *id );
 void           fma_pivot_set_new_items          ( FMAPivot *pivot, GList *tree );
 
 void           fma_pivot_on_item_changed_handler( FMAIIOProvider *provider, FMAPivot *pivot  );
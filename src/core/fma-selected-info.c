@@ -77,6 +77,7 @@ static void             instance_finalize( GObject *object );
 static void             dump( const FMASelectedInfo *nsi );
 static const char      *dump_file_type( GFileType type );
 static FMASelectedInfo *new_from_uri( const gchar *uri, const gchar *mimetype, gchar **errmsg );
+static GFile           *set_uri( FMASelectedInfo *info, const gchar *uri, const gchar *mimetype );
 static void             query_file_attributes( FMASelectedInfo *info, GFile *location, gchar **errmsg );
 
 GType
@@ -642,6 +643,44 @@ fma_selected_info_create_for_uri( const gchar *uri, const gchar *mimetype, gchar
 	return( obj );
 }
 
+/*
+ * fma_selected_info_create_for_attributes:
+ * @uri: an URI.
+ * @mimetype: the corresponding mime type.
+ * @type: the #GFileType of the item.
+ * @access: the #FMASelectedInfoAccess flags of the item.
+ * @owner: the owner of the item.
+ *
+ * Contrarily to fma_selected_info_create_for_uri(), this doesn't query
+ * the file attributes, as they have been provided by the caller (e.g.
+ * as received on D-Bus from the tracker).
+ *
+ * Returns: a newly allocated #FMASelectedInfo object for the given @uri.
+ *
+ * Since: 3.5
+ */
+FMASelectedInfo *
+fma_selected_info_create_for_attributes( const gchar *uri, const gchar *mimetype, GFileType type, guint access, const gchar *owner )
+{
+	FMASelectedInfo *info;
+	GFile *location;
+
+	info = g_object_new( FMA_TYPE_SELECTED_INFO, NULL );
+	location = set_uri( info, uri, mimetype );
+	g_object_unref( location );
+
+	info->private->file_type = type;
+	info->private->can_read = ( access & SELECTED_INFO_CAN_READ ) != 0;
+	info->private->can_write = ( access & SELECTED_INFO_CAN_WRITE ) != 0;
+	info->private->can_execute = ( access & SELECTED_INFO_CAN_EXECUTE ) != 0;
+	info->private->owner = g_strdup( owner );
+	info->private->attributes_are_set = TRUE;
+
+	dump( info );
+
+	return( info );
+}
+
 static void
 dump( const FMASelectedInfo *nsi )
 {
@@ -747,10 +786,28 @@ static FMASelectedInfo *
 new_from_uri( const gchar *uri, const gchar *mimetype, gchar **errmsg )
 {
 	GFile *location;
-	FMAGnomeVFSURI *vfs;
 
 	FMASelectedInfo *info = g_object_new( FMA_TYPE_SELECTED_INFO, NULL );
 
+	location = set_uri( info, uri, mimetype );
+	query_file_attributes( info, location, errmsg );
+	g_object_unref( location );
+
+	dump( info );
+
+	return( info );
+}
+
+/*
+ * sets the members which are computed from the URI
+ * returns the GFile location, to be g_object_unref() by the caller
+ */
+static GFile *
+set_uri( FMASelectedInfo *info, const gchar *uri, const gchar *mimetype )
+{
+	GFile *location;
+	FMAGnomeVFSURI *vfs;
+
 	info->private->uri = g_strdup( uri );
 	if( mimetype ){
 		info->private->mimetype = g_strdup( mimetype );
@@ -780,12 +837,7 @@ new_from_uri( const gchar *uri, const gchar *mimetype, gchar **errmsg )
 	info->private->port = vfs->host_port;
 	fma_gnome_vfs_uri_free( vfs );
 
-	query_file_attributes( info, location, errmsg );
-	g_object_unref( location );
-
-	dump( info );
-
-	return( info );
+	return( location );
 }
 
 static void
@@ -43,7 +43,7 @@
  * file_manager_file_info_create_for_uri() API (2.28 for Nautilus)
  */
 
-#include <glib-object.h>
+#include <gio/gio.h>
 
 G_BEGIN_DECLS
 
@@ -72,6 +72,23 @@ typedef struct {
 }
 	FMASelectedInfoClass;
 
+/**
+ * FMASelectedInfoAccess:
+ * @SELECTED_INFO_CAN_READ:    the item is readable.
+ * @SELECTED_INFO_CAN_WRITE:   the item is writable.
+ * @SELECTED_INFO_CAN_EXECUTE: the item is executable.
+ *
+ * The access rights of a selected item, as sent on D-Bus by the tracker.
+ *
+ * Since: 3.5
+ */
+typedef enum {
+	SELECTED_INFO_CAN_READ    = 1 << 0,
+	SELECTED_INFO_CAN_WRITE   = 1 << 1,
+	SELECTED_INFO_CAN_EXECUTE = 1 << 2
+}
+	FMASelectedInfoAccess;
+
 GType            fma_selected_info_get_type          ( void );
 
 GList           *fma_selected_info_copy_list         ( GList *files );
@@ -95,6 +112,7 @@ gboolean         fma_selected_info_is_readable       ( const FMASelectedInfo *ns
 gboolean         fma_selected_info_is_writable       ( const FMASelectedInfo *nsi );
 
 FMASelectedInfo *fma_selected_info_create_for_uri    ( const gchar *uri, const gchar *mimetype, gchar **errmsg );
+FMASelectedInfo *fma_selected_info_create_for_attributes( const gchar *uri, const gchar *mimetype, GFileType type, guint access, const gchar *owner );
 
 G_END_DECLS
 
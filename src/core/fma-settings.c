@@ -85,6 +85,8 @@ typedef struct {
 	GKeyFile     *key_file;
 	GFileMonitor *monitor;
 	gulong        handler;
+	gboolean      stale;
+	gboolean      loaded;
 }
 	KeyFile;
 
@@ -107,19 +109,39 @@ typedef struct {
 	Consumer;
 
 /* private instance data
+ *
+ * the cache is a two-levels hash table group -> key -> CacheEntry
+ * which holds the decoded value of each key already read; it is only
+ * invalidated when a configuration file is modified
+ *
+ * the content index is a set of the KeyValue's of the content, hashed
+ * on (group, def), so that the content may be diffed in linear time
+ *
+ * consumers are indexed by monitored key: the value of the hash is the
+ * list of Consumer's registered for this key
+ *
+ * the I/O providers may be read from worker threads: the cache, and the
+ * key files it is filled from, are so protected by cache_mutex
  */
 struct _FMASettingsPrivate {
-	gboolean   dispose_has_run;
-	KeyFile   *mandatory;
-	KeyFile   *user;
-	GList     *content;
-	GList     *consumers;
-	FMATimeout timeout;
+	gboolean    dispose_has_run;
+	KeyFile    *mandatory;
+	KeyFile    *user;
+	GList      *content;
+	GHashTable *content_index;
+	GHashTable *consumers;
+	FMATimeout  timeout;
+	GHashTable *cache;
+	GMutex      cache_mutex;
 };
 
 #define GROUP_FMA						"fma-config-tool"
 #define GROUP_RUNTIME					"runtime"
 
+/* the group of an I/O provider is "io-provider <provider_id>"
+ */
+#define IO_PROVIDER_GROUP_PREFIX		IPREFS_IO_PROVIDER_GROUP " "
+
 typedef struct {
 	const gchar *key;
 	const gchar *group;
@@ -202,6 +224,16 @@ typedef struct {
 }
 	KeyValue;
 
+/* An entry of the values cache.
+ * A key which has been searched for, but not found in any configuration
+ * file, is cached with a NULL value.
+ */
+typedef struct {
+	KeyValue *value;
+	gboolean  mandatory;
+}
+	CacheEntry;
+
 /* signals
  */
 enum {
@@ -211,6 +243,7 @@ enum {
 
 static GObjectClass *st_parent_class           = NULL;
 static gint          st_burst_timeout          = 100;		/* burst timeout in msec */
+static gint          st_burst_max_wait         = 1000;		/* max burst duration in msec */
 static gint          st_signals[ LAST_SIGNAL ] = { 0 };
 static FMASettings   *st_settings               = NULL;
 
@@ -223,15 +256,22 @@ static void      instance_finalize( GObject *object );
 
 static void      settings_new( void );
 
-static GList    *content_diff( GList *old, GList *new );
-static GList    *content_load_keys( GList *content, KeyFile *keyfile );
+static GList    *content_diff( GList *old, GHashTable *old_index, GList *new, GHashTable *new_index );
+static GHashTable *content_index_new( void );
+static GList    *content_load_keys( GList *content, GHashTable *index, KeyFile *keyfile );
+static void      dispatch_to_consumers( const gchar *monitored_key, const KeyValue *changed );
+static void      cache_clear( void );
+static void      cache_entry_free( CacheEntry *entry );
+static void      cache_remove( const gchar *group, const gchar *key );
 static KeyDef   *get_key_def( const gchar *key );
 static KeyFile  *key_file_new( const gchar *dir );
 static void      on_keyfile_changed( GFileMonitor *monitor, GFile *file, GFile *other_file, GFileMonitorEvent event_type );
 static void      on_keyfile_changed_timeout( void );
 static void      on_key_changed_final_handler( FMASettings *settings, gchar *group, gchar *key, FMABoxed *new_value, gboolean mandatory );
-static KeyValue *peek_key_value_from_content( GList *content, const gchar *group, const gchar *key );
-static KeyValue *read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory );
+static guint     key_value_hash( const KeyValue *value );
+static gboolean  key_value_equal( const KeyValue *a, const KeyValue *b );
+static KeyValue *peek_key_value_from_content( GHashTable *index, const gchar *group, const KeyDef *def );
+static FMABoxed *read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory );
 static KeyValue *read_key_value_from_key_file( KeyFile *keyfile, const gchar *group, const gchar *key, const KeyDef *key_def );
 static void      release_consumer( Consumer *consumer );
 static void      release_key_file( KeyFile *key_file );
@@ -342,12 +382,15 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->mandatory = NULL;
 	self->private->user = NULL;
 	self->private->content = NULL;
-	self->private->consumers = NULL;
+	self->private->content_index = content_index_new();
+	self->private->consumers = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	self->private->cache = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) g_hash_table_destroy );
+	g_mutex_init( &self->private->cache_mutex );
 
 	self->private->timeout.timeout = st_burst_timeout;
+	fma_timeout_set_max_wait( &self->private->timeout, st_burst_max_wait );
 	self->private->timeout.handler = ( FMATimeoutFunc ) on_keyfile_changed_timeout;
 	self->private->timeout.user_data = NULL;
-	self->private->timeout.source_id = 0;
 }
 
 static void
@@ -366,6 +409,8 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
+		fma_timeout_cancel( &self->private->timeout );
+
 		release_key_file( self->private->mandatory );
 		release_key_file( self->private->user );
 
@@ -380,6 +425,8 @@ instance_finalize( GObject *object )
 {
 	static const gchar *thisfn = "fma_settings_instance_finalize";
 	FMASettings *self;
+	GHashTableIter iter;
+	GList *consumers;
 
 	g_return_if_fail( NA_IS_SETTINGS( object ));
 
@@ -387,11 +434,19 @@ instance_finalize( GObject *object )
 
 	self = NA_SETTINGS( object );
 
+	g_hash_table_destroy( self->private->content_index );
 	g_list_foreach( self->private->content, ( GFunc ) release_key_value, NULL );
 	g_list_free( self->private->content );
 
-	g_list_foreach( self->private->consumers, ( GFunc ) release_consumer, NULL );
-	g_list_free( self->private->consumers );
+	g_hash_table_iter_init( &iter, self->private->consumers );
+	while( g_hash_table_iter_next( &iter, NULL, ( gpointer * ) &consumers )){
+		g_list_foreach( consumers, ( GFunc ) release_consumer, NULL );
+		g_list_free( consumers );
+	}
+	g_hash_table_destroy( self->private->consumers );
+
+	g_hash_table_destroy( self->private->cache );
+	g_mutex_clear( &self->private->cache_mutex );
 
 	g_free( self->private );
 
@@ -434,7 +489,7 @@ settings_new( void )
 			st_settings->private->mandatory = key_file_new( dir );
 			g_free( dir );
 			st_settings->private->mandatory->mandatory = TRUE;
-			content = content_load_keys( NULL, st_settings->private->mandatory );
+			content = content_load_keys( NULL, st_settings->private->content_index, st_settings->private->mandatory );
 			if( content ){
 				break;
 			}
@@ -447,7 +502,7 @@ settings_new( void )
 		st_settings->private->user = key_file_new( dir );
 		g_free( dir );
 		st_settings->private->mandatory->mandatory = FALSE;
-		content = content_load_keys( content, st_settings->private->user );
+		content = content_load_keys( content, st_settings->private->content_index, st_settings->private->user );
 
 		st_settings->private->content = g_list_copy( content );
 		g_list_free( content );
@@ -480,17 +535,21 @@ void
 fma_settings_register_key_callback( const gchar *key, GCallback callback, gpointer user_data )
 {
 	static const gchar *thisfn = "fma_settings_register_key_callback";
+	Consumer *consumer;
+	GList *consumers;
 
 	g_debug( "%s: key=%s, callback=%p, user_data=%p",
 			thisfn, key, ( void * ) callback, ( void * ) user_data );
 
-	Consumer *consumer = g_new0( Consumer, 1 );
+	consumer = g_new0( Consumer, 1 );
 	consumer->monitored_key = g_strdup( key );
 	consumer->callback = callback;
 	consumer->user_data = user_data;
 
 	settings_new();
-	st_settings->private->consumers = g_list_prepend( st_settings->private->consumers, consumer );
+	consumers = g_hash_table_lookup( st_settings->private->consumers, key );
+	consumers = g_list_prepend( consumers, consumer );
+	g_hash_table_insert( st_settings->private->consumers, g_strdup( key ), consumers );
 }
 
 /**
@@ -537,15 +596,15 @@ gboolean
 fma_settings_get_boolean_ex( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	gboolean value;
-	KeyValue *key_value;
+	FMABoxed *boxed;
 	KeyDef *key_def;
 
 	value = FALSE;
-	key_value = read_key_value( group, key, found, mandatory );
+	boxed = read_key_value( group, key, found, mandatory );
 
-	if( key_value ){
-		value = fma_boxed_get_boolean( key_value->boxed );
-		release_key_value( key_value );
+	if( boxed ){
+		value = fma_boxed_get_boolean( boxed );
+		g_object_unref( boxed );
 
 	} else {
 		key_def = get_key_def( key );
@@ -580,15 +639,15 @@ gchar *
 fma_settings_get_string( const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	gchar *value;
-	KeyValue *key_value;
+	FMABoxed *boxed;
 	KeyDef *key_def;
 
 	value = NULL;
-	key_value = read_key_value( NULL, key, found, mandatory );
+	boxed = read_key_value( NULL, key, found, mandatory );
 
-	if( key_value ){
-		value = fma_boxed_get_string( key_value->boxed );
-		release_key_value( key_value );
+	if( boxed ){
+		value = fma_boxed_get_string( boxed );
+		g_object_unref( boxed );
 
 	} else {
 		key_def = get_key_def( key );
@@ -623,15 +682,15 @@ GSList *
 fma_settings_get_string_list( const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	GSList *value;
-	KeyValue *key_value;
+	FMABoxed *boxed;
 	KeyDef *key_def;
 
 	value = NULL;
-	key_value = read_key_value( NULL, key, found, mandatory );
+	boxed = read_key_value( NULL, key, found, mandatory );
 
-	if( key_value ){
-		value = fma_boxed_get_string_list( key_value->boxed );
-		release_key_value( key_value );
+	if( boxed ){
+		value = fma_boxed_get_string_list( boxed );
+		g_object_unref( boxed );
 
 	} else {
 		key_def = get_key_def( key );
@@ -666,14 +725,14 @@ fma_settings_get_uint( const gchar *key, gboolean *found, gboolean *mandatory )
 {
 	guint value;
 	KeyDef *key_def;
-	KeyValue *key_value;
+	FMABoxed *boxed;
 
 	value = 0;
-	key_value = read_key_value( NULL, key, found, mandatory );
+	boxed = read_key_value( NULL, key, found, mandatory );
 
-	if( key_value ){
-		value = fma_boxed_get_uint( key_value->boxed );
-		release_key_value( key_value );
+	if( boxed ){
+		value = fma_boxed_get_uint( boxed );
+		g_object_unref( boxed );
 
 	} else {
 		key_def = get_key_def( key );
@@ -709,14 +768,14 @@ fma_settings_get_uint_list( const gchar *key, gboolean *found, gboolean *mandato
 {
 	GList *value;
 	KeyDef *key_def;
-	KeyValue *key_value;
+	FMABoxed *boxed;
 
 	value = NULL;
-	key_value = read_key_value( NULL, key, found, mandatory );
+	boxed = read_key_value( NULL, key, found, mandatory );
 
-	if( key_value ){
-		value = fma_boxed_get_uint_list( key_value->boxed );
-		release_key_value( key_value );
+	if( boxed ){
+		value = fma_boxed_get_uint_list( boxed );
+		g_object_unref( boxed );
 
 	} else {
 		key_def = get_key_def( key );
@@ -953,6 +1012,8 @@ fma_settings_get_groups( void )
 	groups = NULL;
 	settings_new();
 
+	g_mutex_lock( &st_settings->private->cache_mutex );
+
 	array = g_key_file_get_groups( st_settings->private->mandatory->key_file, NULL );
 	if( array ){
 		groups = fma_core_utils_slist_from_array(( const gchar ** ) array );
@@ -965,6 +1026,8 @@ fma_settings_get_groups( void )
 		g_strfreev( array );
 	}
 
+	g_mutex_unlock( &st_settings->private->cache_mutex );
+
 	return( groups );
 }
 
@@ -981,33 +1044,27 @@ fma_settings_get_groups( void )
  * which hold the new value of each modified key
  */
 static GList *
-content_diff( GList *old, GList *new )
+content_diff( GList *old, GHashTable *old_index, GList *new, GHashTable *new_index )
 {
 	GList *diffs, *io, *in;
 	KeyValue *kold, *knew, *kdiff;
-	gboolean found;
 
 	diffs = NULL;
 
 	for( io = old ; io ; io = io->next ){
 		kold = ( KeyValue * ) io->data;
-		found = FALSE;
-		for( in = new ; in && !found ; in = in->next ){
-			knew = ( KeyValue * ) in->data;
-			if( !strcmp( kold->group, knew->group ) && ( gpointer ) kold->def == ( gpointer ) knew->def ){
-				found = TRUE;
-				if( !fma_boxed_are_equal( kold->boxed, knew->boxed )){
-					/* a key has been modified */
-					kdiff = g_new0( KeyValue, 1 );
-					kdiff->group = g_strdup( knew->group );
-					kdiff->def = knew->def;
-					kdiff->mandatory = knew->mandatory;
-					kdiff->boxed = fma_boxed_copy( knew->boxed );
-					diffs = g_list_prepend( diffs, kdiff );
-				}
+		knew = ( KeyValue * ) g_hash_table_lookup( new_index, kold );
+		if( knew ){
+			if( !fma_boxed_are_equal( kold->boxed, knew->boxed )){
+				/* a key has been modified */
+				kdiff = g_new0( KeyValue, 1 );
+				kdiff->group = g_strdup( knew->group );
+				kdiff->def = knew->def;
+				kdiff->mandatory = knew->mandatory;
+				kdiff->boxed = fma_boxed_copy( knew->boxed );
+				diffs = g_list_prepend( diffs, kdiff );
 			}
-		}
-		if( !found ){
+		} else {
 			/* a key has disappeared */
 			kdiff = g_new0( KeyValue, 1 );
 			kdiff->group = g_strdup( kold->group );
@@ -1020,14 +1077,7 @@ content_diff( GList *old, GList *new )
 
 	for( in = new ; in ; in = in->next ){
 		knew = ( KeyValue * ) in->data;
-		found = FALSE;
-		for( io = old ; io && !found ; io = io->next ){
-			kold = ( KeyValue * ) io->data;
-			if( !strcmp( kold->group, knew->group ) && ( gpointer ) kold->def == ( gpointer ) knew->def ){
-				found = TRUE;
-			}
-		}
-		if( !found ){
+		if( !g_hash_table_lookup( old_index, knew )){
 			/* a key is new */
 			kdiff = g_new0( KeyValue, 1 );
 			kdiff->group = g_strdup( knew->group );
@@ -1041,14 +1091,27 @@ content_diff( GList *old, GList *new )
 	return( diffs );
 }
 
+/*
+ * the content index does not own its KeyValue's, which are released
+ * with the content list itself
+ */
+static GHashTable *
+content_index_new( void )
+{
+	return( g_hash_table_new(( GHashFunc ) key_value_hash, ( GEqualFunc ) key_value_equal ));
+}
+
 /* add the content of a configuration files to those already loaded
  *
  * when the two configuration files have been read, then the content of
  * _the_ configuration has been loaded, while preserving the mandatory
  * keys
+ *
+ * the file is only re-read from the disk if it has been modified since
+ * the last load; @index is updated with the newly added KeyValue's
  */
 static GList *
-content_load_keys( GList *content, KeyFile *keyfile )
+content_load_keys( GList *content, GHashTable *index, KeyFile *keyfile )
 {
 	static const gchar *thisfn = "fma_settings_content_load_keys";
 	GError *error;
@@ -1057,17 +1120,22 @@ content_load_keys( GList *content, KeyFile *keyfile )
 	KeyValue *key_value;
 	KeyDef *key_def;
 
-	error = NULL;
-	if( !g_key_file_load_from_file( keyfile->key_file, keyfile->fname, G_KEY_FILE_KEEP_COMMENTS, &error )){
-		if( error->code != G_FILE_ERROR_NOENT ){
-			g_warning( "%s: %s (%d) %s", thisfn, keyfile->fname, error->code, error->message );
-		} else {
-			g_debug( "%s: %s: file doesn't exist", thisfn, keyfile->fname );
-		}
-		g_error_free( error );
+	if( keyfile->stale ){
 		error = NULL;
+		keyfile->loaded = g_key_file_load_from_file( keyfile->key_file, keyfile->fname, G_KEY_FILE_KEEP_COMMENTS, &error );
+		if( !keyfile->loaded ){
+			if( error->code != G_FILE_ERROR_NOENT ){
+				g_warning( "%s: %s (%d) %s", thisfn, keyfile->fname, error->code, error->message );
+			} else {
+				g_debug( "%s: %s: file doesn't exist", thisfn, keyfile->fname );
+			}
+			g_error_free( error );
+			error = NULL;
+		}
+		keyfile->stale = FALSE;
+	}
 
-	} else {
+	if( keyfile->loaded ){
 		groups = g_key_file_get_groups( keyfile->key_file, NULL );
 		ig = groups;
 		while( *ig ){
@@ -1076,12 +1144,13 @@ content_load_keys( GList *content, KeyFile *keyfile )
 			while( *ik ){
 				key_def = get_key_def( *ik );
 				if( key_def ){
-					key_value = peek_key_value_from_content( content, *ig, *ik );
+					key_value = peek_key_value_from_content( index, *ig, key_def );
 					if( !key_value ){
 						key_value = read_key_value_from_key_file( keyfile, *ig, *ik, key_def );
 						if( key_value ){
 							key_value->mandatory = keyfile->mandatory;
 							content = g_list_prepend( content, key_value );
+							g_hash_table_add( index, key_value );
 						}
 					}
 				}
@@ -1096,20 +1165,28 @@ content_load_keys( GList *content, KeyFile *keyfile )
 	return( content );
 }
 
+/*
+ * the static table of key definitions is indexed by key name the
+ * first time it is searched for
+ */
 static KeyDef *
 get_key_def( const gchar *key )
 {
 	static const gchar *thisfn = "fma_settings_get_key_def";
-	KeyDef *found = NULL;
+	static GHashTable *st_def_keys_hash = NULL;
+	KeyDef *found;
 	KeyDef *idef;
 
-	idef = ( KeyDef * ) st_def_keys;
-	while( idef->key && !found ){
-		if( !strcmp( idef->key, key )){
-			found = idef;
+	if( g_once_init_enter( &st_def_keys_hash )){
+		GHashTable *hash = g_hash_table_new( g_str_hash, g_str_equal );
+		for( idef = ( KeyDef * ) st_def_keys ; idef->key ; idef++ ){
+			g_hash_table_insert( hash, ( gpointer ) idef->key, idef );
 		}
-		idef++;
+		g_once_init_leave( &st_def_keys_hash, hash );
 	}
+
+	found = ( KeyDef * ) g_hash_table_lookup( st_def_keys_hash, key );
+
 	if( !found ){
 		g_warning( "%s: no KeyDef found for key=%s", thisfn, key );
 	}
@@ -1132,6 +1209,8 @@ key_file_new( const gchar *dir )
 	keyfile = g_new0( KeyFile, 1 );
 
 	keyfile->key_file = g_key_file_new();
+	keyfile->stale = TRUE;
+	keyfile->loaded = FALSE;
 	keyfile->fname = g_strdup_printf( "%s/%s.conf", dir, PACKAGE );
 	fma_core_utils_file_list_perms( keyfile->fname, thisfn );
 
@@ -1150,19 +1229,43 @@ key_file_new( const gchar *dir )
 	return( keyfile );
 }
 
+/* trigger the consumers which have registered for @monitored_key
+ */
+static void
+dispatch_to_consumers( const gchar *monitored_key, const KeyValue *changed )
+{
+	GList *ic;
+	const Consumer *consumer;
+
+	for( ic = g_hash_table_lookup( st_settings->private->consumers, monitored_key ) ; ic ; ic = ic->next ){
+		consumer = ( const Consumer * ) ic->data;
+		( *( FMASettingsKeyCallback ) consumer->callback )(
+				changed->group,
+				changed->def->key,
+				fma_boxed_get_pointer( changed->boxed ),
+				changed->mandatory,
+				consumer->user_data );
+	}
+}
+
 /*
  * one of the two monitored configuration files have changed on the disk
- * we do not try to identify which keys have actually change
- * instead we trigger each registered consumer for the 'global' event
- *
- * consumers which register for the 'global_conf' event are recorded
- * with a NULL key
+ * only this one will be re-read when the burst is terminated, the
+ * content of the other one being kept from its last load
  */
 static void
 on_keyfile_changed( GFileMonitor *monitor,
 		GFile *file, GFile *other_file, GFileMonitorEvent event_type )
 {
 	settings_new();
+
+	if( st_settings->private->mandatory && monitor == st_settings->private->mandatory->monitor ){
+		st_settings->private->mandatory->stale = TRUE;
+	}
+	if( st_settings->private->user && monitor == st_settings->private->user->monitor ){
+		st_settings->private->user->stale = TRUE;
+	}
+
 	fma_timeout_event( &st_settings->private->timeout );
 }
 
@@ -1171,11 +1274,10 @@ on_keyfile_changed_timeout( void )
 {
 	static const gchar *thisfn = "fma_settings_on_keyfile_changed_timeout";
 	GList *new_content;
+	GHashTable *new_index;
 	GList *modifs;
-	GList *ic, *im;
+	GList *im;
 	const KeyValue *changed;
-	const Consumer *consumer;
-	gchar *group_prefix, *key;
 #ifdef FMA_MAINTAINER_MODE
 	gchar *value;
 #endif
@@ -1183,9 +1285,17 @@ on_keyfile_changed_timeout( void )
 	/* last individual notification is older that the st_burst_timeout
 	 * we may so suppose that the burst is terminated
 	 */
-	new_content = content_load_keys( NULL, st_settings->private->mandatory );
-	new_content = content_load_keys( new_content, st_settings->private->user );
-	modifs = content_diff( st_settings->private->content, new_content );
+	new_index = content_index_new();
+
+	/* consumers may read the new values from their callback
+	 */
+	g_mutex_lock( &st_settings->private->cache_mutex );
+	new_content = content_load_keys( NULL, new_index, st_settings->private->mandatory );
+	new_content = content_load_keys( new_content, new_index, st_settings->private->user );
+	cache_clear();
+	g_mutex_unlock( &st_settings->private->cache_mutex );
+
+	modifs = content_diff( st_settings->private->content, st_settings->private->content_index, new_content, new_index );
 
 #ifdef FMA_MAINTAINER_MODE
 	g_debug( "%s: %d found update(s)", thisfn, g_list_length( modifs ));
@@ -1198,33 +1308,18 @@ on_keyfile_changed_timeout( void )
 #endif
 
 	/* for each modification found,
-	 * - check if a consumer has registered for this key, and triggers callback if apply
+	 * - triggers the consumers which have registered for this key,
+	 *   or for the composite key this one is part of
 	 * - send a notification message
 	 */
 	for( im = modifs ; im ; im = im->next ){
 		changed = ( const KeyValue * ) im->data;
 
-		for( ic = st_settings->private->consumers ; ic ; ic = ic->next ){
-			consumer = ( const Consumer * ) ic->data;
-			group_prefix = NULL;
-
-			if( !strcmp( consumer->monitored_key, IPREFS_IO_PROVIDERS_READ_STATUS )){
-				group_prefix = g_strdup_printf( "%s ", IPREFS_IO_PROVIDER_GROUP );
-				key = IPREFS_IO_PROVIDER_READABLE;
-			} else {
-				key = consumer->monitored_key;
-			}
-
-			if(( !group_prefix || g_str_has_prefix( changed->group, group_prefix )) && !strcmp( changed->def->key, key )){
-				( *( FMASettingsKeyCallback ) consumer->callback )(
-						changed->group,
-						changed->def->key,
-						fma_boxed_get_pointer( changed->boxed ),
-						changed->mandatory,
-						consumer->user_data );
-			}
+		dispatch_to_consumers( changed->def->key, changed );
 
-			g_free( group_prefix );
+		if( !strcmp( changed->def->key, IPREFS_IO_PROVIDER_READABLE ) &&
+				g_str_has_prefix( changed->group, IO_PROVIDER_GROUP_PREFIX )){
+			dispatch_to_consumers( IPREFS_IO_PROVIDERS_READ_STATUS, changed );
 		}
 
 		g_debug( "%s: sending signal for group=%s, key=%s", thisfn, changed->group, changed->def->key );
@@ -1234,9 +1329,11 @@ on_keyfile_changed_timeout( void )
 	}
 
 	g_debug( "%s: releasing content", thisfn );
+	g_hash_table_destroy( st_settings->private->content_index );
 	g_list_foreach( st_settings->private->content, ( GFunc ) release_key_value, NULL );
 	g_list_free( st_settings->private->content );
 	st_settings->private->content = new_content;
+	st_settings->private->content_index = new_index;
 
 	g_debug( "%s: releasing modifs", thisfn );
 	g_list_foreach( modifs, ( GFunc ) release_key_value, NULL );
@@ -1250,34 +1347,49 @@ on_key_changed_final_handler( FMASettings *settings, gchar *group, gchar *key, F
 	fma_boxed_dump( new_value );
 }
 
+/*
+ * KeyValue's are identified by their group and their key definition
+ * (which is unique per key)
+ */
+static guint
+key_value_hash( const KeyValue *value )
+{
+	return( g_str_hash( value->group ) ^ g_direct_hash( value->def ));
+}
+
+static gboolean
+key_value_equal( const KeyValue *a, const KeyValue *b )
+{
+	return( a->def == b->def && !strcmp( a->group, b->group ));
+}
+
 static KeyValue *
-peek_key_value_from_content( GList *content, const gchar *group, const gchar *key )
+peek_key_value_from_content( GHashTable *index, const gchar *group, const KeyDef *def )
 {
-	KeyValue *value, *found;
-	GList *ic;
+	KeyValue probe;
 
-	found = NULL;
-	for( ic = content ; ic && !found ; ic = ic->next ){
-		value = ( KeyValue * ) ic->data;
-		if( !strcmp( value->group, group ) && !strcmp( value->def->key, key )){
-			found = value;
-		}
-	}
+	probe.group = group;
+	probe.def = def;
 
-	return( found );
+	return(( KeyValue * ) g_hash_table_lookup( index, &probe ));
 }
 
 /* group may be NULL
+ *
+ * returns a new reference on the boxed value of the key, which should
+ * be g_object_unref() by the caller, or NULL if the key is not found:
+ * the cached KeyValue itself may be released by another thread as soon
+ * as the lock is released
  */
-static KeyValue *
+static FMABoxed *
 read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean *mandatory )
 {
-	static const gchar *thisfn = "fma_settings_read_key_value";
 	KeyDef *key_def;
-	gboolean has_entry;
-	KeyValue *key_value;
+	const gchar *wgroup;
+	GHashTable *group_cache;
+	CacheEntry *entry;
+	FMABoxed *boxed;
 
-	key_value = NULL;
 	if( found ){
 		*found = FALSE;
 	}
@@ -1288,31 +1400,83 @@ read_key_value( const gchar *group, const gchar *key, gboolean *found, gboolean
 	settings_new();
 	key_def = get_key_def( key );
 
-	if( key_def ){
-		has_entry = FALSE;
-		key_value = read_key_value_from_key_file( st_settings->private->mandatory, group ? group : key_def->group, key, key_def );
-		if( key_value ){
-			has_entry = TRUE;
-			if( found ){
-				*found = TRUE;
-			}
-			if( mandatory ){
-				*mandatory = TRUE;
-				g_debug( "%s: %s: key is mandatory", thisfn, key );
-			}
+	if( !key_def ){
+		return( NULL );
+	}
+
+	wgroup = group ? group : key_def->group;
+	boxed = NULL;
+
+	g_mutex_lock( &st_settings->private->cache_mutex );
+
+	group_cache = ( GHashTable * ) g_hash_table_lookup( st_settings->private->cache, wgroup );
+
+	if( !group_cache ){
+		group_cache = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) cache_entry_free );
+		g_hash_table_insert( st_settings->private->cache, g_strdup( wgroup ), group_cache );
+	}
+
+	entry = ( CacheEntry * ) g_hash_table_lookup( group_cache, key );
+
+	if( !entry ){
+		entry = g_new0( CacheEntry, 1 );
+		entry->value = read_key_value_from_key_file( st_settings->private->mandatory, wgroup, key, key_def );
+		if( entry->value ){
+			entry->mandatory = TRUE;
+		} else {
+			entry->value = read_key_value_from_key_file( st_settings->private->user, wgroup, key, key_def );
 		}
-		if( !has_entry ){
-			key_value = read_key_value_from_key_file( st_settings->private->user, group ? group : key_def->group, key, key_def );
-			if( key_value ){
-				has_entry = TRUE;
-				if( found ){
-					*found = TRUE;
-				}
-			}
+		g_hash_table_insert( group_cache, g_strdup( key ), entry );
+	}
+
+	if( entry->value ){
+		boxed = g_object_ref( entry->value->boxed );
+		if( found ){
+			*found = TRUE;
+		}
+		if( mandatory ){
+			*mandatory = entry->mandatory;
 		}
 	}
 
-	return( key_value );
+	g_mutex_unlock( &st_settings->private->cache_mutex );
+
+	return( boxed );
+}
+
+/*
+ * the whole cache is invalidated each time a configuration file changes
+ *
+ * cache_clear() and cache_remove() must be called with cache_mutex held
+ */
+static void
+cache_clear( void )
+{
+	g_hash_table_remove_all( st_settings->private->cache );
+}
+
+static void
+cache_entry_free( CacheEntry *entry )
+{
+	if( entry->value ){
+		release_key_value( entry->value );
+	}
+	g_free( entry );
+}
+
+/*
+ * the in-memory user key file has been modified: the corresponding entry
+ * must be read again without waiting for the file monitor
+ */
+static void
+cache_remove( const gchar *group, const gchar *key )
+{
+	GHashTable *group_cache;
+
+	group_cache = ( GHashTable * ) g_hash_table_lookup( st_settings->private->cache, group );
+	if( group_cache ){
+		g_hash_table_remove( group_cache, key );
+	}
 }
 
 static KeyValue *
@@ -1436,6 +1600,8 @@ set_key_value( const gchar *group, const gchar *key, const gchar *string )
 	}
 	if( wgroup ){
 		ok = TRUE;
+		g_mutex_lock( &st_settings->private->cache_mutex );
+		cache_remove( wgroup, key );
 
 		if( string ){
 			g_key_file_set_string( st_settings->private->user->key_file, wgroup, key, string );
@@ -1449,6 +1615,8 @@ set_key_value( const gchar *group, const gchar *key, const gchar *string )
 			}
 		}
 
+		g_mutex_unlock( &st_settings->private->cache_mutex );
+
 		ok &= write_user_key_file();
 	}
 
@@ -33,65 +33,257 @@
 
 #include <api/fma-timeout.h>
 
+/* the private data is allocated on the first event of a burst, or when
+ * the structure is configured; it is released at the end of the burst
+ * unless the structure has been configured
+ */
+struct _FMATimeoutPrivate {
+	guint    max_wait;
+	guint    flags;
+	gint64   first_time;
+	gint64   last_time;
+	gboolean pending;
+	GSource *source;
+};
+
+static FMATimeoutPrivate *timeout_get_private( FMATimeout *timeout );
+static gint64   timeout_deadline( const FMATimeout *timeout );
+static void     timeout_schedule( FMATimeout *timeout, gint64 deadline );
 static gboolean on_timeout_event_timeout( FMATimeout *timeout );
-static gulong   time_val_diff( const GTimeVal *recent, const GTimeVal *old );
+
+#if GLIB_CHECK_VERSION( 2,36,0 )
+static gboolean on_source_dispatch( GSource *source, GSourceFunc callback, gpointer user_data );
+
+/* a source which is only dispatched when its ready time is reached
+ */
+static GSourceFuncs st_source_funcs = {
+	NULL,
+	NULL,
+	on_source_dispatch,
+	NULL
+};
+#endif
 
 /**
  * fma_timeout_event:
  * @timeout: the #FMATimeout structure which will handle this event.
+ *
+ * Records a new event.
+ *
+ * If this is the first event of a burst, and the leading edge has been
+ * requested, the handler is immediately triggered.
+ *
+ * Since: 3.1
  */
 void
 fma_timeout_event( FMATimeout *event )
 {
+	FMATimeoutPrivate *priv;
+	gint64 now;
+
 	g_return_if_fail( event != NULL );
 
-	g_get_current_time( &event->last_time );
+	priv = timeout_get_private( event );
+	now = g_get_monotonic_time();
+	priv->last_time = now;
+
+	if( !priv->first_time ){
+		priv->first_time = now;
+
+		if( priv->flags & FMA_TIMEOUT_LEADING_EDGE ){
+			priv->pending = FALSE;
+			timeout_schedule( event, timeout_deadline( event ));
+			( *event->handler )( event->user_data );
+			return;
+		}
+	}
+
+	priv->pending = TRUE;
+	timeout_schedule( event, timeout_deadline( event ));
+}
+
+/**
+ * fma_timeout_cancel:
+ * @timeout: the #FMATimeout structure.
+ *
+ * Cancels the current burst, if any, without triggering the handler, and
+ * releases the private data of the structure, including the configuration
+ * set with fma_timeout_set_max_wait() and fma_timeout_set_flags().
+ *
+ * This function must be called before the structure is released.
+ *
+ * Since: 3.5
+ */
+void
+fma_timeout_cancel( FMATimeout *timeout )
+{
+	g_return_if_fail( timeout != NULL );
+
+	if( timeout->private ){
+		if( timeout->private->source ){
+			g_source_destroy( timeout->private->source );
+		}
+		g_free( timeout->private );
+		timeout->private = NULL;
+	}
+}
+
+/**
+ * fma_timeout_set_max_wait:
+ * @timeout: the #FMATimeout structure.
+ * @max_wait: the maximal delay (ms) between the first event of a burst
+ *  and the trailing call to the handler, or zero for no limit.
+ *
+ * Bounds the duration of a burst, so that the handler is still triggered
+ * under a continuous flow of events.
+ *
+ * Since: 3.5
+ */
+void
+fma_timeout_set_max_wait( FMATimeout *timeout, guint max_wait )
+{
+	g_return_if_fail( timeout != NULL );
+
+	timeout_get_private( timeout )->max_wait = max_wait;
+}
+
+/**
+ * fma_timeout_set_flags:
+ * @timeout: the #FMATimeout structure.
+ * @flags: a combination of #FMATimeoutFlags.
+ *
+ * Chooses the edges of a burst on which the handler is triggered.
+ *
+ * Since: 3.5
+ */
+void
+fma_timeout_set_flags( FMATimeout *timeout, guint flags )
+{
+	g_return_if_fail( timeout != NULL );
+
+	timeout_get_private( timeout )->flags = flags;
+}
 
-	if( !event->source_id ){
-		event->source_id = g_timeout_add( event->timeout, ( GSourceFunc ) on_timeout_event_timeout, event );
+static FMATimeoutPrivate *
+timeout_get_private( FMATimeout *timeout )
+{
+	if( !timeout->private ){
+		timeout->private = g_new0( FMATimeoutPrivate, 1 );
 	}
+
+	return( timeout->private );
 }
 
 /*
- * this timer is set when we receive the first event of a serie
- * we continue to loop until last event is older that our burst timeout
+ * the burst is terminated after 'timeout' msec of inactivity, or at
+ * most 'max_wait' msec after its first event
  */
-static gboolean
-on_timeout_event_timeout( FMATimeout *timeout )
+static gint64
+timeout_deadline( const FMATimeout *timeout )
 {
-	GTimeVal now;
-	gulong diff;
-	gulong timeout_usec;
+	gint64 deadline, max_deadline;
 
-	g_get_current_time( &now );
-	diff = time_val_diff( &now, &timeout->last_time );
-	timeout_usec = 1000*timeout->timeout;
+	deadline = timeout->private->last_time + 1000 * ( gint64 ) timeout->timeout;
 
-	if( diff < timeout_usec ){
-		/* do not stop */
-		return( TRUE );
+	if( timeout->private->max_wait ){
+		max_deadline = timeout->private->first_time + 1000 * ( gint64 ) timeout->private->max_wait;
+		deadline = MIN( deadline, max_deadline );
 	}
 
-	/* last individual notification is older that the 'timeout' parameter
-	 * we may so suppose that the burst is terminated
-	 * and feel authorized to trigger the defined callback
-	 */
-	( *timeout->handler )( timeout->user_data );
+	return( deadline );
+}
 
-	/* at the end of the callback execution, reset the event source id.
-	 * and stop the execution of this one
-	 */
-	timeout->source_id = 0;
-	return( FALSE );
+/*
+ * with GLib 2.36 and later, the source is allocated on the first event
+ * of a burst, and its ready time is just moved for each new event
+ *
+ * with older GLib, a timeout source is set when we receive the first
+ * event of a serie, and rescheduled for the remaining delay when it
+ * fires before the end of the burst
+ */
+static void
+timeout_schedule( FMATimeout *timeout, gint64 deadline )
+{
+	FMATimeoutPrivate *priv;
+
+	priv = timeout->private;
+
+#if GLIB_CHECK_VERSION( 2,36,0 )
+	if( !priv->source ){
+		priv->source = g_source_new( &st_source_funcs, sizeof( GSource ));
+		g_source_set_callback( priv->source, ( GSourceFunc ) on_timeout_event_timeout, timeout, NULL );
+		g_source_attach( priv->source, NULL );
+		g_source_unref( priv->source );
+	}
+	g_source_set_ready_time( priv->source, deadline );
+#else
+	gint64 remaining;
+
+	if( !priv->source ){
+		remaining = deadline - g_get_monotonic_time();
+		priv->source = g_timeout_source_new( remaining > 0 ? ( guint )(( remaining + 999 ) / 1000 ) : 0 );
+		g_source_set_callback( priv->source, ( GSourceFunc ) on_timeout_event_timeout, timeout, NULL );
+		g_source_attach( priv->source, NULL );
+		g_source_unref( priv->source );
+	}
+#endif
 }
 
+#if GLIB_CHECK_VERSION( 2,36,0 )
+static gboolean
+on_source_dispatch( GSource *source, GSourceFunc callback, gpointer user_data )
+{
+	return( callback ? callback( user_data ) : FALSE );
+}
+#endif
+
 /*
- * returns the difference in microseconds.
+ * the deadline has been reached (or, with older GLib, the timeout
+ * source has fired)
+ * if no event has been recorded in the meanwhile, the burst is terminated
+ * and we feel authorized to trigger the defined callback
+ *
+ * at the end of the burst, the source is released, along with the private
+ * data when the structure has not been configured: an idle structure so
+ * does not hold any resource, as in 3.1
  */
-static gulong
-time_val_diff( const GTimeVal *recent, const GTimeVal *old )
+static gboolean
+on_timeout_event_timeout( FMATimeout *timeout )
 {
-	gulong microsec = 1000000 * ( recent->tv_sec - old->tv_sec );
-	microsec += recent->tv_usec  - old->tv_usec;
-	return( microsec );
+	FMATimeoutPrivate *priv;
+	gint64 deadline;
+	gboolean trigger;
+
+	priv = timeout->private;
+	deadline = timeout_deadline( timeout );
+
+	if( g_get_monotonic_time() < deadline ){
+#if GLIB_CHECK_VERSION( 2,36,0 )
+		g_source_set_ready_time( priv->source, deadline );
+		return( TRUE );
+#else
+		priv->source = NULL;
+		timeout_schedule( timeout, deadline );
+		return( FALSE );
+#endif
+	}
+
+	/* reset the burst before triggering the handler, so that the
+	 * handler may itself record new events
+	 */
+	trigger = priv->pending && !( priv->flags & FMA_TIMEOUT_NO_TRAILING_EDGE );
+	priv->first_time = 0;
+	priv->pending = FALSE;
+	priv->source = NULL;
+
+	if( !priv->max_wait && !priv->flags ){
+		g_free( priv );
+		timeout->private = NULL;
+	}
+
+	if( trigger ){
+		( *timeout->handler )( timeout->user_data );
+	}
+
+	return( FALSE );
 }
@@ -66,6 +66,8 @@ struct _FMATokensPrivate {
 	gchar   *username;
 	guint    port;
 	gchar   *scheme;
+	gchar   *cwd;						/* the execution environment, */
+	gchar  **envp;						/* when not the current one */
 };
 
 /*  the structure passed to the callback which waits for the end of the child
@@ -227,6 +229,8 @@ instance_finalize( GObject *object )
 	fma_core_utils_slist_free( self->private->basedirs );
 	fma_core_utils_slist_free( self->private->filenames );
 	fma_core_utils_slist_free( self->private->uris );
+	g_free( self->private->cwd );
+	g_strfreev( self->private->envp );
 
 	g_free( self->private );
 
@@ -371,6 +375,32 @@ fma_tokens_parse_for_display( const FMATokens *tokens, const gchar *string, gboo
 	return( parse_singular( tokens, string, 0, utf8, FALSE ));
 }
 
+/*
+ * fma_tokens_set_environment:
+ * @tokens: a #FMATokens object.
+ * @cwd: [allow-none]: the working directory of the commands, when the
+ *  profile does not specify one.
+ * @envp: [allow-none]: the environment of the commands.
+ *
+ * Defines the environment in which the commands are to be executed, when
+ * this is not the environment of the current process (e.g. when executed
+ * by fma-run-daemon on behalf of another process).
+ */
+void
+fma_tokens_set_environment( FMATokens *tokens, const gchar *cwd, gchar **envp )
+{
+	g_return_if_fail( FMA_IS_TOKENS( tokens ));
+
+	if( !tokens->private->dispose_has_run ){
+
+		g_free( tokens->private->cwd );
+		tokens->private->cwd = g_strdup( cwd );
+
+		g_strfreev( tokens->private->envp );
+		tokens->private->envp = g_strdupv( envp );
+	}
+}
+
 /*
  * fma_tokens_execute_action:
  * @tokens: a #FMATokens object.
@@ -538,6 +568,10 @@ execute_action_command( gchar *command, const FMAObjectProfile *profile, const F
 		} else {
 			wdir = fma_object_get_working_dir( profile );
 			wdir_nq = parse_singular( tokens, wdir, 0, FALSE, FALSE );
+			if(( !wdir_nq || !strlen( wdir_nq )) && tokens->private->cwd ){
+				g_free( wdir_nq );
+				wdir_nq = g_strdup( tokens->private->cwd );
+			}
 			g_debug( "%s: run_command=%s, wdir=%s", thisfn, run_command, wdir_nq );
 
 			/* it appears that at least mplayer does not support g_spawn_async_with_pipes
@@ -551,7 +585,7 @@ execute_action_command( gchar *command, const FMAObjectProfile *profile, const F
 				g_spawn_async_with_pipes(
 						wdir_nq,
 						argv,
-						NULL,
+						tokens->private->envp,
 						G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
 						NULL,
 						NULL,
@@ -565,7 +599,7 @@ execute_action_command( gchar *command, const FMAObjectProfile *profile, const F
 				g_spawn_async(
 						wdir_nq,
 						argv,
-						NULL,
+						tokens->private->envp,
 						G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD,
 						NULL,
 						NULL,
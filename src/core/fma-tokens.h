@@ -113,6 +113,8 @@ GType      fma_tokens_get_type            ( void );
 FMATokens *fma_tokens_new_for_example     ( void );
 FMATokens *fma_tokens_new_from_selection  ( GList *selection );
 
+void       fma_tokens_set_environment     ( FMATokens *tokens, const gchar *cwd, gchar **envp );
+
 gchar     *fma_tokens_parse_for_display   ( const FMATokens *tokens, const gchar *string, gboolean utf8 );
 void       fma_tokens_execute_action      ( const FMATokens *tokens, const FMAObjectProfile *profile );
 
@@ -31,6 +31,9 @@
 #include <config.h>
 #endif
 
+#include <glib/gi18n.h>
+#include <string.h>
+
 #include <api/fma-core-utils.h>
 #include <api/fma-gconf-utils.h>
 #include <api/fma-object-api.h>
@@ -53,6 +56,41 @@ struct _FMAUpdaterPrivate {
 	gboolean is_level_zero_writable;
 };
 
+/* an item to be written: the writer thread only deals with duplicates,
+ * so that the items of the caller and of the pivot are not touched
+ * outside of the main thread
+ */
+typedef struct {
+	FMAObjectItem *item;			/* the item of the caller */
+	FMAObjectItem *written;			/* a duplicate of the item */
+	FMAObjectItem *origin;			/* a duplicate of its origin, or NULL */
+}
+	WriteItem;
+
+/* a set of items to be written to the same I/O provider
+ */
+typedef struct {
+	FMAIOProvider *provider;
+	GList         *items;			/* WriteItem's, in writing order */
+	GList         *written;			/* WriteItem's, in reverse writing order */
+	GSList        *messages;
+	gboolean       failed;
+}
+	WriteBatch;
+
+/* the data shared between the caller and the writer thread
+ */
+typedef struct {
+	GList        *batches;
+	GMainContext *context;
+	guint         total;
+	GMutex        mutex;			/* protects the counters below */
+	guint         done;
+	guint         errors;
+	gboolean      finished;
+}
+	WriteRun;
+
 static FMAPivotClass *st_parent_class = NULL;
 
 static GType    register_type( void );
@@ -64,6 +102,13 @@ static void     instance_finalize( GObject *object );
 static gboolean are_preferences_locked( const FMAUpdater *updater );
 static gboolean is_level_zero_writable( const FMAUpdater *updater );
 static void     set_writability_status( FMAObjectItem *item, const FMAUpdater *updater );
+static gpointer write_run( WriteRun *run );
+static void     write_batch( WriteRun *run, WriteBatch *batch );
+static void     write_batch_rollback( WriteBatch *batch );
+static void     write_batch_free( WriteBatch *batch );
+static WriteItem *write_item_new( FMAObjectItem *item );
+static void     write_item_free( WriteItem *witem );
+static void     write_run_progress( WriteRun *run, FMAUpdaterProgress *progress );
 
 GType
 fma_updater_get_type( void )
@@ -622,3 +667,343 @@ fma_updater_delete_item( const FMAUpdater *updater, const FMAObjectItem *item, G
 
 	return( ret );
 }
+
+/*
+ * fma_updater_write_items:
+ * @updater: this #FMAUpdater instance.
+ * @items: the list of #FMAObjectItem to be written, in writing order.
+ * @failed: [out]: set to the list of the items which have not been
+ *  written; the list should be g_list_free() by the caller.
+ * @progress_fn: [allow-none]: a function to be called each time an item
+ *  has been processed.
+ * @user_data: user data to be passed to @progress_fn.
+ * @messages: the I/O providers can allocate and store here their error
+ *  messages.
+ *
+ * Writes the @items, grouped by I/O provider, from a dedicated thread;
+ * the default main context is kept running meanwhile.
+ *
+ * The items of a same provider are written as a transaction: if one
+ * of them cannot be written, the provider is asked to discard the whole
+ * set (or, if it is not able to, the already written ones are restored
+ * to their origin, or deleted if they are new), and all the items of
+ * this provider are returned in @failed. Other providers are not impacted.
+ *
+ * The writer thread only deals with duplicates of the @items, and of
+ * their origin; when the write is successful, the provider and its data
+ * are set back on the @items.
+ *
+ * Returns: the count of items which have not been written.
+ */
+guint
+fma_updater_write_items( const FMAUpdater *updater, GList *items, GList **failed,
+		FMAUpdaterProgressFn progress_fn, void *user_data, GSList **messages )
+{
+	static const gchar *thisfn = "fma_updater_write_items";
+	WriteRun run;
+	WriteBatch *batch;
+	GHashTable *batches;
+	GList *it, *ib;
+	FMAIOProvider *provider;
+	WriteItem *witem;
+	FMAUpdaterProgress progress;
+	GThread *thread;
+	GError *error;
+	guint last_done;
+
+	g_return_val_if_fail( FMA_IS_UPDATER( updater ), 0 );
+	g_return_val_if_fail( failed, 0 );
+	g_return_val_if_fail( messages, 0 );
+
+	*failed = NULL;
+
+	if( updater->private->dispose_has_run ){
+		return( 0 );
+	}
+
+	memset( &run, '\0', sizeof( WriteRun ));
+	g_mutex_init( &run.mutex );
+	run.context = g_main_context_ref_thread_default();
+	run.total = g_list_length( items );
+
+	/* providers are resolved here, as enumerating them is not thread-safe
+	 */
+	batches = g_hash_table_new( g_direct_hash, g_direct_equal );
+	for( it = items ; it ; it = it->next ){
+		provider = fma_object_get_provider( it->data );
+		if( !provider ){
+			provider = fma_io_provider_find_writable_io_provider( FMA_PIVOT( updater ));
+		}
+		if( !provider ){
+			*messages = g_slist_append( *messages, g_strdup( _( "No writable I/O provider has been found." )));
+			*failed = g_list_prepend( *failed, it->data );
+			run.errors += 1;
+			run.done += 1;
+			continue;
+		}
+		batch = ( WriteBatch * ) g_hash_table_lookup( batches, provider );
+		if( !batch ){
+			batch = g_new0( WriteBatch, 1 );
+			batch->provider = provider;
+			g_hash_table_insert( batches, provider, batch );
+			run.batches = g_list_prepend( run.batches, batch );
+		}
+		batch->items = g_list_prepend( batch->items, write_item_new( FMA_OBJECT_ITEM( it->data )));
+	}
+	g_hash_table_destroy( batches );
+
+	run.batches = g_list_reverse( run.batches );
+	for( ib = run.batches ; ib ; ib = ib->next ){
+		batch = ( WriteBatch * ) ib->data;
+		batch->items = g_list_reverse( batch->items );
+	}
+
+	g_debug( "%s: updater=%p, items=%u, batches=%d",
+			thisfn, ( void * ) updater, run.total, g_list_length( run.batches ));
+
+	error = NULL;
+	thread = NULL;
+
+	if( run.batches ){
+		thread = g_thread_try_new( "fma-updater-write", ( GThreadFunc ) write_run, &run, &error );
+		if( !thread ){
+			g_warning( "%s: %s", thisfn, error->message );
+			g_error_free( error );
+			write_run( &run );
+		}
+	}
+
+	/* keep the caller's main context alive while the thread is busy;
+	 * each written item wakes the context up
+	 */
+	if( thread ){
+		last_done = 0;
+		while( TRUE ){
+			g_main_context_iteration( run.context, TRUE );
+			write_run_progress( &run, &progress );
+			if( progress.done != last_done ){
+				last_done = progress.done;
+				if( progress_fn ){
+					( *progress_fn )( &progress, user_data );
+				}
+			}
+			g_mutex_lock( &run.mutex );
+			if( run.finished ){
+				g_mutex_unlock( &run.mutex );
+				break;
+			}
+			g_mutex_unlock( &run.mutex );
+		}
+		g_thread_join( thread );
+	}
+
+	write_run_progress( &run, &progress );
+	if( progress_fn ){
+		( *progress_fn )( &progress, user_data );
+	}
+
+	for( ib = run.batches ; ib ; ib = ib->next ){
+		batch = ( WriteBatch * ) ib->data;
+		for( it = batch->items ; it ; it = it->next ){
+			witem = ( WriteItem * ) it->data;
+			if( batch->failed ){
+				*failed = g_list_prepend( *failed, witem->item );
+			} else {
+				if( fma_object_get_provider_data( witem->written ) != fma_object_get_provider_data( witem->item )){
+					fma_io_provider_duplicate_data( batch->provider, witem->item, witem->written, NULL );
+				}
+				fma_object_set_provider( witem->item, batch->provider );
+			}
+		}
+		*messages = g_slist_concat( *messages, batch->messages );
+		batch->messages = NULL;
+	}
+	*failed = g_list_reverse( *failed );
+
+	g_debug( "%s: done=%u, errors=%u", thisfn, progress.done, progress.errors );
+
+	g_list_free_full( run.batches, ( GDestroyNotify ) write_batch_free );
+	g_main_context_unref( run.context );
+	g_mutex_clear( &run.mutex );
+
+	return( progress.errors );
+}
+
+/*
+ * the batches are written one after the other, in the order of the
+ * first occurrence of their provider in the list of items
+ */
+static gpointer
+write_run( WriteRun *run )
+{
+	GList *ib;
+
+	for( ib = run->batches ; ib ; ib = ib->next ){
+		write_batch( run, ( WriteBatch * ) ib->data );
+	}
+
+	g_mutex_lock( &run->mutex );
+	run->finished = TRUE;
+	g_mutex_unlock( &run->mutex );
+
+	g_main_context_wakeup( run->context );
+
+	return( NULL );
+}
+
+static void
+write_batch( WriteRun *run, WriteBatch *batch )
+{
+	static const gchar *thisfn = "fma_updater_write_batch";
+	GList *it;
+	WriteItem *witem;
+	guint ret, processed;
+	gboolean started;
+
+	ret = fma_io_provider_write_items_start( batch->provider, &batch->messages );
+	started = ( ret == IIO_PROVIDER_CODE_OK );
+	if( !started ){
+		g_warning( "%s: unable to start writing: ret=%u", thisfn, ret );
+		batch->failed = TRUE;
+	}
+
+	processed = 0;
+
+	for( it = started ? batch->items : NULL ; it ; it = it->next ){
+		witem = ( WriteItem * ) it->data;
+		ret = fma_io_provider_write_item( batch->provider, witem->written, &batch->messages );
+
+		if( ret != IIO_PROVIDER_CODE_OK ){
+			g_warning( "%s: unable to write item=%p: ret=%u, discarding %d item(s)",
+					thisfn, ( void * ) witem->item, ret, g_list_length( batch->written ));
+			batch->failed = TRUE;
+			break;
+		}
+
+		batch->written = g_list_prepend( batch->written, it->data );
+		processed += 1;
+
+		g_mutex_lock( &run->mutex );
+		run->done += 1;
+		g_mutex_unlock( &run->mutex );
+
+		g_main_context_wakeup( run->context );
+	}
+
+	/* on failure, the provider discards the whole set of items; if it
+	 * is not able to, the already written items are restored, and the
+	 * restored items are committed as usual
+	 */
+	if( started && batch->failed ){
+		ret = fma_io_provider_write_items_abort( batch->provider, &batch->messages );
+		if( ret == IIO_PROVIDER_CODE_OK ){
+			started = FALSE;
+		} else {
+			write_batch_rollback( batch );
+		}
+	}
+
+	/* the written (or restored) items are committed by the provider
+	 * at this time
+	 */
+	if( started ){
+		ret = fma_io_provider_write_items_done( batch->provider, &batch->messages );
+		if( ret != IIO_PROVIDER_CODE_OK ){
+			g_warning( "%s: unable to commit the written items: ret=%u", thisfn, ret );
+			batch->failed = TRUE;
+		}
+	}
+
+	if( batch->failed ){
+		g_mutex_lock( &run->mutex );
+		run->done += g_list_length( batch->items ) - processed;
+		run->errors += g_list_length( batch->items );
+		g_mutex_unlock( &run->mutex );
+
+		g_main_context_wakeup( run->context );
+	}
+}
+
+/*
+ * the already written items are restored to their origin, i.e. the
+ * item as it has been read from the provider; new items are deleted
+ *
+ * this is only used with providers which are not able to abort a set
+ * of items
+ */
+static void
+write_batch_rollback( WriteBatch *batch )
+{
+	static const gchar *thisfn = "fma_updater_write_batch_rollback";
+	GList *it;
+	WriteItem *witem;
+	guint ret;
+
+	for( it = batch->written ; it ; it = it->next ){
+		witem = ( WriteItem * ) it->data;
+
+		if( witem->origin ){
+			ret = fma_io_provider_write_item( batch->provider, witem->origin, &batch->messages );
+		} else {
+			ret = fma_io_provider_delete_item( batch->provider, witem->written, &batch->messages );
+		}
+
+		if( ret != IIO_PROVIDER_CODE_OK ){
+			g_warning( "%s: unable to restore item=%p: ret=%u", thisfn, ( void * ) witem->item, ret );
+		}
+	}
+
+	g_list_free( batch->written );
+	batch->written = NULL;
+}
+
+static void
+write_batch_free( WriteBatch *batch )
+{
+	g_list_free_full( batch->items, ( GDestroyNotify ) write_item_free );
+	g_list_free( batch->written );
+	fma_core_utils_slist_free( batch->messages );
+	g_free( batch );
+}
+
+/*
+ * the duplicates are allocated in the main thread, before the writer
+ * thread is started
+ */
+static WriteItem *
+write_item_new( FMAObjectItem *item )
+{
+	WriteItem *witem;
+	FMAObjectItem *origin;
+
+	witem = g_new0( WriteItem, 1 );
+	witem->item = item;
+	witem->written = FMA_OBJECT_ITEM( fma_object_duplicate( item, FMA_DUPLICATE_REC ));
+
+	origin = ( FMAObjectItem * ) fma_object_get_origin( item );
+	if( origin ){
+		witem->origin = FMA_OBJECT_ITEM( fma_object_duplicate( origin, FMA_DUPLICATE_REC ));
+	}
+
+	return( witem );
+}
+
+static void
+write_item_free( WriteItem *witem )
+{
+	fma_object_unref( witem->written );
+	if( witem->origin ){
+		fma_object_unref( witem->origin );
+	}
+	g_free( witem );
+}
+
+static void
+write_run_progress( WriteRun *run, FMAUpdaterProgress *progress )
+{
+	g_mutex_lock( &run->mutex );
+	progress->total = run->total;
+	progress->done = run->done;
+	progress->errors = run->errors;
+	g_mutex_unlock( &run->mutex );
+}
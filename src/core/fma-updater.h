@@ -92,6 +92,21 @@ GList      *fma_updater_load_items ( FMAUpdater *updater );
 guint       fma_updater_write_item ( const FMAUpdater *updater, FMAObjectItem *item, GSList **messages );
 guint       fma_updater_delete_item( const FMAUpdater *updater, const FMAObjectItem *item, GSList **messages );
 
+/* write a set of items as one transaction per I/O provider
+ */
+typedef struct {
+	guint   total;
+	guint   done;
+	guint   errors;
+}
+	FMAUpdaterProgress;
+
+typedef void ( *FMAUpdaterProgressFn )( const FMAUpdaterProgress *progress, void *user_data );
+
+guint       fma_updater_write_items( const FMAUpdater *updater, GList *items, GList **failed,
+										FMAUpdaterProgressFn progress_fn, void *user_data,
+										GSList **messages );
+
 G_END_DECLS
 
 #endif /* __CORE_FMA_UPDATER_H__ */
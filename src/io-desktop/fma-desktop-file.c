@@ -31,14 +31,22 @@
 #include <config.h>
 #endif
 
+#include <errno.h>
+#include <fcntl.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <gio/gio.h>
+#include <glib/gstdio.h>
 
 #include <api/fma-core-utils.h>
+#include <api/fma-data-types.h>
+#include <api/fma-object-api.h>
 
 #include "fma-desktop-file.h"
 #include "fma-desktop-keys.h"
+#include "fma-desktop-utils.h"
 
 /* private class data
  */
@@ -53,11 +61,66 @@ struct _FMADesktopFilePrivate {
 	gchar     *id;
 	gchar     *uri;
 	gchar     *type;
-	GKeyFile  *key_file;
+	GKeyFile  *key_file;				/* the whole file, loaded when needed */
+	GKeyFile  *entries;					/* the known entries parsed from a path */
+	gchar    **groups;					/* the groups of the parsed file */
 };
 
+/* a file staged in a batch
+ */
+typedef struct {
+	gchar *path;
+	gchar *tmp_path;
+}
+	StagedFile;
+
+struct _FMADesktopFileBatch {
+	GList *staged;						/* in staging order */
+	GList *deleted;						/* URIs to be deleted on commit */
+};
+
+/* a file we have ourselves written or deleted
+ * the stamp is only known once the file has been renamed; until then,
+ * the write is said pending
+ */
+typedef struct {
+	guint    generation;
+	gboolean pending;
+	gboolean deleted;
+	gint64   mtime;						/* in usec */
+	goffset  size;
+}
+	OwnWrite;
+
+/* the state of the parser of a mapped file
+ */
+typedef struct {
+	GKeyFile           *entries;
+	GPtrArray          *groups;			/* group names, in file order */
+	const gchar        *group;			/* the current group */
+	gboolean            wanted;			/* whether the current group is read */
+	GHashTable         *known;			/* known entries */
+	const gchar *const *languages;		/* the locale fallback chain */
+	guint               n_languages;
+	GHashTable         *ranks;			/* group -> ( known key -> locale rank of the kept value ) */
+}
+	ParseState;
+
+/* the known entries are those which are read from .desktop files
+ */
+#define KNOWN_PLAIN						1
+#define KNOWN_LOCALIZED					2
+#define KNOWN_MAX_LENGTH				64
+
+#define STAGED_PREFIX					".fma-desktop-"
+#define STAGED_TEMPLATE					STAGED_PREFIX "XXXXXX"
+
 static GObjectClass *st_parent_class = NULL;
 
+static GMutex        st_own_mutex;				/* protects the two below */
+static GHashTable   *st_own_writes   = NULL;	/* path -> OwnWrite */
+static guint         st_generation   = 0;
+
 static GType           register_type( void );
 static void            class_init( FMADesktopFileClass *klass );
 static void            instance_init( GTypeInstance *instance, gpointer klass );
@@ -67,8 +130,26 @@ static void            instance_finalize( GObject *object );
 static FMADesktopFile *ndf_new( const gchar *uri );
 static gchar          *path2id( const gchar *path );
 static gchar          *uri2id( const gchar *uri );
-static gboolean        check_key_file( FMADesktopFile *ndf );
+static gboolean        check_key_file( FMADesktopFile *ndf, GKeyFile *key_file, const gchar *start_group );
+static GHashTable     *known_entries_get( void );
+static gboolean        parse_mapped_file( FMADesktopFile *ndf, const gchar *path );
+static gboolean        parse_line( ParseState *state, const gchar *line, const gchar *end );
+static gboolean        parse_group( ParseState *state, const gchar *name, const gchar *end );
+static void            parse_entry( ParseState *state, const gchar *key, const gchar *key_end, const gchar *value, const gchar *end );
+static guint           locale_rank( ParseState *state, const gchar *open, const gchar *key_end );
+static GKeyFile       *read_key_file( const FMADesktopFile *ndf );
+static GKeyFile       *write_key_file( const FMADesktopFile *ndf );
+static gchar         **get_groups( const FMADesktopFile *ndf );
 static void            remove_encoding_part( FMADesktopFile *ndf );
+static gboolean        write_with_gio( FMADesktopFile *ndf, const gchar *data, gsize length );
+static gboolean        stage_data( FMADesktopFileBatch *batch, const gchar *path, const gchar *data, gsize length );
+static gboolean        unstage_path( FMADesktopFileBatch *batch, const gchar *path );
+static void            undelete_uri( FMADesktopFileBatch *batch, const gchar *uri );
+static void            staged_file_free( StagedFile *staged, gboolean unlink );
+static void            own_write_record( const gchar *path, guint generation, gboolean pending, gboolean deleted );
+static void            own_write_forget( const gchar *path, guint generation );
+static gboolean        own_write_get_stamp( const gchar *path, gint64 *mtime, goffset *size );
+static void            sync_dir( const gchar *dir );
 
 GType
 fma_desktop_file_get_type( void )
@@ -138,7 +219,6 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private = g_new0( FMADesktopFilePrivate, 1 );
 
 	self->private->dispose_has_run = FALSE;
-	self->private->key_file = g_key_file_new();
 }
 
 static void
@@ -184,6 +264,12 @@ instance_finalize( GObject *object )
 		g_key_file_free( self->private->key_file );
 	}
 
+	if( self->private->entries ){
+		g_key_file_free( self->private->entries );
+	}
+
+	g_strfreev( self->private->groups );
+
 	g_free( self->private );
 
 	/* chain call to parent class */
@@ -214,6 +300,11 @@ fma_desktop_file_new( void )
  * Retuns: a newly allocated #FMADesktopFile object.
  *
  * Key file has been loaded, and first validity checks made.
+ *
+ * Starting with v 3.5, the file is mapped and parsed in place, and
+ * only the entries which are read by the provider are kept, localized
+ * ones being resolved against the current locale. The whole key file
+ * is only loaded if the object is later modified.
  */
 FMADesktopFile *
 fma_desktop_file_new_from_path( const gchar *path )
@@ -240,15 +331,12 @@ fma_desktop_file_new_from_path( const gchar *path )
 
 	g_free( uri );
 
-	g_key_file_load_from_file( ndf->private->key_file, path, G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS, &error );
-	if( error ){
-		g_warning( "%s: %s: %s", thisfn, path, error->message );
-		g_error_free( error );
+	if( !parse_mapped_file( ndf, path )){
 		g_object_unref( ndf );
 		return( NULL );
 	}
 
-	if( !check_key_file( ndf )){
+	if( !check_key_file( ndf, ndf->private->entries, ndf->private->groups[0] )){
 		g_object_unref( ndf );
 		return( NULL );
 	}
@@ -276,6 +364,8 @@ fma_desktop_file_new_from_uri( const gchar *uri )
 	GError *error;
 	gchar *data;
 	gsize length;
+	gchar *start_group;
+	gboolean ok;
 
 	ndf = NULL;
 	data = NULL;
@@ -295,6 +385,7 @@ fma_desktop_file_new_from_uri( const gchar *uri )
 
 	error = NULL;
 	ndf = ndf_new( uri );
+	ndf->private->key_file = g_key_file_new();
 	g_key_file_load_from_data( ndf->private->key_file, data, length, G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS, &error );
 	g_free( data );
 
@@ -307,7 +398,11 @@ fma_desktop_file_new_from_uri( const gchar *uri )
 		return( NULL );
 	}
 
-	if( !check_key_file( ndf )){
+	start_group = g_key_file_get_start_group( ndf->private->key_file );
+	ok = check_key_file( ndf, ndf->private->key_file, start_group );
+	g_free( start_group );
+
+	if( !ok ){
 		g_object_unref( ndf );
 		return( NULL );
 	}
@@ -354,6 +449,9 @@ fma_desktop_file_new_for_write( const gchar *path )
  * @ndf: the #FMADesktopFile instance.
  *
  * Returns: a pointer to the internal #GKeyFile.
+ *
+ * Starting with v 3.5, the whole key file is loaded here if it has
+ * not been yet.
  */
 GKeyFile *
 fma_desktop_file_get_key_file( const FMADesktopFile *ndf )
@@ -366,7 +464,7 @@ fma_desktop_file_get_key_file( const FMADesktopFile *ndf )
 
 	if( !ndf->private->dispose_has_run ){
 
-		key_file = ndf->private->key_file;
+		key_file = write_key_file( ndf );
 	}
 
 	return( key_file );
@@ -442,12 +540,16 @@ uri2id( const gchar *uri )
 	return( id );
 }
 
+/*
+ * @key_file: the #GKeyFile which has been loaded.
+ * @start_group: the first group of the file, which may not have any
+ *  entry in @key_file.
+ */
 static gboolean
-check_key_file( FMADesktopFile *ndf )
+check_key_file( FMADesktopFile *ndf, GKeyFile *key_file, const gchar *start_group )
 {
 	static const gchar *thisfn = "fma_desktop_file_check_key_file";
 	gboolean ret;
-	gchar *start_group;
 	gboolean has_key;
 	gboolean hidden;
 	gchar *type;
@@ -457,22 +559,21 @@ check_key_file( FMADesktopFile *ndf )
 	error = NULL;
 
 	/* start group must be [Desktop Entry] */
-	start_group = g_key_file_get_start_group( ndf->private->key_file );
-	if( strcmp( start_group, FMA_DESKTOP_GROUP_DESKTOP )){
+	if( !start_group || strcmp( start_group, FMA_DESKTOP_GROUP_DESKTOP )){
 		g_debug( "%s: %s: invalid start group, found %s, waited for %s",
 				thisfn, ndf->private->uri, start_group, FMA_DESKTOP_GROUP_DESKTOP );
 		ret = FALSE;
 	}
 
 	/* must not have Hidden=true value */
-	if( ret ){
-		has_key = g_key_file_has_key( ndf->private->key_file, start_group, FMA_DESTOP_KEY_HIDDEN, &error );
+	if( ret && g_key_file_has_group( key_file, start_group )){
+		has_key = g_key_file_has_key( key_file, start_group, FMA_DESTOP_KEY_HIDDEN, &error );
 		if( error ){
 			g_debug( "%s: %s: %s", thisfn, ndf->private->uri, error->message );
 			ret = FALSE;
 
 		} else if( has_key ){
-			hidden = g_key_file_get_boolean( ndf->private->key_file, start_group, FMA_DESTOP_KEY_HIDDEN, &error );
+			hidden = g_key_file_get_boolean( key_file, start_group, FMA_DESTOP_KEY_HIDDEN, &error );
 			if( error ){
 				g_debug( "%s: %s: %s", thisfn, ndf->private->uri, error->message );
 				ret = FALSE;
@@ -489,14 +590,15 @@ check_key_file( FMADesktopFile *ndf )
 	 */
 	if( ret ){
 		type = NULL;
-		has_key = g_key_file_has_key( ndf->private->key_file, start_group, FMA_DESTOP_KEY_TYPE, &error );
+		has_key = g_key_file_has_group( key_file, start_group ) &&
+				g_key_file_has_key( key_file, start_group, FMA_DESTOP_KEY_TYPE, &error );
 		if( error ){
 			g_debug( "%s: %s", thisfn, error->message );
 			g_error_free( error );
 			ret = FALSE;
 
 		} else if( has_key ){
-			type = g_key_file_get_string( ndf->private->key_file, start_group, FMA_DESTOP_KEY_TYPE, &error );
+			type = g_key_file_get_string( key_file, start_group, FMA_DESTOP_KEY_TYPE, &error );
 			if( error ){
 				g_debug( "%s: %s", thisfn, error->message );
 				g_free( type );
@@ -506,6 +608,7 @@ check_key_file( FMADesktopFile *ndf )
 		}
 		if( ret ){
 			if( !type || !strlen( type )){
+				g_free( type );
 				type = g_strdup( FMA_DESKTOP_VALUE_TYPE_ACTION );
 
 			} else if( strcmp( type, FMA_DESKTOP_VALUE_TYPE_MENU ) && strcmp( type, FMA_DESKTOP_VALUE_TYPE_ACTION )){
@@ -520,11 +623,382 @@ check_key_file( FMADesktopFile *ndf )
 		}
 	}
 
-	g_free( start_group );
-
 	return( ret );
 }
 
+/*
+ * The known entries are the desktop entries of the data definitions of
+ * the items, along with the keys the provider itself reads.
+ * They are collected once, and never released.
+ */
+static GHashTable *
+known_entries_get( void )
+{
+	static GHashTable *st_known = NULL;
+	GHashTable *hash;
+	FMAIFactoryObject *objects[3];
+	FMADataGroup *groups;
+	FMADataDef *def;
+	guint i;
+
+	if( g_once_init_enter( &st_known )){
+		hash = g_hash_table_new( g_str_hash, g_str_equal );
+		g_hash_table_insert( hash, ( gpointer ) FMA_DESTOP_KEY_TYPE, GUINT_TO_POINTER( KNOWN_PLAIN ));
+		g_hash_table_insert( hash, ( gpointer ) FMA_DESTOP_KEY_HIDDEN, GUINT_TO_POINTER( KNOWN_PLAIN ));
+		g_hash_table_insert( hash, ( gpointer ) FMA_DESTOP_KEY_PROFILES, GUINT_TO_POINTER( KNOWN_PLAIN ));
+		g_hash_table_insert( hash, ( gpointer ) FMA_DESTOP_KEY_ITEMS_LIST, GUINT_TO_POINTER( KNOWN_PLAIN ));
+
+		objects[0] = FMA_IFACTORY_OBJECT( fma_object_action_new());
+		objects[1] = FMA_IFACTORY_OBJECT( fma_object_menu_new());
+		objects[2] = FMA_IFACTORY_OBJECT( fma_object_profile_new());
+
+		for( i = 0 ; i < G_N_ELEMENTS( objects ) ; ++i ){
+			for( groups = fma_ifactory_object_get_data_groups( objects[i] ) ; groups && groups->group ; groups++ ){
+				for( def = groups->def ; def && def->name ; def++ ){
+					if( def->desktop_entry ){
+						g_hash_table_insert( hash, def->desktop_entry,
+								GUINT_TO_POINTER( def->type == FMA_DATA_TYPE_LOCALE_STRING ? KNOWN_LOCALIZED : KNOWN_PLAIN ));
+					}
+				}
+			}
+			g_object_unref( objects[i] );
+		}
+
+		g_once_init_leave( &st_known, hash );
+	}
+
+	return( st_known );
+}
+
+/*
+ * Maps the file read-only, and tokenizes its lines in place.
+ *
+ * Only the known entries of [Desktop Entry] and profile groups are
+ * materialized; for a localized entry, only the value which best fits
+ * the current locale is kept, under the unlocalized key.
+ *
+ * Syntax errors are those which would have prevented GKeyFile to load
+ * the file.
+ */
+static gboolean
+parse_mapped_file( FMADesktopFile *ndf, const gchar *path )
+{
+	static const gchar *thisfn = "fma_desktop_file_parse_mapped_file";
+	GMappedFile *mapped;
+	GError *error;
+	ParseState state;
+	const gchar *data, *end, *line, *eol;
+	guint count;
+	gboolean ok;
+
+	error = NULL;
+	mapped = g_mapped_file_new( path, FALSE, &error );
+	if( !mapped ){
+		g_warning( "%s: %s: %s", thisfn, path, error->message );
+		g_error_free( error );
+		return( FALSE );
+	}
+
+	state.entries = g_key_file_new();
+	state.groups = g_ptr_array_new();
+	state.group = NULL;
+	state.wanted = FALSE;
+	state.known = known_entries_get();
+	state.languages = g_get_language_names();
+	state.n_languages = g_strv_length(( gchar ** ) state.languages );
+	state.ranks = g_hash_table_new_full( g_direct_hash, g_direct_equal, NULL, ( GDestroyNotify ) g_hash_table_destroy );
+
+	data = g_mapped_file_get_contents( mapped );
+	end = data + g_mapped_file_get_length( mapped );
+	count = 0;
+	ok = TRUE;
+
+	for( line = data ; ok && line && line < end ; line = eol ? eol+1 : NULL ){
+		count += 1;
+		eol = memchr( line, '\n', end-line );
+		ok = parse_line( &state, line, eol ? eol : end );
+	}
+
+	g_mapped_file_unref( mapped );
+	g_hash_table_destroy( state.ranks );
+	g_ptr_array_add( state.groups, NULL );
+
+	if( ok ){
+		ndf->private->entries = state.entries;
+		ndf->private->groups = ( gchar ** ) g_ptr_array_free( state.groups, FALSE );
+
+	} else {
+		g_warning( "%s: %s: line %u is not a key-value pair, group, or comment", thisfn, path, count );
+		g_key_file_free( state.entries );
+		g_strfreev(( gchar ** ) g_ptr_array_free( state.groups, FALSE ));
+	}
+
+	return( ok );
+}
+
+/*
+ * @line: the start of the line.
+ * @end: the end of the line, excluding the '\n'.
+ */
+static gboolean
+parse_line( ParseState *state, const gchar *line, const gchar *end )
+{
+	const gchar *eq, *key_end, *value;
+
+	if( end > line && end[-1] == '\r' ){
+		end--;
+	}
+	while( line < end && g_ascii_isspace( *line )){
+		line++;
+	}
+	if( line == end || *line == '#' ){
+		return( TRUE );
+	}
+	if( *line == '[' ){
+		return( parse_group( state, line+1, end ));
+	}
+
+	eq = memchr( line, '=', end-line );
+	if( !eq || eq == line || !state->group ){
+		return( FALSE );
+	}
+
+	if( state->wanted ){
+		key_end = eq;
+		while( key_end > line && g_ascii_isspace( key_end[-1] )){
+			key_end--;
+		}
+		value = eq+1;
+		while( value < end && g_ascii_isspace( *value )){
+			value++;
+		}
+		parse_entry( state, line, key_end, value, end );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * @name: the start of the group name, just after the opening bracket.
+ * @end: the end of the line.
+ *
+ * A group which appears several times is merged, as GKeyFile does.
+ */
+static gboolean
+parse_group( ParseState *state, const gchar *name, const gchar *end )
+{
+	const gchar *close, *p;
+	gchar *group;
+	guint i;
+
+	for( close = end ; close > name && close[-1] != ']' ; close-- ){
+		if( !g_ascii_isspace( close[-1] )){
+			return( FALSE );
+		}
+	}
+	if( close == name ){
+		return( FALSE );
+	}
+	close--;
+	if( close == name ){
+		return( FALSE );
+	}
+	for( p = name ; p < close ; ++p ){
+		if( *p == '[' || *p == ']' || g_ascii_iscntrl( *p )){
+			return( FALSE );
+		}
+	}
+
+	state->group = NULL;
+	for( i = 0 ; i < state->groups->len && !state->group ; ++i ){
+		group = ( gchar * ) g_ptr_array_index( state->groups, i );
+		if( strlen( group ) == ( gsize )( close-name ) && !strncmp( group, name, close-name )){
+			state->group = group;
+		}
+	}
+	if( !state->group ){
+		group = g_strndup( name, close-name );
+		g_ptr_array_add( state->groups, group );
+		state->group = group;
+	}
+
+	state->wanted =
+			!strcmp( state->group, FMA_DESKTOP_GROUP_DESKTOP ) ||
+			g_str_has_prefix( state->group, FMA_DESKTOP_GROUP_PROFILE " " );
+
+	/* a wanted group must exist even without any known entry, so that
+	 * reading it does not fail; GKeyFile has no API to add an empty group
+	 */
+	if( state->wanted && !g_key_file_has_group( state->entries, state->group )){
+		g_key_file_set_value( state->entries, state->group, FMA_DESTOP_KEY_TYPE, "" );
+		g_key_file_remove_key( state->entries, state->group, FMA_DESTOP_KEY_TYPE, NULL );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * @key: the start of the key, maybe with a [locale] suffix.
+ * @key_end: the end of the key.
+ * @value: the start of the raw value.
+ * @end: the end of the value.
+ *
+ * The raw value is stored, so that GKeyFile later takes care of the
+ * unescaping and of the type conversions.
+ */
+static void
+parse_entry( ParseState *state, const gchar *key, const gchar *key_end, const gchar *value, const gchar *end )
+{
+	gchar name[KNOWN_MAX_LENGTH];
+	const gchar *open;
+	gsize name_len;
+	guint known, rank;
+	gchar *str;
+	gpointer interned, kept;
+	GHashTable *ranks;
+
+	open = memchr( key, '[', key_end-key );
+	name_len = ( open ? open : key_end ) - key;
+	if( name_len >= sizeof( name )){
+		return;
+	}
+	memcpy( name, key, name_len );
+	name[name_len] = '\0';
+
+	if( !g_hash_table_lookup_extended( state->known, name, &interned, &kept )){
+		return;
+	}
+	known = GPOINTER_TO_UINT( kept );
+
+	/* the known keys and the group names are unique strings, so that
+	 * the ranks are indexed by address
+	 */
+	if( known == KNOWN_LOCALIZED ){
+		rank = locale_rank( state, open, key_end );
+		if( rank == G_MAXUINT ){
+			return;
+		}
+		ranks = ( GHashTable * ) g_hash_table_lookup( state->ranks, state->group );
+		if( !ranks ){
+			ranks = g_hash_table_new( g_direct_hash, g_direct_equal );
+			g_hash_table_insert( state->ranks, ( gpointer ) state->group, ranks );
+		}
+		if( g_hash_table_lookup_extended( ranks, interned, NULL, &kept ) && GPOINTER_TO_UINT( kept ) < rank ){
+			return;
+		}
+		g_hash_table_insert( ranks, interned, GUINT_TO_POINTER( rank ));
+
+	} else if( open ){
+		return;
+	}
+
+	str = g_strndup( value, end-value );
+	g_key_file_set_value( state->entries, state->group, name, str );
+	g_free( str );
+}
+
+/*
+ * Returns: the rank of the [locale] suffix among the current languages,
+ * the unlocalized key being ranked last, or G_MAXUINT if the locale is
+ * not a current one.
+ */
+static guint
+locale_rank( ParseState *state, const gchar *open, const gchar *key_end )
+{
+	const gchar *locale;
+	gsize len;
+	guint i;
+
+	if( !open ){
+		return( state->n_languages );
+	}
+	if( key_end[-1] != ']' ){
+		return( G_MAXUINT );
+	}
+
+	locale = open+1;
+	len = key_end-1-locale;
+
+	for( i = 0 ; i < state->n_languages ; ++i ){
+		if( !strncmp( state->languages[i], locale, len ) && !state->languages[i][len] ){
+			return( i );
+		}
+	}
+
+	return( G_MAXUINT );
+}
+
+/*
+ * Entries parsed from a path are enough to be read, until the whole
+ * key file has been loaded.
+ */
+static GKeyFile *
+read_key_file( const FMADesktopFile *ndf )
+{
+	if( ndf->private->key_file ){
+		return( ndf->private->key_file );
+	}
+	if( ndf->private->entries ){
+		return( ndf->private->entries );
+	}
+	return( write_key_file( ndf ));
+}
+
+/*
+ * The whole key file is only loaded when it is going to be modified,
+ * so that comments, translations and unknown entries are kept on write.
+ * Parsed entries are then released.
+ */
+static GKeyFile *
+write_key_file( const FMADesktopFile *ndf )
+{
+	static const gchar *thisfn = "fma_desktop_file_write_key_file";
+	gchar *path, *data;
+	gsize length;
+	GError *error;
+
+	if( !ndf->private->key_file ){
+		ndf->private->key_file = g_key_file_new();
+
+		if( ndf->private->entries ){
+			error = NULL;
+			path = g_filename_from_uri( ndf->private->uri, NULL, NULL );
+
+			if( !path || !g_key_file_load_from_file( ndf->private->key_file, path, G_KEY_FILE_KEEP_COMMENTS | G_KEY_FILE_KEEP_TRANSLATIONS, &error )){
+				if( error ){
+					g_warning( "%s: %s: %s", thisfn, ndf->private->uri, error->message );
+					g_error_free( error );
+				}
+				g_key_file_free( ndf->private->key_file );
+				ndf->private->key_file = g_key_file_new();
+				data = g_key_file_to_data( ndf->private->entries, &length, NULL );
+				g_key_file_load_from_data( ndf->private->key_file, data, length, G_KEY_FILE_NONE, NULL );
+				g_free( data );
+			}
+
+			g_free( path );
+			g_key_file_free( ndf->private->entries );
+			ndf->private->entries = NULL;
+			g_strfreev( ndf->private->groups );
+			ndf->private->groups = NULL;
+		}
+	}
+
+	return( ndf->private->key_file );
+}
+
+/*
+ * Returns: the list of the groups, to be g_strfreev() by the caller.
+ */
+static gchar **
+get_groups( const FMADesktopFile *ndf )
+{
+	if( ndf->private->groups ){
+		return( g_strdupv( ndf->private->groups ));
+	}
+	return( g_key_file_get_groups( read_key_file( ndf ), NULL ));
+}
+
 /**
  * fma_desktop_file_get_type:
  * @ndf: the #FMADesktopFile instance.
@@ -597,7 +1071,7 @@ fma_desktop_file_get_profiles( const FMADesktopFile *ndf )
 
 	if( !ndf->private->dispose_has_run ){
 
-		groups = g_key_file_get_groups( ndf->private->key_file, NULL );
+		groups = get_groups( ndf );
 		if( groups ){
 			ig = groups;
 			profile_pfx = g_strdup_printf( "%s ", FMA_DESKTOP_GROUP_PROFILE );
@@ -635,6 +1109,7 @@ fma_desktop_file_has_profile( const FMADesktopFile *ndf, const gchar *profile_id
 {
 	gboolean has_profile;
 	gchar *group_name;
+	gchar **ig;
 
 	g_return_val_if_fail( FMA_IS_DESKTOP_FILE( ndf ), FALSE );
 	g_return_val_if_fail( profile_id && g_utf8_strlen( profile_id, -1 ), FALSE );
@@ -644,7 +1119,13 @@ fma_desktop_file_has_profile( const FMADesktopFile *ndf, const gchar *profile_id
 	if( !ndf->private->dispose_has_run ){
 
 		group_name = g_strdup_printf( "%s %s", FMA_DESKTOP_GROUP_PROFILE, profile_id );
-		has_profile = g_key_file_has_group( ndf->private->key_file, group_name );
+		if( ndf->private->groups ){
+			for( ig = ndf->private->groups ; *ig && !has_profile ; ig++ ){
+				has_profile = !strcmp( *ig, group_name );
+			}
+		} else {
+			has_profile = g_key_file_has_group( read_key_file( ndf ), group_name );
+		}
 		g_free( group_name );
 	}
 
@@ -678,14 +1159,14 @@ fma_desktop_file_remove_key( const FMADesktopFile *ndf, const gchar *group, cons
 
 	if( !ndf->private->dispose_has_run ){
 
-		g_key_file_remove_key( ndf->private->key_file, group, key, NULL );
+		g_key_file_remove_key( write_key_file( ndf ), group, key, NULL );
 
 		locales = ( char ** ) g_get_language_names();
 		iloc = locales;
 
 		while( *iloc ){
 			locale_key = g_strdup_printf( "%s[%s]", key, *iloc );
-			g_key_file_remove_key( ndf->private->key_file, group, locale_key, NULL );
+			g_key_file_remove_key( write_key_file( ndf ), group, locale_key, NULL );
 			g_free( locale_key );
 			iloc++;
 		}
@@ -709,7 +1190,7 @@ fma_desktop_file_remove_profile( const FMADesktopFile *ndf, const gchar *profile
 	if( !ndf->private->dispose_has_run ){
 
 		group_name = g_strdup_printf( "%s %s", FMA_DESKTOP_GROUP_PROFILE, profile_id );
-		g_key_file_remove_group( ndf->private->key_file, group_name, NULL );
+		g_key_file_remove_group( write_key_file( ndf ), group_name, NULL );
 		g_free( group_name );
 	}
 }
@@ -742,13 +1223,13 @@ fma_desktop_file_get_boolean( const FMADesktopFile *ndf, const gchar *group, con
 	if( !ndf->private->dispose_has_run ){
 
 		error = NULL;
-		has_entry = g_key_file_has_key( ndf->private->key_file, group, entry, &error );
+		has_entry = g_key_file_has_key( read_key_file( ndf ), group, entry, &error );
 		if( error ){
 			g_warning( "%s: %s", thisfn, error->message );
 			g_error_free( error );
 
 		} else if( has_entry ){
-			read_value = g_key_file_get_boolean( ndf->private->key_file, group, entry, &error );
+			read_value = g_key_file_get_boolean( read_key_file( ndf ), group, entry, &error );
 			if( error ){
 				g_warning( "%s: %s", thisfn, error->message );
 				g_error_free( error );
@@ -791,7 +1272,12 @@ fma_desktop_file_get_locale_string( const FMADesktopFile *ndf, const gchar *grou
 
 		error = NULL;
 
-		read_value = g_key_file_get_locale_string( ndf->private->key_file, group, entry, NULL, &error );
+		/* parsed entries have already been resolved against the locale */
+		if( ndf->private->key_file ){
+			read_value = g_key_file_get_locale_string( ndf->private->key_file, group, entry, NULL, &error );
+		} else {
+			read_value = g_key_file_get_string( read_key_file( ndf ), group, entry, &error );
+		}
 		if( !read_value || error ){
 			if( error->code != G_KEY_FILE_ERROR_KEY_NOT_FOUND ){
 				g_warning( "%s: %s", thisfn, error->message );
@@ -837,13 +1323,13 @@ fma_desktop_file_get_string( const FMADesktopFile *ndf, const gchar *group, cons
 	if( !ndf->private->dispose_has_run ){
 
 		error = NULL;
-		has_entry = g_key_file_has_key( ndf->private->key_file, group, entry, &error );
+		has_entry = g_key_file_has_key( read_key_file( ndf ), group, entry, &error );
 		if( error ){
 			g_warning( "%s: %s", thisfn, error->message );
 			g_error_free( error );
 
 		} else if( has_entry ){
-			read_value = g_key_file_get_string( ndf->private->key_file, group, entry, &error );
+			read_value = g_key_file_get_string( read_key_file( ndf ), group, entry, &error );
 			if( error ){
 				g_warning( "%s: %s", thisfn, error->message );
 				g_error_free( error );
@@ -888,13 +1374,13 @@ fma_desktop_file_get_string_list( const FMADesktopFile *ndf, const gchar *group,
 	if( !ndf->private->dispose_has_run ){
 
 		error = NULL;
-		has_entry = g_key_file_has_key( ndf->private->key_file, group, entry, &error );
+		has_entry = g_key_file_has_key( read_key_file( ndf ), group, entry, &error );
 		if( error ){
 			g_warning( "%s: %s", thisfn, error->message );
 			g_error_free( error );
 
 		} else if( has_entry ){
-			read_array = g_key_file_get_string_list( ndf->private->key_file, group, entry, NULL, &error );
+			read_array = g_key_file_get_string_list( read_key_file( ndf ), group, entry, NULL, &error );
 			if( error ){
 				g_warning( "%s: %s", thisfn, error->message );
 				g_error_free( error );
@@ -939,13 +1425,13 @@ fma_desktop_file_get_uint( const FMADesktopFile *ndf, const gchar *group, const
 	if( !ndf->private->dispose_has_run ){
 
 		error = NULL;
-		has_entry = g_key_file_has_key( ndf->private->key_file, group, entry, &error );
+		has_entry = g_key_file_has_key( read_key_file( ndf ), group, entry, &error );
 		if( error ){
 			g_warning( "%s: %s", thisfn, error->message );
 			g_error_free( error );
 
 		} else if( has_entry ){
-			value = ( guint ) g_key_file_get_integer( ndf->private->key_file, group, entry, &error );
+			value = ( guint ) g_key_file_get_integer( read_key_file( ndf ), group, entry, &error );
 			if( error ){
 				g_warning( "%s: %s", thisfn, error->message );
 				g_error_free( error );
@@ -975,7 +1461,7 @@ fma_desktop_file_set_boolean( const FMADesktopFile *ndf, const gchar *group, con
 
 	if( !ndf->private->dispose_has_run ){
 
-		g_key_file_set_boolean( ndf->private->key_file, group, key, value );
+		g_key_file_set_boolean( write_key_file( ndf ), group, key, value );
 	}
 }
 
@@ -1065,7 +1551,7 @@ fma_desktop_file_set_locale_string( const FMADesktopFile *ndf, const gchar *grou
 			}
 
 			if( write ){
-				g_key_file_set_locale_string( ndf->private->key_file, group, key, locales[i], value );
+				g_key_file_set_locale_string( write_key_file( ndf ), group, key, locales[i], value );
 			}
 		}
 
@@ -1089,7 +1575,7 @@ fma_desktop_file_set_string( const FMADesktopFile *ndf, const gchar *group, cons
 
 	if( !ndf->private->dispose_has_run ){
 
-		g_key_file_set_string( ndf->private->key_file, group, key, value );
+		g_key_file_set_string( write_key_file( ndf ), group, key, value );
 	}
 }
 
@@ -1112,7 +1598,7 @@ fma_desktop_file_set_string_list( const FMADesktopFile *ndf, const gchar *group,
 	if( !ndf->private->dispose_has_run ){
 
 		array = fma_core_utils_slist_to_array( value );
-		g_key_file_set_string_list( ndf->private->key_file, group, key, ( const gchar * const * ) array, g_slist_length( value ));
+		g_key_file_set_string_list( write_key_file( ndf ), group, key, ( const gchar * const * ) array, g_slist_length( value ));
 		g_strfreev( array );
 	}
 }
@@ -1133,7 +1619,7 @@ fma_desktop_file_set_uint( const FMADesktopFile *ndf, const gchar *group, const
 
 	if( !ndf->private->dispose_has_run ){
 
-		g_key_file_set_integer( ndf->private->key_file, group, key, value );
+		g_key_file_set_integer( write_key_file( ndf ), group, key, value );
 	}
 }
 
@@ -1148,72 +1634,342 @@ fma_desktop_file_set_uint( const FMADesktopFile *ndf, const gchar *group, const
  * Starting with v 3.0.4, locale strings whose identifier include an
  * encoding part are removed from the desktop file when rewriting it
  * (these were wrongly written between v 2.99 and 3.0.3).
+ *
+ * Starting with v 3.5, this is a batch of one file: the file is
+ * atomically replaced, and its directory is synced.
  */
 gboolean
 fma_desktop_file_write( FMADesktopFile *ndf )
 {
-	static const gchar *thisfn = "fma_desktop_file_write";
+	FMADesktopFileBatch *batch;
 	gboolean ret;
-	gchar *data;
-	GFile *file;
-	GFileOutputStream *stream;
-	GError *error;
+
+	g_return_val_if_fail( FMA_IS_DESKTOP_FILE( ndf ), FALSE );
+
+	batch = fma_desktop_file_batch_new();
+
+	if( fma_desktop_file_stage( ndf, batch )){
+		ret = fma_desktop_file_batch_commit( batch );
+	} else {
+		fma_desktop_file_batch_abort( batch );
+		ret = FALSE;
+	}
+
+	return( ret );
+}
+
+/**
+ * fma_desktop_file_stage:
+ * @ndf: the #FMADesktopFile instance.
+ * @batch: the #FMADesktopFileBatch the file is to be added to.
+ *
+ * Writes the key file to a temporary file in the same directory, which
+ * will replace the actual file when the @batch is committed. If the
+ * file was already staged in this @batch, the previous version is
+ * discarded.
+ *
+ * Files which are not local are immediately written.
+ *
+ * Returns: %TRUE if write is ok, %FALSE else.
+ *
+ * Since: 3.5
+ */
+gboolean
+fma_desktop_file_stage( FMADesktopFile *ndf, FMADesktopFileBatch *batch )
+{
+	static const gchar *thisfn = "fma_desktop_file_stage";
+	gboolean ret;
+	gchar *data, *path;
 	gsize length;
 
+	g_return_val_if_fail( FMA_IS_DESKTOP_FILE( ndf ), FALSE );
+	g_return_val_if_fail( batch, FALSE );
+
 	ret = FALSE;
-	error = NULL;
-	g_return_val_if_fail( FMA_IS_DESKTOP_FILE( ndf ), ret );
 
 	if( !ndf->private->dispose_has_run ){
 
-		if( ndf->private->key_file ){
-			remove_encoding_part( ndf );
-		}
+		remove_encoding_part( ndf );
 
-		data = g_key_file_to_data( ndf->private->key_file, &length, NULL );
-		file = g_file_new_for_uri( ndf->private->uri );
+		data = g_key_file_to_data( write_key_file( ndf ), &length, NULL );
+		path = g_filename_from_uri( ndf->private->uri, NULL, NULL );
 		g_debug( "%s: uri=%s", thisfn, ndf->private->uri );
 
-		stream = g_file_replace( file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, &error );
-		if( error ){
-			g_warning( "%s: g_file_replace: %s", thisfn, error->message );
-			g_error_free( error );
-			if( stream ){
-				g_object_unref( stream );
+		if( path ){
+			ret = stage_data( batch, path, data, length );
+		} else {
+			ret = write_with_gio( ndf, data, length );
+		}
+
+		/* a new version of the file supersedes its deletion */
+		if( ret ){
+			undelete_uri( batch, ndf->private->uri );
+		}
+
+		g_free( path );
+		g_free( data );
+	}
+
+	return( ret );
+}
+
+/**
+ * fma_desktop_file_batch_new:
+ *
+ * Returns: a new empty #FMADesktopFileBatch, which should be either
+ * committed with fma_desktop_file_batch_commit(), or aborted with
+ * fma_desktop_file_batch_abort().
+ *
+ * Since: 3.5
+ */
+FMADesktopFileBatch *
+fma_desktop_file_batch_new( void )
+{
+	return( g_new0( FMADesktopFileBatch, 1 ));
+}
+
+/**
+ * fma_desktop_file_batch_delete:
+ * @batch: a #FMADesktopFileBatch.
+ * @uri: the URI of a desktop file.
+ *
+ * Discards the file from the @batch if it has been staged, and schedules
+ * the deletion of the file on disk, if any, when the @batch is committed.
+ *
+ * Since: 3.5
+ */
+void
+fma_desktop_file_batch_delete( FMADesktopFileBatch *batch, const gchar *uri )
+{
+	gchar *path;
+
+	g_return_if_fail( batch );
+	g_return_if_fail( uri );
+
+	path = g_filename_from_uri( uri, NULL, NULL );
+	if( path ){
+		unstage_path( batch, path );
+		g_free( path );
+	}
+
+	if( fma_core_utils_file_exists( uri )){
+		undelete_uri( batch, uri );
+		batch->deleted = g_list_append( batch->deleted, g_strdup( uri ));
+	}
+}
+
+/**
+ * fma_desktop_file_batch_commit:
+ * @batch: a #FMADesktopFileBatch.
+ *
+ * Renames all the staged files to their final name, and syncs once
+ * each impacted directory. The files are registered with a new
+ * generation number, so that fma_desktop_file_is_own_write() is able
+ * to recognize them. The scheduled deletions are then done.
+ *
+ * The @batch is released on return.
+ *
+ * Returns: %TRUE if all files have been successfully renamed or
+ * deleted, %FALSE else.
+ *
+ * Since: 3.5
+ */
+gboolean
+fma_desktop_file_batch_commit( FMADesktopFileBatch *batch )
+{
+	static const gchar *thisfn = "fma_desktop_file_batch_commit";
+	gboolean ret;
+	guint generation;
+	GHashTable *dirs;
+	GList *it;
+	StagedFile *staged;
+	GHashTableIter iter;
+	gchar *dir;
+
+	g_return_val_if_fail( batch, FALSE );
+
+	ret = TRUE;
+
+	if( batch->staged ){
+
+		g_mutex_lock( &st_own_mutex );
+		generation = ++st_generation;
+		g_mutex_unlock( &st_own_mutex );
+
+		g_debug( "%s: batch=%p, files=%d, generation=%u",
+				thisfn, ( void * ) batch, g_list_length( batch->staged ), generation );
+
+		dirs = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+
+		for( it = batch->staged ; it ; it = it->next ){
+			staged = ( StagedFile * ) it->data;
+
+			/* record before renaming, so that the monitor never sees
+			 * the event before the record
+			 */
+			own_write_record( staged->path, generation, TRUE, FALSE );
+
+			/* the stamp is only recorded once the file has actually been
+			 * replaced; else the pending record is just forgotten
+			 */
+			if( g_rename( staged->tmp_path, staged->path ) < 0 ){
+				g_warning( "%s: %s: %s", thisfn, staged->path, g_strerror( errno ));
+				g_unlink( staged->tmp_path );
+				own_write_forget( staged->path, generation );
+				ret = FALSE;
+
+			} else {
+				g_hash_table_add( dirs, g_path_get_dirname( staged->path ));
+				own_write_record( staged->path, generation, FALSE, FALSE );
 			}
-			g_object_unref( file );
-			g_free( data );
-			return( FALSE );
 		}
 
-		g_output_stream_write( G_OUTPUT_STREAM( stream ), data, length, NULL, &error );
-		if( error ){
-			g_warning( "%s: g_output_stream_write: %s", thisfn, error->message );
-			g_error_free( error );
-			g_object_unref( stream );
-			g_object_unref( file );
-			g_free( data );
-			return( FALSE );
+		g_hash_table_iter_init( &iter, dirs );
+		while( g_hash_table_iter_next( &iter, ( gpointer * ) &dir, NULL )){
+			sync_dir( dir );
 		}
+		g_hash_table_destroy( dirs );
+	}
 
-		g_output_stream_close( G_OUTPUT_STREAM( stream ), NULL, &error );
-		if( error ){
-			g_warning( "%s: g_output_stream_close: %s", thisfn, error->message );
-			g_error_free( error );
-			g_object_unref( stream );
-			g_object_unref( file );
-			g_free( data );
-			return( FALSE );
+	for( it = batch->deleted ; it ; it = it->next ){
+		if( !fma_desktop_file_delete(( const gchar * ) it->data )){
+			g_warning( "%s: %s: unable to delete the file", thisfn, ( const gchar * ) it->data );
+			ret = FALSE;
 		}
+	}
 
-		g_object_unref( stream );
-		g_object_unref( file );
-		g_free( data );
+	for( it = batch->staged ; it ; it = it->next ){
+		staged_file_free(( StagedFile * ) it->data, FALSE );
+	}
+	g_list_free( batch->staged );
+	g_list_free_full( batch->deleted, ( GDestroyNotify ) g_free );
+	g_free( batch );
 
-		return( TRUE );
+	return( ret );
+}
+
+/**
+ * fma_desktop_file_batch_abort:
+ * @batch: a #FMADesktopFileBatch.
+ *
+ * Removes all the staged files, forgets the scheduled deletions, and
+ * releases the @batch.
+ *
+ * Since: 3.5
+ */
+void
+fma_desktop_file_batch_abort( FMADesktopFileBatch *batch )
+{
+	GList *it;
+
+	g_return_if_fail( batch );
+
+	for( it = batch->staged ; it ; it = it->next ){
+		staged_file_free(( StagedFile * ) it->data, TRUE );
 	}
+	g_list_free( batch->staged );
+	g_list_free_full( batch->deleted, ( GDestroyNotify ) g_free );
+	g_free( batch );
+}
 
-	return( FALSE );
+/**
+ * fma_desktop_file_delete:
+ * @uri: the URI of a desktop file.
+ *
+ * Deletes the file, recording the deletion so that
+ * fma_desktop_file_is_own_write() is able to recognize it.
+ *
+ * Returns: %TRUE if the file has been deleted, %FALSE else.
+ *
+ * Since: 3.5
+ */
+gboolean
+fma_desktop_file_delete( const gchar *uri )
+{
+	gboolean deleted;
+	gchar *path;
+	guint generation;
+
+	g_return_val_if_fail( uri, FALSE );
+
+	path = g_filename_from_uri( uri, NULL, NULL );
+
+	if( path ){
+		g_mutex_lock( &st_own_mutex );
+		generation = ++st_generation;
+		g_mutex_unlock( &st_own_mutex );
+		own_write_record( path, generation, FALSE, TRUE );
+	}
+
+	deleted = fma_desktop_utils_uri_delete( uri );
+
+	if( path && !deleted ){
+		own_write_forget( path, generation );
+	}
+
+	g_free( path );
+
+	return( deleted );
+}
+
+/**
+ * fma_desktop_file_is_own_write:
+ * @path: the path of a file.
+ * @generation: [out][allow-none]: set to the generation of the write.
+ *
+ * Returns: %TRUE if the current state of the file results from our own
+ * last write (resp. deletion), i.e. if its modification time and size
+ * are those we have recorded after having written it (resp. if it
+ * does not exist anymore), or if this is a staged file; %FALSE else.
+ *
+ * A recorded write which does not match the file anymore is forgotten.
+ *
+ * Since: 3.5
+ */
+gboolean
+fma_desktop_file_is_own_write( const gchar *path, guint *generation )
+{
+	gboolean own, exists;
+	gchar *bname;
+	OwnWrite *write;
+	gint64 mtime;
+	goffset size;
+
+	g_return_val_if_fail( path, FALSE );
+
+	bname = g_path_get_basename( path );
+	own = g_str_has_prefix( bname, STAGED_PREFIX );
+	g_free( bname );
+
+	if( generation ){
+		*generation = 0;
+	}
+
+	if( !own ){
+		exists = own_write_get_stamp( path, &mtime, &size );
+
+		g_mutex_lock( &st_own_mutex );
+		write = st_own_writes ? ( OwnWrite * ) g_hash_table_lookup( st_own_writes, path ) : NULL;
+		if( write ){
+			if( write->pending ){
+				own = TRUE;
+			} else if( write->deleted ){
+				own = !exists;
+			} else {
+				own = exists && write->mtime == mtime && write->size == size;
+			}
+			if( own ){
+				if( generation ){
+					*generation = write->generation;
+				}
+			} else {
+				g_hash_table_remove( st_own_writes, path );
+			}
+		}
+		g_mutex_unlock( &st_own_mutex );
+	}
+
+	return( own );
 }
 
 static void
@@ -1226,23 +1982,25 @@ remove_encoding_part( FMADesktopFile *ndf )
 	GRegex *regex;
 	GMatchInfo *info;
 	GError *error;
+	GKeyFile *key_file;
 
 	error = NULL;
+	key_file = write_key_file( ndf );
 	regex = g_regex_new( "\\[(.*)\\.(.*)\\]$", G_REGEX_CASELESS | G_REGEX_UNGREEDY, G_REGEX_MATCH_NOTEMPTY, &error );
 	if( error ){
 		g_warning( "%s: %s", thisfn, error->message );
 		g_error_free( error );
 
 	} else {
-		groups = g_key_file_get_groups( ndf->private->key_file, NULL );
+		groups = g_key_file_get_groups( key_file, NULL );
 
 		for( ig = 0 ; ig < g_strv_length( groups ) ; ++ig ){
-			keys = g_key_file_get_keys( ndf->private->key_file, groups[ig], NULL, NULL );
+			keys = g_key_file_get_keys( key_file, groups[ig], NULL, NULL );
 
 			for( ik = 0 ; ik < g_strv_length( keys ) ; ++ik ){
 
 				if( g_regex_match( regex, keys[ik], 0, &info )){
-					g_key_file_remove_key( ndf->private->key_file, groups[ig], keys[ik], &error );
+					g_key_file_remove_key( key_file, groups[ig], keys[ik], &error );
 					if( error ){
 						g_warning( "%s: %s", thisfn, error->message );
 						g_error_free( error );
@@ -1260,3 +2018,247 @@ remove_encoding_part( FMADesktopFile *ndf )
 		g_regex_unref( regex );
 	}
 }
+
+/*
+ * this was the only way of writing a desktop file before v 3.5; it is
+ * kept for the files which are not local
+ */
+static gboolean
+write_with_gio( FMADesktopFile *ndf, const gchar *data, gsize length )
+{
+	static const gchar *thisfn = "fma_desktop_file_write_with_gio";
+	gboolean ret;
+	GFile *file;
+	GFileOutputStream *stream;
+	GError *error;
+
+	ret = FALSE;
+	error = NULL;
+	file = g_file_new_for_uri( ndf->private->uri );
+
+	stream = g_file_replace( file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, &error );
+	if( error ){
+		g_warning( "%s: g_file_replace: %s", thisfn, error->message );
+		g_error_free( error );
+
+	} else {
+		g_output_stream_write( G_OUTPUT_STREAM( stream ), data, length, NULL, &error );
+		if( error ){
+			g_warning( "%s: g_output_stream_write: %s", thisfn, error->message );
+			g_error_free( error );
+
+		} else {
+			g_output_stream_close( G_OUTPUT_STREAM( stream ), NULL, &error );
+			if( error ){
+				g_warning( "%s: g_output_stream_close: %s", thisfn, error->message );
+				g_error_free( error );
+			} else {
+				ret = TRUE;
+			}
+		}
+	}
+
+	if( stream ){
+		g_object_unref( stream );
+	}
+	g_object_unref( file );
+
+	return( ret );
+}
+
+/*
+ * the data is written and synced to a temporary file in the target
+ * directory, so that the rename at commit time is atomic
+ * the permissions of an existing file are kept
+ */
+static gboolean
+stage_data( FMADesktopFileBatch *batch, const gchar *path, const gchar *data, gsize length )
+{
+	static const gchar *thisfn = "fma_desktop_file_stage_data";
+	gchar *dir, *tmp_path;
+	gsize written;
+	gssize count;
+	GStatBuf st;
+	StagedFile *staged;
+	int fd;
+
+	dir = g_path_get_dirname( path );
+	tmp_path = g_build_filename( dir, STAGED_TEMPLATE, NULL );
+	g_free( dir );
+
+	fd = g_mkstemp_full( tmp_path, O_RDWR, 0666 );
+	if( fd < 0 ){
+		g_warning( "%s: %s: %s", thisfn, tmp_path, g_strerror( errno ));
+		g_free( tmp_path );
+		return( FALSE );
+	}
+
+	if( g_stat( path, &st ) == 0 ){
+		fchmod( fd, st.st_mode & 07777 );
+	}
+
+	for( written = 0 ; written < length ; written += count ){
+		count = write( fd, data+written, length-written );
+		if( count < 0 ){
+			if( errno == EINTR ){
+				count = 0;
+				continue;
+			}
+			g_warning( "%s: %s: %s", thisfn, tmp_path, g_strerror( errno ));
+			break;
+		}
+	}
+
+	if( written < length || fsync( fd ) < 0 ){
+		if( written == length ){
+			g_warning( "%s: %s: %s", thisfn, tmp_path, g_strerror( errno ));
+		}
+		close( fd );
+		g_unlink( tmp_path );
+		g_free( tmp_path );
+		return( FALSE );
+	}
+
+	close( fd );
+
+	unstage_path( batch, path );
+
+	staged = g_new0( StagedFile, 1 );
+	staged->path = g_strdup( path );
+	staged->tmp_path = tmp_path;
+	batch->staged = g_list_append( batch->staged, staged );
+
+	return( TRUE );
+}
+
+static gboolean
+unstage_path( FMADesktopFileBatch *batch, const gchar *path )
+{
+	GList *it;
+	StagedFile *staged;
+
+	for( it = batch->staged ; it ; it = it->next ){
+		staged = ( StagedFile * ) it->data;
+		if( !strcmp( staged->path, path )){
+			batch->staged = g_list_delete_link( batch->staged, it );
+			staged_file_free( staged, TRUE );
+			return( TRUE );
+		}
+	}
+
+	return( FALSE );
+}
+
+static void
+undelete_uri( FMADesktopFileBatch *batch, const gchar *uri )
+{
+	GList *it;
+
+	for( it = batch->deleted ; it ; it = it->next ){
+		if( !strcmp(( const gchar * ) it->data, uri )){
+			g_free( it->data );
+			batch->deleted = g_list_delete_link( batch->deleted, it );
+			return;
+		}
+	}
+}
+
+static void
+staged_file_free( StagedFile *staged, gboolean unlink )
+{
+	if( unlink ){
+		g_unlink( staged->tmp_path );
+	}
+	g_free( staged->tmp_path );
+	g_free( staged->path );
+	g_free( staged );
+}
+
+static void
+own_write_record( const gchar *path, guint generation, gboolean pending, gboolean deleted )
+{
+	OwnWrite *write;
+
+	write = g_new0( OwnWrite, 1 );
+	write->generation = generation;
+	write->pending = pending;
+	write->deleted = deleted;
+
+	if( !pending && !deleted && !own_write_get_stamp( path, &write->mtime, &write->size )){
+		write->deleted = TRUE;
+	}
+
+	g_mutex_lock( &st_own_mutex );
+
+	if( !st_own_writes ){
+		st_own_writes = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, g_free );
+	}
+
+	g_hash_table_insert( st_own_writes, g_strdup( path ), write );
+
+	g_mutex_unlock( &st_own_mutex );
+}
+
+/*
+ * forgets the record of a write of the given generation, which has not
+ * been done
+ */
+static void
+own_write_forget( const gchar *path, guint generation )
+{
+	OwnWrite *write;
+
+	g_mutex_lock( &st_own_mutex );
+
+	if( st_own_writes ){
+		write = ( OwnWrite * ) g_hash_table_lookup( st_own_writes, path );
+		if( write && write->generation == generation ){
+			g_hash_table_remove( st_own_writes, path );
+		}
+	}
+
+	g_mutex_unlock( &st_own_mutex );
+}
+
+static gboolean
+own_write_get_stamp( const gchar *path, gint64 *mtime, goffset *size )
+{
+	GFile *file;
+	GFileInfo *info;
+
+	file = g_file_new_for_path( path );
+	info = g_file_query_info( file,
+			G_FILE_ATTRIBUTE_TIME_MODIFIED "," G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC "," G_FILE_ATTRIBUTE_STANDARD_SIZE,
+			G_FILE_QUERY_INFO_NONE, NULL, NULL );
+	g_object_unref( file );
+
+	if( !info ){
+		return( FALSE );
+	}
+
+	*mtime = g_file_info_get_attribute_uint64( info, G_FILE_ATTRIBUTE_TIME_MODIFIED ) * G_USEC_PER_SEC +
+			g_file_info_get_attribute_uint32( info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC );
+	*size = g_file_info_get_size( info );
+	g_object_unref( info );
+
+	return( TRUE );
+}
+
+static void
+sync_dir( const gchar *dir )
+{
+	static const gchar *thisfn = "fma_desktop_file_sync_dir";
+	int fd;
+
+	fd = g_open( dir, O_RDONLY | O_DIRECTORY, 0 );
+
+	if( fd < 0 ){
+		g_warning( "%s: %s: %s", thisfn, dir, g_strerror( errno ));
+
+	} else {
+		if( fsync( fd ) < 0 ){
+			g_warning( "%s: %s: %s", thisfn, dir, g_strerror( errno ));
+		}
+		close( fd );
+	}
+}
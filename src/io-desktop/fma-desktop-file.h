@@ -60,6 +60,8 @@ typedef struct {
 }
 	FMADesktopFile;
 
+typedef struct _FMADesktopFileBatch          FMADesktopFileBatch;
+
 typedef struct _FMADesktopFileClassPrivate   FMADesktopFileClassPrivate;
 
 typedef struct {
@@ -83,6 +85,15 @@ FMADesktopFile *fma_desktop_file_new_for_write    ( const gchar *path );
 GKeyFile       *fma_desktop_file_get_key_file     ( const FMADesktopFile *ndf );
 gchar          *fma_desktop_file_get_key_file_uri ( const FMADesktopFile *ndf );
 gboolean        fma_desktop_file_write            ( FMADesktopFile *ndf );
+gboolean        fma_desktop_file_stage            ( FMADesktopFile *ndf, FMADesktopFileBatch *batch );
+
+FMADesktopFileBatch *fma_desktop_file_batch_new    ( void );
+void            fma_desktop_file_batch_delete     ( FMADesktopFileBatch *batch, const gchar *uri );
+gboolean        fma_desktop_file_batch_commit     ( FMADesktopFileBatch *batch );
+void            fma_desktop_file_batch_abort      ( FMADesktopFileBatch *batch );
+
+gboolean        fma_desktop_file_delete           ( const gchar *uri );
+gboolean        fma_desktop_file_is_own_write     ( const gchar *path, guint *generation );
 
 gchar          *fma_desktop_file_get_file_type    ( const FMADesktopFile *ndf );
 gchar          *fma_desktop_file_get_id           ( const FMADesktopFile *ndf );
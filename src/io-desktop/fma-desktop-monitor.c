@@ -33,6 +33,7 @@
 
 #include <gio/gio.h>
 
+#include "fma-desktop-file.h"
 #include "fma-desktop-monitor.h"
 
 /* private class data
@@ -246,5 +247,22 @@ fma_desktop_monitor_new( const FMADesktopProvider *provider, const gchar *path )
 static void
 on_monitor_changed( GFileMonitor *monitor, GFile *file, GFile *other_file, GFileMonitorEvent event_type, FMADesktopMonitor *my_monitor )
 {
-	fma_desktop_provider_on_monitor_event( my_monitor->private->provider );
+	static const gchar *thisfn = "fma_desktop_monitor_on_monitor_changed";
+	gchar *path;
+	guint generation;
+	gboolean own;
+
+	/* ignore the events triggered by our own writes
+	 */
+	path = g_file_get_path( file );
+	own = path && fma_desktop_file_is_own_write( path, &generation );
+
+	if( own ){
+		g_debug( "%s: ignoring event=%d on %s (generation=%u)", thisfn, event_type, path, generation );
+
+	} else {
+		fma_desktop_provider_on_monitor_event( my_monitor->private->provider );
+	}
+
+	g_free( path );
 }
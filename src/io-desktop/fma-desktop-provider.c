@@ -50,9 +50,18 @@ struct _FMADesktopProviderClassPrivate {
 	void *empty;						/* so that gcc -pedantic is happy */
 };
 
+/* the directories to be monitored, as found by a read in any thread
+ */
+typedef struct {
+	FMADesktopProvider *provider;
+	GSList             *dirs;
+}
+	MonitorsReset;
+
 static GType         st_module_type = 0;
 static GObjectClass *st_parent_class = NULL;
 static guint         st_burst_timeout = 100;		/* burst timeout in msec */
+static guint         st_burst_max_wait = 1000;		/* max burst duration in msec */
 
 static void   class_init( FMADesktopProviderClass *klass );
 static void   instance_init( GTypeInstance *instance, gpointer klass );
@@ -63,6 +72,7 @@ static void   iio_provider_iface_init( FMAIIOProviderInterface *iface );
 static gchar *iio_provider_get_id( const FMAIIOProvider *provider );
 static gchar *iio_provider_get_name( const FMAIIOProvider *provider );
 static guint  iio_provider_get_version( const FMAIIOProvider *provider );
+static gboolean iio_provider_read_items_is_thread_safe( const FMAIIOProvider *provider );
 
 static void   ifactory_provider_iface_init( FMAIFactoryProviderInterface *iface );
 static guint  ifactory_provider_get_version( const FMAIFactoryProvider *reader );
@@ -77,6 +87,8 @@ static void  *iexporter_get_formats( const FMAIExporter *exporter );
 static void   iexporter_free_formats( const FMAIExporter *exporter, GList *format_list );
 
 static void   on_monitor_timeout( FMADesktopProvider *provider );
+static gboolean set_monitors_cb( MonitorsReset *reset );
+static void   set_monitors_free( MonitorsReset *reset );
 
 GType
 fma_desktop_provider_get_type( void )
@@ -173,9 +185,9 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private->dispose_has_run = FALSE;
 	self->private->monitors = NULL;
 	self->private->timeout.timeout = st_burst_timeout;
+	fma_timeout_set_max_wait( &self->private->timeout, st_burst_max_wait );
 	self->private->timeout.handler = ( FMATimeoutFunc ) on_monitor_timeout;
 	self->private->timeout.user_data = self;
-	self->private->timeout.source_id = 0;
 }
 
 static void
@@ -195,6 +207,12 @@ instance_dispose( GObject *object )
 		self->private->dispose_has_run = TRUE;
 
 		fma_desktop_provider_release_monitors( self );
+		fma_timeout_cancel( &self->private->timeout );
+
+		if( self->private->batch ){
+			fma_desktop_file_batch_abort( self->private->batch );
+			self->private->batch = NULL;
+		}
 
 		/* chain up to the parent class */
 		if( G_OBJECT_CLASS( st_parent_class )->dispose ){
@@ -239,12 +257,27 @@ iio_provider_iface_init( FMAIIOProviderInterface *iface )
 	iface->write_item = fma_desktop_writer_iio_provider_write_item;
 	iface->delete_item = fma_desktop_writer_iio_provider_delete_item;
 	iface->duplicate_data = fma_desktop_writer_iio_provider_duplicate_data;
+	iface->write_items_start = fma_desktop_writer_iio_provider_write_items_start;
+	iface->write_items_done = fma_desktop_writer_iio_provider_write_items_done;
+	iface->write_items_abort = fma_desktop_writer_iio_provider_write_items_abort;
+	iface->read_item = fma_desktop_reader_iio_provider_read_item;
+	iface->read_items_is_thread_safe = iio_provider_read_items_is_thread_safe;
 }
 
 static guint
 iio_provider_get_version( const FMAIIOProvider *provider )
 {
-	return( 1 );
+	return( 4 );
+}
+
+/*
+ * the desktop files cache and the own writes records are protected by
+ * their mutex, and the monitors are replaced in the main context
+ */
+static gboolean
+iio_provider_read_items_is_thread_safe( const FMAIIOProvider *provider )
+{
+	return( TRUE );
 }
 
 static gchar *
@@ -311,6 +344,7 @@ iexporter_iface_init( FMAIExporterInterface *iface )
 	iface->free_formats = iexporter_free_formats;
 	iface->to_file = fma_desktop_writer_iexporter_export_to_file;
 	iface->to_buffer = fma_desktop_writer_iexporter_export_to_buffer;
+	iface->to_stream = fma_desktop_writer_iexporter_export_to_stream;
 }
 
 static guint
@@ -394,6 +428,59 @@ fma_desktop_provider_release_monitors( FMADesktopProvider *provider )
 	}
 }
 
+/**
+ * fma_desktop_provider_set_monitors:
+ * @provider: this #FMADesktopProvider object.
+ * @dirs: a list of the paths to the directories to be monitored;
+ *  this function takes ownership of the list.
+ *
+ * Replaces the current desktop monitors with new ones on @dirs.
+ *
+ * As the monitors are attached to the main context, while the items
+ * may be read in a worker thread, the replacement is invoked in the
+ * main context: it happens immediately when called from the thread
+ * which owns it, or as soon as this thread gets back to the main loop.
+ */
+void
+fma_desktop_provider_set_monitors( FMADesktopProvider *provider, GSList *dirs )
+{
+	MonitorsReset *reset;
+
+	g_return_if_fail( FMA_IS_DESKTOP_PROVIDER( provider ));
+
+	reset = g_new0( MonitorsReset, 1 );
+	reset->provider = g_object_ref( provider );
+	reset->dirs = dirs;
+
+	g_main_context_invoke_full( NULL, G_PRIORITY_DEFAULT,
+			( GSourceFunc ) set_monitors_cb, reset, ( GDestroyNotify ) set_monitors_free );
+}
+
+static gboolean
+set_monitors_cb( MonitorsReset *reset )
+{
+	GSList *it;
+
+	if( !reset->provider->private->dispose_has_run ){
+
+		fma_desktop_provider_release_monitors( reset->provider );
+
+		for( it = reset->dirs ; it ; it = it->next ){
+			fma_desktop_provider_add_monitor( reset->provider, ( const gchar * ) it->data );
+		}
+	}
+
+	return( FALSE );
+}
+
+static void
+set_monitors_free( MonitorsReset *reset )
+{
+	fma_core_utils_slist_free( reset->dirs );
+	g_object_unref( reset->provider );
+	g_free( reset );
+}
+
 static void
 on_monitor_timeout( FMADesktopProvider *provider )
 {
@@ -63,6 +63,7 @@ typedef struct _FMADesktopProviderPrivate {
 	gboolean   dispose_has_run;
 	GList     *monitors;
 	FMATimeout timeout;
+	FMADesktopFileBatch *batch;			/* while writing a set of items */
 }
 	FMADesktopProviderPrivate;
 
@@ -93,6 +94,7 @@ void  fma_desktop_provider_register_type   ( GTypeModule *module );
 void  fma_desktop_provider_add_monitor     ( FMADesktopProvider *provider, const gchar *dir );
 void  fma_desktop_provider_on_monitor_event( FMADesktopProvider *provider );
 void  fma_desktop_provider_release_monitors( FMADesktopProvider *provider );
+void  fma_desktop_provider_set_monitors    ( FMADesktopProvider *provider, GSList *dirs );
 
 G_END_DECLS
 
@@ -63,7 +63,7 @@ typedef struct {
 
 #define ERR_NOT_DESKTOP		_( "The Desktop I/O Provider is not able to handle the URI" )
 
-static GList             *get_list_of_desktop_paths( FMADesktopProvider *provider, GSList **mesages );
+static GList             *get_list_of_desktop_paths( FMADesktopProvider *provider, GSList **dirs, GSList **mesages );
 static void               get_list_of_desktop_files( const FMADesktopProvider *provider, GList **files, const gchar *dir, GSList **messages );
 static gboolean           is_already_loaded( const FMADesktopProvider *provider, GList *files, const gchar *desktop_id );
 static GList             *desktop_path_from_id( const FMADesktopProvider *provider, GList *files, const gchar *dir, const gchar *id );
@@ -82,6 +82,9 @@ static void               read_done_action_load_profile( const FMAIFactoryProvid
 /*
  * Returns an unordered list of FMAIFactoryObject-derived objects
  *
+ * This may be run in a worker thread: the monitors of the scanned
+ * directories are only replaced in the main context.
+ *
  * This is implementation of FMAIIOProvider::read_items method
  */
 GList *
@@ -90,6 +93,7 @@ fma_desktop_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSLi
 	static const gchar *thisfn = "fma_desktop_reader_iio_provider_read_items";
 	GList *items;
 	GList *desktop_paths, *ip;
+	GSList *dirs;
 	FMAIFactoryObject *item;
 
 	g_debug( "%s: provider=%p (%s), messages=%p",
@@ -98,9 +102,11 @@ fma_desktop_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSLi
 	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider ), NULL );
 
 	items = NULL;
-	fma_desktop_provider_release_monitors( FMA_DESKTOP_PROVIDER( provider ));
+	dirs = NULL;
+
+	desktop_paths = get_list_of_desktop_paths( FMA_DESKTOP_PROVIDER( provider ), &dirs, messages );
+	fma_desktop_provider_set_monitors( FMA_DESKTOP_PROVIDER( provider ), dirs );
 
-	desktop_paths = get_list_of_desktop_paths( FMA_DESKTOP_PROVIDER( provider ), messages );
 	for( ip = desktop_paths ; ip ; ip = ip->next ){
 
 		item = item_from_desktop_path( FMA_DESKTOP_PROVIDER( provider ), ( sDesktopPath * ) ip->data, messages );
@@ -117,6 +123,57 @@ fma_desktop_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSLi
 	return( items );
 }
 
+/*
+ * Returns the FMAObjectItem-derived object identified by @id, or NULL
+ *
+ * Rather than scanning the directories, we just check for the
+ * <id>.desktop file in each candidate directory, in the same order of
+ * preference than get_list_of_desktop_paths(); no monitor is installed.
+ *
+ * This is implementation of FMAIIOProvider::read_item method
+ */
+FMAObjectItem *
+fma_desktop_reader_iio_provider_read_item( const FMAIIOProvider *provider, const gchar *id, GSList **messages )
+{
+	static const gchar *thisfn = "fma_desktop_reader_iio_provider_read_item";
+	FMAIFactoryObject *item;
+	GSList *xdg_dirs, *idir;
+	GSList *subdirs, *isub;
+	sDesktopPath dps;
+	gchar *bname;
+
+	g_debug( "%s: provider=%p (%s), id=%s, messages=%p",
+			thisfn, ( void * ) provider, G_OBJECT_TYPE_NAME( provider ), id, ( void * ) messages );
+
+	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider ), NULL );
+
+	item = NULL;
+	xdg_dirs = fma_desktop_xdg_dirs_get_data_dirs();
+	subdirs = fma_core_utils_slist_from_split( FMA_DESKTOP_PROVIDER_SUBDIRS, G_SEARCHPATH_SEPARATOR_S );
+	bname = g_strdup_printf( "%s%s", id, FMA_DESKTOP_FILE_SUFFIX );
+	dps.id = ( gchar * ) id;
+
+	for( idir = xdg_dirs ; idir && !item ; idir = idir->next ){
+		for( isub = subdirs ; isub && !item ; isub = isub->next ){
+
+			dps.path = g_build_filename(( gchar * ) idir->data, ( gchar * ) isub->data, bname, NULL );
+
+			if( g_file_test( dps.path, G_FILE_TEST_IS_REGULAR )){
+				g_debug( "%s: found %s", thisfn, dps.path );
+				item = item_from_desktop_path( FMA_DESKTOP_PROVIDER( provider ), &dps, messages );
+			}
+
+			g_free( dps.path );
+		}
+	}
+
+	g_free( bname );
+	fma_core_utils_slist_free( subdirs );
+	fma_core_utils_slist_free( xdg_dirs );
+
+	return( item ? FMA_OBJECT_ITEM( item ) : NULL );
+}
+
 /*
  * returns a list of sDesktopPath items
  *
@@ -125,10 +182,11 @@ fma_desktop_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSLi
  *  .desktop files in the resulted built path
  *
  * the returned list is so a list of sDesktopPath struct, in
- * the ordered of preference (most preferred first)
+ * the ordered of preference (most preferred first); the explored
+ * directories are prepended to @dirs
  */
 static GList *
-get_list_of_desktop_paths( FMADesktopProvider *provider, GSList **messages )
+get_list_of_desktop_paths( FMADesktopProvider *provider, GSList **dirs, GSList **messages )
 {
 	GList *files;
 	GSList *xdg_dirs, *idir;
@@ -148,9 +206,8 @@ get_list_of_desktop_paths( FMADesktopProvider *provider, GSList **messages )
 		for( isub = subdirs ; isub ; isub = isub->next ){
 
 			dir = g_build_filename(( gchar * ) idir->data, ( gchar * ) isub->data, NULL );
-			fma_desktop_provider_add_monitor( provider, dir );
 			get_list_of_desktop_files( provider, &files, dir, messages );
-			g_free( dir );
+			*dirs = g_slist_prepend( *dirs, dir );
 		}
 	}
 
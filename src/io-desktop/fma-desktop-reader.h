@@ -36,13 +36,14 @@
 
 G_BEGIN_DECLS
 
-GList        *fma_desktop_reader_iio_provider_read_items     ( const FMAIIOProvider *provider, GSList **messages );
+GList         *fma_desktop_reader_iio_provider_read_items     ( const FMAIIOProvider *provider, GSList **messages );
+FMAObjectItem *fma_desktop_reader_iio_provider_read_item      ( const FMAIIOProvider *provider, const gchar *id, GSList **messages );
 
-guint         fma_desktop_reader_iimporter_import_from_uri   ( const FMAIImporter *instance, void *parms_ptr );
+guint          fma_desktop_reader_iimporter_import_from_uri   ( const FMAIImporter *instance, void *parms_ptr );
 
-void          fma_desktop_reader_ifactory_provider_read_start( const FMAIFactoryProvider *reader, void *reader_data, const FMAIFactoryObject *serializable, GSList **messages );
-FMADataBoxed *fma_desktop_reader_ifactory_provider_read_data ( const FMAIFactoryProvider *reader, void *reader_data, const FMAIFactoryObject *serializable, const FMADataDef *iddef, GSList **messages );
-void          fma_desktop_reader_ifactory_provider_read_done ( const FMAIFactoryProvider *reader, void *reader_data, const FMAIFactoryObject *serializable, GSList **messages );
+void           fma_desktop_reader_ifactory_provider_read_start( const FMAIFactoryProvider *reader, void *reader_data, const FMAIFactoryObject *serializable, GSList **messages );
+FMADataBoxed  *fma_desktop_reader_ifactory_provider_read_data ( const FMAIFactoryProvider *reader, void *reader_data, const FMAIFactoryObject *serializable, const FMADataDef *iddef, GSList **messages );
+void           fma_desktop_reader_ifactory_provider_read_done ( const FMAIFactoryProvider *reader, void *reader_data, const FMAIFactoryObject *serializable, GSList **messages );
 
 G_END_DECLS
 
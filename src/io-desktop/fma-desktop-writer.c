@@ -239,7 +239,12 @@ write_item( const FMAIIOProvider *provider, const FMAObjectItem *item, FMADeskto
 
 	fma_ifactory_provider_write_item( FMA_IFACTORY_PROVIDER( provider ), ndf, FMA_IFACTORY_OBJECT( item ), messages );
 
-	if( !fma_desktop_file_write( ndf )){
+	if( self->private->batch ){
+		if( !fma_desktop_file_stage( ndf, self->private->batch )){
+			ret = IIO_PROVIDER_CODE_WRITE_ERROR;
+		}
+
+	} else if( !fma_desktop_file_write( ndf )){
 		ret = IIO_PROVIDER_CODE_WRITE_ERROR;
 	}
 
@@ -278,7 +283,14 @@ fma_desktop_writer_iio_provider_delete_item( const FMAIIOProvider *provider, con
 	if( ndf ){
 		g_return_val_if_fail( FMA_IS_DESKTOP_FILE( ndf ), ret );
 		uri = fma_desktop_file_get_key_file_uri( ndf );
-		if( fma_desktop_utils_uri_delete( uri )){
+
+		/* inside of a batch, the file is only deleted on commit
+		 */
+		if( self->private->batch ){
+			fma_desktop_file_batch_delete( self->private->batch, uri );
+			ret = IIO_PROVIDER_CODE_OK;
+
+		} else if( fma_desktop_file_delete( uri )){
 			ret = IIO_PROVIDER_CODE_OK;
 		}
 		g_free( uri );
@@ -344,6 +356,89 @@ fma_desktop_writer_iio_provider_duplicate_data( const FMAIIOProvider *provider,
 	return( IIO_PROVIDER_CODE_OK );
 }
 
+/*
+ * Implementation of FMAIIOProvider::write_items_start
+ * All items written or deleted until write_items_done (resp.
+ * write_items_abort) are staged in a same batch.
+ */
+guint
+fma_desktop_writer_iio_provider_write_items_start( const FMAIIOProvider *provider, GSList **messages )
+{
+	static const gchar *thisfn = "fma_desktop_writer_iio_provider_write_items_start";
+	FMADesktopProvider *self;
+
+	g_debug( "%s: provider=%p (%s), messages=%p",
+			thisfn, ( void * ) provider, G_OBJECT_TYPE_NAME( provider ), ( void * ) messages );
+
+	g_return_val_if_fail( FMA_IS_DESKTOP_PROVIDER( provider ), IIO_PROVIDER_CODE_PROGRAM_ERROR );
+
+	self = FMA_DESKTOP_PROVIDER( provider );
+
+	if( self->private->dispose_has_run ){
+		return( IIO_PROVIDER_CODE_NOT_WILLING_TO_RUN );
+	}
+
+	g_return_val_if_fail( !self->private->batch, IIO_PROVIDER_CODE_PROGRAM_ERROR );
+
+	self->private->batch = fma_desktop_file_batch_new();
+
+	return( IIO_PROVIDER_CODE_OK );
+}
+
+/*
+ * Implementation of FMAIIOProvider::write_items_done
+ * Atomically renames the staged files, syncing each directory once.
+ */
+guint
+fma_desktop_writer_iio_provider_write_items_done( const FMAIIOProvider *provider, GSList **messages )
+{
+	static const gchar *thisfn = "fma_desktop_writer_iio_provider_write_items_done";
+	FMADesktopProvider *self;
+	guint ret;
+
+	g_debug( "%s: provider=%p (%s), messages=%p",
+			thisfn, ( void * ) provider, G_OBJECT_TYPE_NAME( provider ), ( void * ) messages );
+
+	g_return_val_if_fail( FMA_IS_DESKTOP_PROVIDER( provider ), IIO_PROVIDER_CODE_PROGRAM_ERROR );
+
+	self = FMA_DESKTOP_PROVIDER( provider );
+	ret = IIO_PROVIDER_CODE_OK;
+
+	if( self->private->batch ){
+		if( !fma_desktop_file_batch_commit( self->private->batch )){
+			ret = IIO_PROVIDER_CODE_WRITE_ERROR;
+		}
+		self->private->batch = NULL;
+	}
+
+	return( ret );
+}
+
+/*
+ * Implementation of FMAIIOProvider::write_items_abort
+ * Discards the staged files and the pending deletions.
+ */
+guint
+fma_desktop_writer_iio_provider_write_items_abort( const FMAIIOProvider *provider, GSList **messages )
+{
+	static const gchar *thisfn = "fma_desktop_writer_iio_provider_write_items_abort";
+	FMADesktopProvider *self;
+
+	g_debug( "%s: provider=%p (%s), messages=%p",
+			thisfn, ( void * ) provider, G_OBJECT_TYPE_NAME( provider ), ( void * ) messages );
+
+	g_return_val_if_fail( FMA_IS_DESKTOP_PROVIDER( provider ), IIO_PROVIDER_CODE_PROGRAM_ERROR );
+
+	self = FMA_DESKTOP_PROVIDER( provider );
+
+	if( self->private->batch ){
+		fma_desktop_file_batch_abort( self->private->batch );
+		self->private->batch = NULL;
+	}
+
+	return( IIO_PROVIDER_CODE_OK );
+}
+
 /**
  * fma_desktop_writer_iexporter_export_to_buffer:
  * @instance: this #FMAIExporter instance.
@@ -472,6 +567,75 @@ fma_desktop_writer_iexporter_export_to_file( const FMAIExporter *instance, FMAIE
 	return( code );
 }
 
+/**
+ * fma_desktop_writer_iexporter_export_to_stream:
+ * @instance: this #FMAIExporter instance.
+ * @parms: a #FMAIExporterStreamParmsv2 structure.
+ *
+ * Export the specified 'item' to the output stream.
+ *
+ * A .desktop file only describes one item: a bundle of several items
+ * is refused as it could not be imported back.
+ */
+guint
+fma_desktop_writer_iexporter_export_to_stream( const FMAIExporter *instance, FMAIExporterStreamParmsv2 *parms )
+{
+	static const gchar *thisfn = "fma_desktop_writer_iexporter_export_to_stream";
+	guint code, write_code;
+	ExportFormatFn *fmt;
+	GKeyFile *key_file;
+	FMADesktopFile *ndf;
+	gchar *data;
+	gsize length;
+	GError *error;
+
+	g_debug( "%s: instance=%p, parms=%p", thisfn, ( void * ) instance, ( void * ) parms );
+
+	code = FMA_IEXPORTER_CODE_OK;
+
+	if( !parms->exported || !FMA_IS_OBJECT_ITEM( parms->exported )){
+		code = FMA_IEXPORTER_CODE_INVALID_ITEM;
+
+	} else if( !G_IS_OUTPUT_STREAM( parms->stream ) || !parms->first || !parms->last ){
+		code = FMA_IEXPORTER_CODE_INVALID_TARGET;
+	}
+
+	if( code == FMA_IEXPORTER_CODE_OK ){
+		fmt = find_export_format_fn( parms->format );
+
+		if( !fmt ){
+			code = FMA_IEXPORTER_CODE_INVALID_FORMAT;
+
+		} else {
+			ndf = fma_desktop_file_new();
+			write_code = fma_ifactory_provider_write_item( FMA_IFACTORY_PROVIDER( instance ), ndf, FMA_IFACTORY_OBJECT( parms->exported ), &parms->messages );
+
+			if( write_code != IIO_PROVIDER_CODE_OK ){
+				code = FMA_IEXPORTER_CODE_ERROR;
+
+			} else {
+				key_file = fma_desktop_file_get_key_file( ndf );
+				data = g_key_file_to_data( key_file, &length, NULL );
+				error = NULL;
+
+				if( !g_output_stream_write_all( parms->stream, data, length, NULL, NULL, &error )){
+					g_warning( "%s: %s", thisfn, error->message );
+					parms->messages = g_slist_append( parms->messages, g_strdup( error->message ));
+					g_error_free( error );
+					code = FMA_IEXPORTER_CODE_UNABLE_TO_WRITE;
+				}
+
+				g_free( data );
+			}
+
+			g_object_unref( ndf );
+		}
+	}
+
+	g_debug( "%s: returning code=%u", thisfn, code );
+	return( code );
+}
+
 guint
 fma_desktop_writer_ifactory_provider_write_start( const FMAIFactoryProvider *provider, void *writer_data,
 							const FMAIFactoryObject *object, GSList **messages  )
@@ -49,11 +49,19 @@ guint    fma_desktop_writer_iio_provider_duplicate_data     ( const FMAIIOProvid
 																	FMAObjectItem *dest,
 																	const FMAObjectItem *source,
 																	GSList **messages );
+guint    fma_desktop_writer_iio_provider_write_items_start  ( const FMAIIOProvider *provider,
+																	GSList **messages );
+guint    fma_desktop_writer_iio_provider_write_items_done   ( const FMAIIOProvider *provider,
+																	GSList **messages );
+guint    fma_desktop_writer_iio_provider_write_items_abort  ( const FMAIIOProvider *provider,
+																	GSList **messages );
 
 guint    fma_desktop_writer_iexporter_export_to_buffer      ( const FMAIExporter *instance,
 																	FMAIExporterBufferParmsv2 *parms );
 guint    fma_desktop_writer_iexporter_export_to_file        ( const FMAIExporter *instance,
 																	FMAIExporterFileParmsv2 *parms );
+guint    fma_desktop_writer_iexporter_export_to_stream      ( const FMAIExporter *instance,
+																	FMAIExporterStreamParmsv2 *parms );
 
 guint    fma_desktop_writer_ifactory_provider_write_start   ( const FMAIFactoryProvider *provider,
 																	void *writer_data,
@@ -223,6 +223,7 @@ iio_provider_iface_init( FMAIIOProviderInterface *iface )
 	iface->get_name = iio_provider_get_name;
 	iface->get_version = iio_provider_get_version;
 	iface->read_items = fma_gconf_reader_iio_provider_read_items;
+	iface->read_item = fma_gconf_reader_iio_provider_read_item;
 	iface->is_willing_to_write = fma_gconf_writer_iio_provider_is_willing_to_write;
 	iface->is_able_to_write = fma_gconf_writer_iio_provider_is_able_to_write;
 #ifdef FMA_ENABLE_DEPRECATED
@@ -250,7 +251,7 @@ iio_provider_get_name( const FMAIIOProvider *provider )
 static guint
 iio_provider_get_version( const FMAIIOProvider *provider )
 {
-	return( 1 );
+	return( 3 );
 }
 
 static void
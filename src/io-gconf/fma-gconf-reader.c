@@ -45,14 +45,29 @@
 #include "fma-gconf-keys.h"
 #include "fma-gconf-reader.h"
 
+/* the content of a GConf directory, as prefetched by fetch_tree()
+ */
+typedef struct {
+	GSList        *entries;			/* list of GConfEntry */
+	GHashTable    *by_key;			/* entry basename -> GConfEntry, borrowed from entries */
+	GSList        *subdirs;			/* list of full paths */
+}
+	ReaderDir;
+
 typedef struct {
 	gchar         *path;
-	GSList        *entries;
+	GHashTable    *tree;
+	ReaderDir     *dir;
 	FMAObjectItem *parent;
 }
 	ReaderData;
 
-static FMAObjectItem *read_item( FMAGConfProvider *provider, const gchar *path, GSList **messages );
+static GHashTable    *fetch_tree( FMAGConfProvider *provider, const gchar *path );
+static void           fetch_tree_rec( FMAGConfProvider *provider, GHashTable *tree, const gchar *path );
+static void           free_reader_dir( ReaderDir *dir );
+static GConfValue    *get_value( const ReaderDir *dir, const gchar *entry );
+
+static FMAObjectItem *read_item( FMAGConfProvider *provider, GHashTable *tree, const gchar *path, GSList **messages );
 
 static void           read_start_profile_attach_profile( const FMAIFactoryProvider *provider, FMAObjectProfile *profile, ReaderData *data, GSList **messages );
 
@@ -76,7 +91,9 @@ fma_gconf_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSList
 	static const gchar *thisfn = "fma_gconf_reader_iio_provider_read_items";
 	FMAGConfProvider *self;
 	GList *items_list = NULL;
-	GSList *listpath, *ip;
+	GHashTable *tree;
+	ReaderDir *root;
+	GSList *ip;
 	FMAObjectItem *item;
 
 	g_debug( "%s: provider=%p, messages=%p", thisfn, ( void * ) provider, ( void * ) messages );
@@ -87,34 +104,144 @@ fma_gconf_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSList
 
 	if( !self->private->dispose_has_run ){
 
-		listpath = fma_gconf_utils_get_subdirs( self->private->gconf, FMA_GCONF_CONFIGURATIONS_PATH );
+		tree = fetch_tree( self, FMA_GCONF_CONFIGURATIONS_PATH );
+		root = ( ReaderDir * ) g_hash_table_lookup( tree, FMA_GCONF_CONFIGURATIONS_PATH );
 
-		for( ip = listpath ; ip ; ip = ip->next ){
+		for( ip = root ? root->subdirs : NULL ; ip ; ip = ip->next ){
 
-			item = read_item( self, ( const gchar * ) ip->data, messages );
+			item = read_item( self, tree, ( const gchar * ) ip->data, messages );
 			if( item ){
 				items_list = g_list_prepend( items_list, item );
 				fma_object_dump( item );
 			}
 		}
 
-		fma_gconf_utils_free_subdirs( listpath );
+		g_hash_table_destroy( tree );
 	}
 
 	g_debug( "%s: count=%d", thisfn, g_list_length( items_list ));
 	return( items_list );
 }
 
+/*
+ * fma_gconf_reader_iio_provider_read_item:
+ *
+ * Only reads the subdirectory of the configurations path which is
+ * named after @id.
+ */
+FMAObjectItem *
+fma_gconf_reader_iio_provider_read_item( const FMAIIOProvider *provider, const gchar *id, GSList **messages )
+{
+	static const gchar *thisfn = "fma_gconf_reader_iio_provider_read_item";
+	FMAGConfProvider *self;
+	FMAObjectItem *item;
+	GHashTable *tree;
+	gchar *path;
+
+	g_debug( "%s: provider=%p, id=%s, messages=%p", thisfn, ( void * ) provider, id, ( void * ) messages );
+
+	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider ), NULL );
+	g_return_val_if_fail( FMA_IS_GCONF_PROVIDER( provider ), NULL );
+	self = FMA_GCONF_PROVIDER( provider );
+
+	item = NULL;
+
+	if( !self->private->dispose_has_run ){
+
+		path = gconf_concat_dir_and_key( FMA_GCONF_CONFIGURATIONS_PATH, id );
+
+		if( gconf_client_dir_exists( self->private->gconf, path, NULL )){
+			tree = fetch_tree( self, path );
+			item = read_item( self, tree, path, messages );
+			if( item ){
+				fma_object_dump( item );
+			}
+			g_hash_table_destroy( tree );
+		}
+
+		g_free( path );
+	}
+
+	return( item );
+}
+
+/*
+ * Fetches the entries and the subdirectories of the whole tree which
+ * starts at @path, so that the items are then decoded from memory
+ * instead of requesting gconfd for each and every value.
+ *
+ * Returns a hash table of ReaderDir, indexed by full path.
+ */
+static GHashTable *
+fetch_tree( FMAGConfProvider *provider, const gchar *path )
+{
+	GHashTable *tree;
+
+	tree = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) free_reader_dir );
+	fetch_tree_rec( provider, tree, path );
+
+	return( tree );
+}
+
+static void
+fetch_tree_rec( FMAGConfProvider *provider, GHashTable *tree, const gchar *path )
+{
+	ReaderDir *dir;
+	GSList *ie, *is;
+	const gchar *key, *bname;
+
+	dir = g_new0( ReaderDir, 1 );
+	dir->entries = fma_gconf_utils_get_entries( provider->private->gconf, path );
+	dir->subdirs = fma_gconf_utils_get_subdirs( provider->private->gconf, path );
+	dir->by_key = g_hash_table_new( g_str_hash, g_str_equal );
+
+	for( ie = dir->entries ; ie ; ie = ie->next ){
+		key = gconf_entry_get_key(( GConfEntry * ) ie->data );
+		bname = strrchr( key, '/' );
+		g_hash_table_insert( dir->by_key, ( gpointer )( bname ? bname+1 : key ), ie->data );
+	}
+
+	g_hash_table_insert( tree, g_strdup( path ), dir );
+
+	for( is = dir->subdirs ; is ; is = is->next ){
+		fetch_tree_rec( provider, tree, ( const gchar * ) is->data );
+	}
+}
+
+static void
+free_reader_dir( ReaderDir *dir )
+{
+	g_hash_table_destroy( dir->by_key );
+	fma_gconf_utils_free_entries( dir->entries );
+	fma_gconf_utils_free_subdirs( dir->subdirs );
+	g_free( dir );
+}
+
+/*
+ * Returns the value of the entry, or NULL if the entry doesn't exist
+ * in the directory or has no value
+ */
+static GConfValue *
+get_value( const ReaderDir *dir, const gchar *entry )
+{
+	GConfEntry *gconf_entry;
+
+	gconf_entry = dir ? ( GConfEntry * ) g_hash_table_lookup( dir->by_key, entry ) : NULL;
+
+	return( gconf_entry ? gconf_entry_get_value( gconf_entry ) : NULL );
+}
+
 /*
  * path is here the full path to an item
  */
 static FMAObjectItem *
-read_item( FMAGConfProvider *provider, const gchar *path, GSList **messages )
+read_item( FMAGConfProvider *provider, GHashTable *tree, const gchar *path, GSList **messages )
 {
 	static const gchar *thisfn = "fma_gconf_reader_read_item";
 	FMAObjectItem *item;
-	gchar *full_path;
-	gchar *type;
+	ReaderDir *dir;
+	GConfValue *value;
+	const gchar *type;
 	gchar *id;
 	ReaderData *data;
 
@@ -123,9 +250,9 @@ read_item( FMAGConfProvider *provider, const gchar *path, GSList **messages )
 	g_return_val_if_fail( FMA_IS_IIO_PROVIDER( provider ), NULL );
 	g_return_val_if_fail( !provider->private->dispose_has_run, NULL );
 
-	full_path = gconf_concat_dir_and_key( path, FMA_GCONF_ENTRY_TYPE );
-	type = fma_gconf_utils_read_string( provider->private->gconf, full_path, TRUE, FMA_GCONF_VALUE_TYPE_ACTION );
-	g_free( full_path );
+	dir = ( ReaderDir * ) g_hash_table_lookup( tree, path );
+	value = get_value( dir, FMA_GCONF_ENTRY_TYPE );
+	type = value && value->type == GCONF_VALUE_STRING ? gconf_value_get_string( value ) : NULL;
 	item = NULL;
 
 	/* an item may have 'Action' or 'Menu' type; defaults to Action
@@ -140,8 +267,6 @@ read_item( FMAGConfProvider *provider, const gchar *path, GSList **messages )
 		g_warning( "%s: unknown type '%s' at %s", thisfn, type, path );
 	}
 
-	g_free( type );
-
 	if( item ){
 		id = g_path_get_basename( path );
 		fma_object_set_id( item, id );
@@ -149,8 +274,9 @@ read_item( FMAGConfProvider *provider, const gchar *path, GSList **messages )
 
 		data = g_new0( ReaderData, 1 );
 		data->path = ( gchar * ) path;
-		data->entries = fma_gconf_utils_get_entries( provider->private->gconf, path );
-		fma_gconf_utils_dump_entries( data->entries );
+		data->tree = tree;
+		data->dir = dir;
+		fma_gconf_utils_dump_entries( dir ? dir->entries : NULL );
 
 		fma_ifactory_provider_read_item(
 				FMA_IFACTORY_PROVIDER( provider ),
@@ -158,7 +284,6 @@ read_item( FMAGConfProvider *provider, const gchar *path, GSList **messages )
 				FMA_IFACTORY_OBJECT( item ),
 				messages );
 
-		fma_gconf_utils_free_entries( data->entries );
 		g_free( data );
 	}
 
@@ -265,7 +390,7 @@ read_done_item_is_writable( const FMAIFactoryProvider *provider, FMAObjectItem *
 	 * item is writable if and only if all entries are themselves writable
 	 */
 	writable = TRUE;
-	for( ie = data->entries ; ie && writable ; ie = ie->next ){
+	for( ie = data->dir ? data->dir->entries : NULL ; ie && writable ; ie = ie->next ){
 		gconf_entry = ( GConfEntry * ) ie->data;
 		key = gconf_entry_get_key( gconf_entry );
 		writable = is_key_writable( FMA_GCONF_PROVIDER( provider ), key );
@@ -289,7 +414,7 @@ read_done_action_read_profiles( const FMAIFactoryProvider *provider, FMAObjectAc
 
 	data->parent = FMA_OBJECT_ITEM( action );
 	order = fma_object_get_items_slist( action );
-	list_profiles = fma_gconf_utils_get_subdirs( FMA_GCONF_PROVIDER( provider )->private->gconf, data->path );
+	list_profiles = data->dir ? data->dir->subdirs : NULL;
 
 	/* read profiles in the specified order
 	 * as a protection against bugs in fma-config-tool, we check that
@@ -343,7 +468,8 @@ read_done_action_load_profile( const FMAIFactoryProvider *provider, ReaderData *
 	profile_data = g_new0( ReaderData, 1 );
 	profile_data->parent = data->parent;
 	profile_data->path = ( gchar * ) path;
-	profile_data->entries = fma_gconf_utils_get_entries( FMA_GCONF_PROVIDER( provider )->private->gconf, path );
+	profile_data->tree = data->tree;
+	profile_data->dir = ( ReaderDir * ) g_hash_table_lookup( data->tree, path );
 
 	fma_ifactory_provider_read_item(
 			FMA_IFACTORY_PROVIDER( provider ),
@@ -351,58 +477,113 @@ read_done_action_load_profile( const FMAIFactoryProvider *provider, ReaderData *
 			FMA_IFACTORY_OBJECT( profile ),
 			messages );
 
-	fma_gconf_utils_free_entries( profile_data->entries );
 	g_free( profile_data );
 }
 
+/*
+ * values are decoded from the prefetched entries; we only go back to
+ * gconfd when an existing entry has no value, so that its default value
+ * is read from the schema
+ */
 static FMADataBoxed *
 get_boxed_from_path( const FMAGConfProvider *provider, const gchar *path, ReaderData *reader_data, const FMADataDef *def )
 {
 	static const gchar *thisfn = "fma_gconf_reader_get_boxed_from_path";
 	FMADataBoxed *boxed;
 	gboolean have_entry;
+	GConfValue *value;
+	GConfValueType type;
+	gchar *entry_path;
 	gchar *str_value;
 	gboolean bool_value;
-	GSList *slist_value;
+	GSList *slist_value, *iv;
 	gint int_value;
 
 	boxed = NULL;
-	have_entry = fma_gconf_utils_has_entry( reader_data->entries, def->gconf_entry );
+	have_entry = reader_data->dir && g_hash_table_lookup( reader_data->dir->by_key, def->gconf_entry );
 	g_debug( "%s: entry=%s, have_entry=%s", thisfn, def->gconf_entry, have_entry ? "True":"False" );
 
 	if( have_entry ){
-		gchar *entry_path = gconf_concat_dir_and_key( path, def->gconf_entry );
+		value = get_value( reader_data->dir, def->gconf_entry );
+		entry_path = gconf_concat_dir_and_key( path, def->gconf_entry );
 		boxed = fma_data_boxed_new( def );
 
 		switch( def->type ){
 
 			case FMA_DATA_TYPE_STRING:
 			case FMA_DATA_TYPE_LOCALE_STRING:
-				str_value = fma_gconf_utils_read_string( provider->private->gconf, entry_path, TRUE, NULL );
+				type = GCONF_VALUE_STRING;
+				break;
+
+			case FMA_DATA_TYPE_BOOLEAN:
+				type = GCONF_VALUE_BOOL;
+				break;
+
+			case FMA_DATA_TYPE_STRING_LIST:
+				type = GCONF_VALUE_LIST;
+				break;
+
+			case FMA_DATA_TYPE_UINT:
+				type = GCONF_VALUE_INT;
+				break;
+
+			default:
+				g_warning( "%s: unknown type=%u for %s", thisfn, def->type, def->name );
+				g_free( boxed );
+				g_free( entry_path );
+				return( NULL );
+		}
+
+		if( value && value->type != type ){
+			g_warning( "%s: path=%s, found type '%u' while waiting for type '%u'", thisfn, entry_path, value->type, type );
+		}
+
+		switch( def->type ){
+
+			case FMA_DATA_TYPE_STRING:
+			case FMA_DATA_TYPE_LOCALE_STRING:
+				if( value ){
+					str_value = value->type == type ? g_strdup( gconf_value_get_string( value )) : NULL;
+				} else {
+					str_value = fma_gconf_utils_read_string( provider->private->gconf, entry_path, TRUE, NULL );
+				}
 				fma_boxed_set_from_string( FMA_BOXED( boxed ), str_value );
 				g_free( str_value );
 				break;
 
 			case FMA_DATA_TYPE_BOOLEAN:
-				bool_value = fma_gconf_utils_read_bool( provider->private->gconf, entry_path, TRUE, FALSE );
+				if( value ){
+					bool_value = value->type == type ? gconf_value_get_bool( value ) : FALSE;
+				} else {
+					bool_value = fma_gconf_utils_read_bool( provider->private->gconf, entry_path, TRUE, FALSE );
+				}
 				fma_boxed_set_from_void( FMA_BOXED( boxed ), GUINT_TO_POINTER( bool_value ));
 				break;
 
 			case FMA_DATA_TYPE_STRING_LIST:
-				slist_value = fma_gconf_utils_read_string_list( provider->private->gconf, entry_path );
+				slist_value = NULL;
+				if( value ){
+					if( value->type == type && gconf_value_get_list_type( value ) == GCONF_VALUE_STRING ){
+						for( iv = gconf_value_get_list( value ) ; iv ; iv = iv->next ){
+							slist_value = g_slist_prepend( slist_value, g_strdup( gconf_value_get_string(( GConfValue * ) iv->data )));
+						}
+						slist_value = g_slist_reverse( slist_value );
+					}
+				} else {
+					slist_value = fma_gconf_utils_read_string_list( provider->private->gconf, entry_path );
+				}
 				fma_boxed_set_from_void( FMA_BOXED( boxed ), slist_value );
 				fma_core_utils_slist_free( slist_value );
 				break;
 
 			case FMA_DATA_TYPE_UINT:
-				int_value = fma_gconf_utils_read_int( provider->private->gconf, entry_path, TRUE, 0 );
+				if( value ){
+					int_value = value->type == type ? gconf_value_get_int( value ) : 0;
+				} else {
+					int_value = fma_gconf_utils_read_int( provider->private->gconf, entry_path, TRUE, 0 );
+				}
 				fma_boxed_set_from_void( FMA_BOXED( boxed ), GUINT_TO_POINTER( int_value ));
 				break;
-
-			default:
-				g_warning( "%s: unknown type=%u for %s", thisfn, def->type, def->name );
-				g_free( boxed );
-				boxed = NULL;
 		}
 
 		g_free( entry_path );
@@ -35,11 +35,12 @@
 
 G_BEGIN_DECLS
 
-GList        *fma_gconf_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSList **messages );
+GList         *fma_gconf_reader_iio_provider_read_items( const FMAIIOProvider *provider, GSList **messages );
+FMAObjectItem *fma_gconf_reader_iio_provider_read_item ( const FMAIIOProvider *provider, const gchar *id, GSList **messages );
 
-void          fma_gconf_reader_read_start( const FMAIFactoryProvider *provider, void *reader_data, const FMAIFactoryObject *object, GSList **messages  );
-FMADataBoxed *fma_gconf_reader_read_data ( const FMAIFactoryProvider *provider, void *reader_data, const FMAIFactoryObject *object, const FMADataDef *def, GSList **messages );
-void          fma_gconf_reader_read_done ( const FMAIFactoryProvider *provider, void *reader_data, const FMAIFactoryObject *object, GSList **messages  );
+void           fma_gconf_reader_read_start( const FMAIFactoryProvider *provider, void *reader_data, const FMAIFactoryObject *object, GSList **messages  );
+FMADataBoxed  *fma_gconf_reader_read_data ( const FMAIFactoryProvider *provider, void *reader_data, const FMAIFactoryObject *object, const FMADataDef *def, GSList **messages );
+void           fma_gconf_reader_read_done ( const FMAIFactoryProvider *provider, void *reader_data, const FMAIFactoryObject *object, GSList **messages  );
 
 G_END_DECLS
 
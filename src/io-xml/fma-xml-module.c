@@ -31,6 +31,8 @@
 #include <config.h>
 #endif
 
+#include <libxml/parser.h>
+
 #include <api/fma-extension.h>
 
 #include "fma-xml-provider.h"
@@ -54,6 +56,11 @@ fma_extension_startup( GTypeModule *module )
 
 	g_debug( "%s: module=%p", thisfn, ( void * ) module );
 
+	/* make sure libxml2 global state is initialized from the main
+	 * thread, as the writer may be later called from export workers
+	 */
+	xmlInitParser();
+
 	fma_xml_provider_register_type( module );
 
 	return( TRUE );
@@ -109,4 +116,6 @@ fma_extension_shutdown( void )
 	static const gchar *thisfn = "fma_xml_module_fma_extension_shutdown";
 
 	g_debug( "%s", thisfn );
+
+	xmlCleanupParser();
 }
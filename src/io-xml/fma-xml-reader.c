@@ -87,6 +87,8 @@ struct _FMAXMLReaderPrivate {
 	GList                           *dealt;
 	RootNodeStr                     *root_node_str;
 	gchar                           *item_id;
+	const gchar * const             *languages;		/* the locale fallback chain */
+	guint                            n_languages;
 
 	/* following values are reset and reused while iterating on each
 	 * element nodes of the imported item (cf. reset_node_data())
@@ -171,6 +173,8 @@ static gchar        *build_key_node_list( FMAXMLKeyStr *strlist );
 static gchar        *build_root_node_list( void );
 static gchar        *get_value_from_child_node( xmlNode *node, const gchar *child );
 static gchar        *get_value_from_child_child_node( xmlNode *node, const gchar *first, const gchar *second );
+static gchar        *get_value_from_locale_node( FMAXMLReader *reader, xmlNode *node, const gchar *child );
+static guint         locale_rank( FMAXMLReader *reader, xmlNode *locale_node );
 static gboolean      is_profile_path( FMAXMLReader *reader, xmlChar *text );
 static void          reset_node_data( FMAXMLReader *reader );
 static xmlNode      *search_for_child_node( xmlNode *node, const gchar *key );
@@ -341,6 +345,8 @@ fma_xml_reader_import_from_uri( const FMAIImporter *instance, void *parms_ptr )
 	reader = reader_new();
 	reader->private->importer = ( FMAIImporter * ) instance;
 	reader->private->parms = parms;
+	reader->private->languages = g_get_language_names();
+	reader->private->n_languages = g_strv_length(( gchar ** ) reader->private->languages );
 
 	code = reader_parse_xmldoc( reader );
 
@@ -423,11 +429,16 @@ reader_parse_xmldoc( FMAXMLReader *reader )
  * no more return a 'unwilling to' code, but an error one.
  *
  * Check that:
- * - must have one child on the named 'first_child' key (others are warned)
+ * - must have at least one child on the named 'first_child' key
  * - then iter on child nodes of this previous first named which must be
  * 'next_child'
- * e.g. for a <gconfentryfile> root node, we must have one and only one
+ * e.g. for a <gconfentryfile> root node, we must have at least one
  * <entrylist> child.
+ *
+ * Each 'list' child describes one item: a bundle, as written by
+ * fma_xml_writer_export_to_stream(), has several of them. When the
+ * caller is not able to receive the bundled items, only the first list
+ * is imported, and the others are warned.
  */
 static guint
 iter_on_root_children( FMAXMLReader *reader, xmlNode *root )
@@ -436,6 +447,8 @@ iter_on_root_children( FMAXMLReader *reader, xmlNode *root )
 	xmlNodePtr iter;
 	gboolean found;
 	guint code;
+	FMAObjectItem *first;
+	GList *bundled;
 
 	g_debug( "%s: reader=%p, root=%p", thisfn, ( void * ) reader, ( void * ) root );
 
@@ -448,9 +461,12 @@ iter_on_root_children( FMAXMLReader *reader, xmlNode *root )
 	}
 
 	/* iter through the first level of children (list)
-	 * we must have only one occurrence of this first 'list' child
+	 * each occurrence of this first 'list' child is an item
 	 */
 	found = FALSE;
+	first = NULL;
+	bundled = NULL;
+
 	for( iter = root->children ; iter && code == IMPORTER_CODE_OK ; iter = iter->next ){
 
 		if( iter->type != XML_ELEMENT_NODE ){
@@ -465,14 +481,44 @@ iter_on_root_children( FMAXMLReader *reader, xmlNode *root )
 		}
 
 		if( found ){
-			fma_core_utils_slist_add_message( &reader->private->parms->messages, ERR_NODE_ALREADY_FOUND, ( const char * ) iter->name, iter->line );
-			continue;
+			if( reader->private->parms->content < 2 ){
+				fma_core_utils_slist_add_message( &reader->private->parms->messages, ERR_NODE_ALREADY_FOUND, ( const char * ) iter->name, iter->line );
+				continue;
+			}
+
+			/* set the previous item aside, and restart with a clean state
+			 */
+			if( first ){
+				bundled = g_list_prepend( bundled, reader->private->parms->imported );
+			} else {
+				first = reader->private->parms->imported;
+			}
+			reader->private->parms->imported = NULL;
+			reader->private->type_found = FALSE;
+			g_free( reader->private->item_id );
+			reader->private->item_id = NULL;
+			g_list_free( reader->private->nodes );
+			reader->private->nodes = NULL;
+			g_list_free( reader->private->dealt );
+			reader->private->dealt = NULL;
 		}
 
 		found = TRUE;
 		code = iter_on_list_children( reader, iter );
 	}
 
+	if( first ){
+		if( code == IMPORTER_CODE_OK ){
+			bundled = g_list_prepend( bundled, reader->private->parms->imported );
+			reader->private->parms->imported = first;
+			reader->private->parms->bundled = g_list_reverse( bundled );
+
+		} else {
+			g_list_free_full( bundled, ( GDestroyNotify ) g_object_unref );
+			g_object_unref( first );
+		}
+	}
+
 	return( code );
 }
 
@@ -1089,7 +1135,7 @@ schema_read_value( FMAXMLReader *reader, xmlNode *node, const FMADataDef *def )
 	gchar *value;
 
 	if( def->localizable ){
-		value = get_value_from_child_child_node( node, FMA_XML_KEY_SCHEMA_NODE_LOCALE, FMA_XML_KEY_SCHEMA_NODE_LOCALE_DEFAULT );
+		value = get_value_from_locale_node( reader, node, FMA_XML_KEY_SCHEMA_NODE_LOCALE_DEFAULT );
 	} else {
 		value = get_value_from_child_node( node, FMA_XML_KEY_SCHEMA_NODE_DEFAULT );
 	}
@@ -1372,6 +1418,74 @@ get_value_from_child_child_node( xmlNode *node, const gchar *first, const gchar
 	return( value );
 }
 
+/*
+ * A schema may hold a <locale> node for each translation: the value
+ * is read from the one which best fits the fallback chain computed
+ * when the import started, all locales being examined in a single pass.
+ * The first <locale> node is used when none fits, as was the case
+ * before.
+ */
+static gchar *
+get_value_from_locale_node( FMAXMLReader *reader, xmlNode *node, const gchar *child )
+{
+	gchar *value;
+	xmlNode *iter, *best_node, *value_node;
+	xmlChar *value_value;
+	guint rank, best_rank;
+
+	value = NULL;
+	best_node = NULL;
+	best_rank = G_MAXUINT;
+
+	for( iter = node->children ; iter && best_rank ; iter = iter->next ){
+		if( iter->type == XML_ELEMENT_NODE && !strxcmp( iter->name, FMA_XML_KEY_SCHEMA_NODE_LOCALE )){
+			rank = locale_rank( reader, iter );
+			if( !best_node || rank < best_rank ){
+				best_node = iter;
+				best_rank = rank;
+			}
+		}
+	}
+
+	if( best_node ){
+		value_node = search_for_child_node( best_node, child );
+		if( value_node ){
+			value_value = xmlNodeGetContent( value_node );
+			if( value_value ){
+				value = g_strdup(( const char * ) value_value );
+				xmlFree( value_value );
+			}
+		}
+	}
+
+	return( value );
+}
+
+/*
+ * Returns: the rank of the 'name' attribute of the <locale> node among
+ * the languages, a node without name being the C locale, or G_MAXUINT
+ * if the locale is not a current one.
+ */
+static guint
+locale_rank( FMAXMLReader *reader, xmlNode *locale_node )
+{
+	xmlChar *name;
+	guint i, rank;
+
+	name = xmlGetProp( locale_node, BAD_CAST( "name" ));
+	rank = G_MAXUINT;
+
+	for( i = 0 ; i < reader->private->n_languages && rank == G_MAXUINT ; ++i ){
+		if( !xmlStrcmp( name ? name : BAD_CAST( "C" ), BAD_CAST( reader->private->languages[i] ))){
+			rank = i;
+		}
+	}
+
+	xmlFree( name );
+
+	return( rank );
+}
+
 static gboolean
 is_profile_path( FMAXMLReader *reader, xmlChar *text )
 {
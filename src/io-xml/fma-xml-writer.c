@@ -124,6 +124,8 @@ static ExportFormatFn *find_export_format_fn_from_quark( GQuark format );
 static gchar          *get_output_fname( const FMAObjectItem *item, const gchar *folder, const gchar *format );
 static void            output_xml_to_file( const gchar *xml, const gchar *filename, GSList **msg );
 static guint           writer_to_buffer( FMAXMLWriter *writer );
+static guint           writer_to_stream( FMAXMLWriter *writer, GOutputStream *stream, gboolean first, gboolean last );
+static gboolean        output_to_stream( FMAXMLWriter *writer, GOutputStream *stream, const gchar *data, gsize length );
 
 static ExportFormatFn st_export_format_fn[] = {
 
@@ -391,6 +393,64 @@ fma_xml_writer_export_to_file( const FMAIExporter *instance, FMAIExporterFilePar
 	return( code );
 }
 
+/**
+ * fma_xml_writer_export_to_stream:
+ * @instance: this #FMAIExporter instance.
+ * @parms: a #FMAIExporterStreamParmsv2 structure.
+ *
+ * Incrementally writes the specified 'item' to the output stream.
+ *
+ * Only the list node of the item is serialized here, so that several
+ * items may be bundled into a single XML document: the document
+ * prologue and root node are written with the first item, and the
+ * root node is closed after the last one.
+ *
+ * Each item so keeps its own list node, which is what
+ * fma_xml_reader_import_from_uri() expects when importing a bundle.
+ */
+guint
+fma_xml_writer_export_to_stream( const FMAIExporter *instance, FMAIExporterStreamParmsv2 *parms )
+{
+	static const gchar *thisfn = "fma_xml_writer_export_to_stream";
+	FMAXMLWriter *writer;
+	guint code;
+
+	g_debug( "%s: instance=%p, parms=%p", thisfn, ( void * ) instance, ( void * ) parms );
+
+	code = FMA_IEXPORTER_CODE_OK;
+
+	if( !parms->exported || !FMA_IS_OBJECT_ITEM( parms->exported )){
+		code = FMA_IEXPORTER_CODE_INVALID_ITEM;
+	}
+
+	if( code == FMA_IEXPORTER_CODE_OK && !G_IS_OUTPUT_STREAM( parms->stream )){
+		code = FMA_IEXPORTER_CODE_INVALID_TARGET;
+	}
+
+	if( code == FMA_IEXPORTER_CODE_OK ){
+		writer = FMA_XML_WRITER( g_object_new( FMA_XML_WRITER_TYPE, NULL ));
+
+		writer->private->provider = ( FMAIExporter * ) instance;
+		writer->private->exported = parms->exported;
+		writer->private->messages = parms->messages;
+		writer->private->fn_str = find_export_format_fn( parms->format );
+		writer->private->buffer = NULL;
+
+		if( !writer->private->fn_str ){
+			code = FMA_IEXPORTER_CODE_INVALID_FORMAT;
+
+		} else {
+			code = writer_to_stream( writer, parms->stream, parms->first, parms->last );
+			parms->messages = writer->private->messages;
+		}
+
+		g_object_unref( writer );
+	}
+
+	g_debug( "%s: returning code=%u", thisfn, code );
+	return( code );
+}
+
 static xmlDocPtr
 build_xml_doc( FMAXMLWriter *writer )
 {
@@ -961,7 +1021,78 @@ writer_to_buffer( FMAXMLWriter *writer )
 
 	xmlFree( text );
 	xmlFreeDoc (doc);
-	xmlCleanupParser();
 
 	return( code );
 }
+
+/*
+ * the xmlDoc only ever holds the current item: its list node is dumped
+ * as a fragment of the root node which is itself written by hand
+ */
+static guint
+writer_to_stream( FMAXMLWriter *writer, GOutputStream *stream, gboolean first, gboolean last )
+{
+	guint code;
+	xmlDocPtr doc;
+	xmlBufferPtr buf;
+	gchar *str;
+	gboolean ok;
+
+	code = FMA_IEXPORTER_CODE_OK;
+	ok = TRUE;
+
+	if( first ){
+		str = g_strdup_printf( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<%s>\n", writer->private->fn_str->root_node );
+		ok = output_to_stream( writer, stream, str, strlen( str ));
+		g_free( str );
+	}
+
+	if( ok ){
+		doc = build_xml_doc( writer );
+		buf = xmlBufferCreate();
+
+		if( xmlNodeDump( buf, doc, writer->private->list_node, 1, 1 ) < 0 ){
+			code = FMA_IEXPORTER_CODE_ERROR;
+
+		} else {
+			ok = output_to_stream( writer, stream, "  ", 2 ) &&
+					output_to_stream( writer, stream, ( const gchar * ) xmlBufferContent( buf ), xmlBufferLength( buf )) &&
+					output_to_stream( writer, stream, "\n", 1 );
+		}
+
+		xmlBufferFree( buf );
+		xmlFreeDoc( doc );
+	}
+
+	if( ok && code == FMA_IEXPORTER_CODE_OK && last ){
+		str = g_strdup_printf( "</%s>\n", writer->private->fn_str->root_node );
+		ok = output_to_stream( writer, stream, str, strlen( str ));
+		g_free( str );
+	}
+
+	if( !ok ){
+		code = FMA_IEXPORTER_CODE_UNABLE_TO_WRITE;
+	}
+
+	return( code );
+}
+
+static gboolean
+output_to_stream( FMAXMLWriter *writer, GOutputStream *stream, const gchar *data, gsize length )
+{
+	static const gchar *thisfn = "fma_xml_writer_output_to_stream";
+	GError *error;
+	gchar *errmsg;
+
+	error = NULL;
+
+	if( !g_output_stream_write_all( stream, data, length, NULL, NULL, &error )){
+		errmsg = g_strdup_printf( "%s: g_output_stream_write_all: %s", thisfn, error->message );
+		g_warning( "%s", errmsg );
+		writer->private->messages = g_slist_append( writer->private->messages, errmsg );
+		g_error_free( error );
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
@@ -65,6 +65,7 @@ struct _FMAMenuPluginPrivate {
 static GObjectClass *st_parent_class  = NULL;
 static GType         st_actions_type  = 0;
 static gint          st_burst_timeout = 100;		/* burst timeout in msec */
+static gint          st_burst_max_wait = 1000;		/* max burst duration in msec */
 
 static void                 class_init( FMAMenuPluginClass *klass );
 static void                 instance_init( GTypeInstance *instance, gpointer klass );
@@ -176,9 +177,9 @@ instance_init( GTypeInstance *instance, gpointer klass )
 
 	self->private->dispose_has_run = FALSE;
 	self->private->change_timeout.timeout = st_burst_timeout;
+	fma_timeout_set_max_wait( &self->private->change_timeout, st_burst_max_wait );
 	self->private->change_timeout.handler = ( FMATimeoutFunc ) on_change_event_timeout;
 	self->private->change_timeout.user_data = self;
-	self->private->change_timeout.source_id = 0;
 }
 
 /*
@@ -272,6 +273,8 @@ instance_dispose( GObject *object )
 
 		self->private->dispose_has_run = TRUE;
 
+		fma_timeout_cancel( &self->private->change_timeout );
+
 		if( self->private->items_changed_handler ){
 			g_signal_handler_disconnect( self->private->pivot, self->private->items_changed_handler );
 		}
@@ -36,6 +36,8 @@
 #include "api/fma-dbus.h"
 #include "api/fma-fm-defines.h"
 
+#include "core/fma-selected-info.h"
+
 #include "plugin-tracker/fma-tracker-plugin.h"
 #include "plugin-tracker/fma-tracker-gdbus.h"
 
@@ -45,13 +47,77 @@ struct _FMATrackerPluginClassPrivate {
 	void *empty;						/* so that gcc -pedantic is happy */
 };
 
+/* a weak reference on the tracker, shared by all the items of a
+ * selection, so that a file change may drop the cached GetSelectedPaths
+ * reply while the tracker is alive
+ */
+typedef struct {
+	guint    ref_count;
+	GWeakRef tracker;
+}
+	SelectionGuard;
+
+/* an item of the current selection
+ * uri and mimetype are only computed when a client first asks for them,
+ * and so are the file attributes, which are asynchronously queried;
+ * they are all reset when the file manager signals that the file has
+ * changed
+ */
+typedef struct {
+	FileManagerFileInfo *info;
+	gulong               changed_handler;
+	SelectionGuard      *guard;
+	gchar               *uri;
+	gchar               *mimetype;
+	guint                serial;		/* incremented on each change */
+	gboolean             queried;
+	GFileType            file_type;
+	guint                access;		/* FMASelectedInfoAccess flags */
+	gchar               *owner;
+}
+	SelectedItem;
+
+/* a pending GetSelectedInfos invocation
+ * we keep a reference on the selection at the time of the request, so
+ * that the reply is consistent even if the selection changes meanwhile
+ */
+typedef struct {
+	FMATrackerGDBusProperties1 *properties;
+	GDBusMethodInvocation      *invocation;
+	GPtrArray                  *selected;
+	guint                       generation;
+	guint                       offset;
+	guint                       last;
+	guint                       pending;	/* count of running queries */
+}
+	InfosRequest;
+
+/* a file attributes query for a SelectedItem of an InfosRequest
+ */
+typedef struct {
+	InfosRequest *request;
+	SelectedItem *item;
+	guint         serial;
+}
+	InfosQuery;
+
+#define SELECTED_ITEM_ATTRIBUTES		G_FILE_ATTRIBUTE_STANDARD_TYPE \
+											"," G_FILE_ATTRIBUTE_ACCESS_CAN_READ \
+											"," G_FILE_ATTRIBUTE_ACCESS_CAN_WRITE \
+											"," G_FILE_ATTRIBUTE_ACCESS_CAN_EXECUTE \
+											"," G_FILE_ATTRIBUTE_OWNER_USER
+
 /* private instance data
  */
 struct _FMATrackerPluginPrivate {
-	gboolean                  dispose_has_run;
-	guint                     owner_id;	/* the identifier returns by g_bus_own_name */
-	GDBusObjectManagerServer *manager;
-	GList                    *selected;
+	gboolean                    dispose_has_run;
+	guint                       owner_id;	/* the identifier returns by g_bus_own_name */
+	GDBusObjectManagerServer   *manager;
+	FMATrackerGDBusProperties1 *properties1;
+	GPtrArray                  *selected;	/* SelectedItem, in selection order */
+	guint                       generation;
+	GVariant                   *paths;		/* cached GetSelectedPaths reply */
+	gboolean                    has_clients;
 };
 
 static GObjectClass *st_parent_class = NULL;
@@ -64,6 +130,10 @@ static void     on_bus_acquired( GDBusConnection *connection, const gchar *name,
 static void     on_name_acquired( GDBusConnection *connection, const gchar *name, FMATrackerPlugin *tracker );
 static void     on_name_lost( GDBusConnection *connection, const gchar *name, FMATrackerPlugin *tracker );
 static gboolean on_properties1_get_selected_paths( FMATrackerGDBusProperties1 *properties, GDBusMethodInvocation *invocation, FMATrackerPlugin *tracker );
+static gboolean on_properties1_get_selected_paths_page( FMATrackerGDBusProperties1 *properties, GDBusMethodInvocation *invocation, guint offset, guint count, FMATrackerPlugin *tracker );
+static gboolean on_properties1_get_selected_infos( FMATrackerGDBusProperties1 *properties, GDBusMethodInvocation *invocation, guint offset, guint count, FMATrackerPlugin *tracker );
+static void     on_selected_item_query_info_ready( GFile *location, GAsyncResult *result, InfosQuery *query );
+static void     infos_request_done( InfosRequest *request );
 static void     instance_dispose( GObject *object );
 static void     instance_finalize( GObject *object );
 
@@ -72,8 +142,15 @@ static GList   *menu_provider_get_background_items( FileManagerMenuProvider *pro
 static GList   *menu_provider_get_file_items( FileManagerMenuProvider *provider, GtkWidget *window, GList *files );
 
 static void     set_uris( FMATrackerPlugin *tracker, GList *files );
-static gchar  **get_selected_paths( FMATrackerPlugin *tracker );
-static GList   *free_selected( GList *selected );
+static SelectionGuard *selection_guard_new( FMATrackerPlugin *tracker );
+static void     selection_guard_unref( SelectionGuard *guard );
+static SelectedItem *selected_item_new( SelectionGuard *guard, FileManagerFileInfo *info );
+static void     on_selected_item_changed( FileManagerFileInfo *info, SelectedItem *item );
+static void     emit_selection_changed( FMATrackerPlugin *tracker, GPtrArray *previous );
+static gchar  **get_selected_paths( FMATrackerPlugin *tracker, guint offset, guint count );
+static const gchar *selected_item_get_uri( SelectedItem *item );
+static const gchar *selected_item_get_mimetype( SelectedItem *item );
+static void     free_selected_item( SelectedItem *item );
 
 GType
 fma_tracker_plugin_get_type( void )
@@ -143,6 +220,10 @@ instance_init( GTypeInstance *instance, gpointer klass )
 
 	self->private = g_new0( FMATrackerPluginPrivate, 1 );
 	self->private->dispose_has_run = FALSE;
+	self->private->selected = g_ptr_array_new_with_free_func(( GDestroyNotify ) free_selected_item );
+	self->private->generation = 0;
+	self->private->paths = NULL;
+	self->private->has_clients = FALSE;
 
 	initialize_dbus_connection( self );
 }
@@ -199,9 +280,13 @@ on_bus_acquired( GDBusConnection *connection, const gchar *name, FMATrackerPlugi
 	 */
 	tracker_properties1 = fma_tracker_gdbus_properties1_skeleton_new();
 	fma_tracker_gdbus_object_skeleton_set_properties1( tracker_object, tracker_properties1 );
-	g_object_unref( tracker_properties1 );
 
-	/* handle GetSelectedPaths method invocation on the .Properties1 interface
+	/* keep our reference so that we are able to emit SelectionChanged
+	 */
+	tracker->private->properties1 = tracker_properties1;
+
+	/* handle GetSelectedPaths, GetSelectedPathsPage and GetSelectedInfos
+	 * method invocations on the .Properties1 interface
 	 */
 	g_signal_connect(
 			tracker_properties1,
@@ -209,6 +294,18 @@ on_bus_acquired( GDBusConnection *connection, const gchar *name, FMATrackerPlugi
 			G_CALLBACK( on_properties1_get_selected_paths ),
 			tracker );
 
+	g_signal_connect(
+			tracker_properties1,
+			"handle-get-selected-paths-page",
+			G_CALLBACK( on_properties1_get_selected_paths_page ),
+			tracker );
+
+	g_signal_connect(
+			tracker_properties1,
+			"handle-get-selected-infos",
+			G_CALLBACK( on_properties1_get_selected_infos ),
+			tracker );
+
 	/* and export the DBus object on the object manager server
 	 * (which takes its own reference on it)
 	 */
@@ -266,8 +363,15 @@ instance_dispose( GObject *object )
 		if( priv->manager ){
 			g_object_unref( priv->manager );
 		}
+		if( priv->properties1 ){
+			g_object_unref( priv->properties1 );
+		}
 
-		priv->selected = free_selected( priv->selected );
+		if( priv->paths ){
+			g_variant_unref( priv->paths );
+		}
+
+		g_ptr_array_unref( priv->selected );
 
 		/* chain up to the parent class */
 		if( G_OBJECT_CLASS( st_parent_class )->dispose ){
@@ -370,42 +474,352 @@ menu_provider_get_file_items( FileManagerMenuProvider *provider, GtkWidget *wind
  * @tracker: this #FMATrackerPlugin instance.
  * @files: the list of currently selected items.
  *
- * Maintains our own list of uris.
+ * Maintains our own list of selected items.
+ *
+ * The file manager calls us each time a menu is about to be displayed,
+ * most often with the very same selection: we just keep a reference on
+ * the #FileManagerFileInfo objects when the selection has changed, and
+ * defer all other work until a D-Bus client asks for it.
+ *
+ * SelectionChanged is only emitted once a client has read the selection,
+ * as a delta is meaningless to whom doesn't know the starting point.
  */
 static void
 set_uris( FMATrackerPlugin *tracker, GList *files )
 {
 	FMATrackerPluginPrivate *priv;
+	GPtrArray *previous;
+	SelectedItem *item;
+	SelectionGuard *guard;
+	gboolean changed;
+	GList *it;
+	guint i;
 
 	priv = tracker->private;
+	previous = priv->selected;
+	changed = FALSE;
+
+	for( it = files, i = 0 ; it && !changed ; it = it->next, ++i ){
+		changed = ( i >= previous->len ||
+				(( SelectedItem * ) g_ptr_array_index( previous, i ))->info != it->data );
+	}
+	changed |= ( i != previous->len );
+
+	if( changed ){
+		priv->selected = g_ptr_array_new_with_free_func(( GDestroyNotify ) free_selected_item );
 
-	priv->selected = free_selected( tracker->private->selected );
-	priv->selected = file_manager_file_info_list_copy( files );
+		guard = selection_guard_new( tracker );
+
+		for( it = files ; it ; it = it->next ){
+			item = selected_item_new( guard, FILE_MANAGER_FILE_INFO( it->data ));
+			g_ptr_array_add( priv->selected, item );
+		}
+
+		selection_guard_unref( guard );
+
+		priv->generation += 1;
+
+		if( priv->paths ){
+			g_variant_unref( priv->paths );
+			priv->paths = NULL;
+		}
+
+		if( priv->has_clients ){
+			emit_selection_changed( tracker, previous );
+		}
+
+		g_ptr_array_unref( previous );
+	}
 }
 
 /*
+ * sends the difference between the previous and the current selections
+ *
+ * items are compared by FileManagerFileInfo, which the file manager
+ * keeps unique for a given file; the strings already computed for an
+ * item which stays selected are moved to the new selection
+ */
+static void
+emit_selection_changed( FMATrackerPlugin *tracker, GPtrArray *previous )
+{
+	static const gchar *thisfn = "fma_tracker_plugin_emit_selection_changed";
+	FMATrackerPluginPrivate *priv;
+	GHashTable *previous_by_info, *current_by_info;
+	GPtrArray *removed, *added;
+	SelectedItem *item, *previous_item;
+	guint i;
+
+	priv = tracker->private;
+
+	if( !priv->properties1 ){
+		return;
+	}
+
+	previous_by_info = g_hash_table_new( g_direct_hash, g_direct_equal );
+	for( i = 0 ; i < previous->len ; ++i ){
+		item = ( SelectedItem * ) g_ptr_array_index( previous, i );
+		g_hash_table_insert( previous_by_info, item->info, item );
+	}
+
+	current_by_info = g_hash_table_new( g_direct_hash, g_direct_equal );
+	added = g_ptr_array_new();
+
+	for( i = 0 ; i < priv->selected->len ; ++i ){
+		item = ( SelectedItem * ) g_ptr_array_index( priv->selected, i );
+		g_hash_table_insert( current_by_info, item->info, item );
+		previous_item = ( SelectedItem * ) g_hash_table_lookup( previous_by_info, item->info );
+
+		if( previous_item ){
+			item->uri = previous_item->uri;
+			item->mimetype = previous_item->mimetype;
+			previous_item->uri = NULL;
+			previous_item->mimetype = NULL;
+
+			if( previous_item->queried ){
+				item->queried = TRUE;
+				item->file_type = previous_item->file_type;
+				item->access = previous_item->access;
+				item->owner = previous_item->owner;
+				previous_item->owner = NULL;
+			}
+
+		} else {
+			g_ptr_array_add( added, ( gpointer ) selected_item_get_uri( item ));
+			g_ptr_array_add( added, ( gpointer ) selected_item_get_mimetype( item ));
+		}
+	}
+	g_ptr_array_add( added, NULL );
+
+	removed = g_ptr_array_new();
+	for( i = 0 ; i < previous->len ; ++i ){
+		item = ( SelectedItem * ) g_ptr_array_index( previous, i );
+		if( !g_hash_table_contains( current_by_info, item->info )){
+			g_ptr_array_add( removed, ( gpointer ) selected_item_get_uri( item ));
+		}
+	}
+	g_ptr_array_add( removed, NULL );
+
+	g_debug( "%s: generation=%u, removed=%u, added=%u",
+			thisfn, priv->generation, removed->len-1, ( added->len-1 )/2 );
+
+	fma_tracker_gdbus_properties1_emit_selection_changed(
+			priv->properties1,
+			priv->generation,
+			( const gchar * const * ) removed->pdata,
+			( const gchar * const * ) added->pdata );
+
+	g_ptr_array_free( removed, TRUE );
+	g_ptr_array_free( added, TRUE );
+	g_hash_table_destroy( current_by_info );
+	g_hash_table_destroy( previous_by_info );
+}
+
+/*
+ * the serialized reply is kept until the selection changes
+ *
  * Returns: %TRUE if the method has been handled.
  */
 static gboolean
 on_properties1_get_selected_paths( FMATrackerGDBusProperties1 *properties, GDBusMethodInvocation *invocation, FMATrackerPlugin *tracker )
 {
+	FMATrackerPluginPrivate *priv;
 	gchar **paths;
+	GVariant *value;
 
 	g_return_val_if_fail( FMA_IS_TRACKER_PLUGIN( tracker ), FALSE );
 
-	paths = get_selected_paths( tracker );
+	priv = tracker->private;
+	priv->has_clients = TRUE;
+
+	if( !priv->paths ){
+		paths = get_selected_paths( tracker, 0, G_MAXUINT );
+		value = g_variant_new_strv(( const gchar * const * ) paths, -1 );
+		priv->paths = g_variant_ref_sink( g_variant_new_tuple( &value, 1 ));
+		g_strfreev( paths );
+	}
+
+	g_dbus_method_invocation_return_value( invocation, priv->paths );
 
-	fma_tracker_gdbus_properties1_complete_get_selected_paths(
+	return( TRUE );
+}
+
+/*
+ * Returns: %TRUE if the method has been handled.
+ */
+static gboolean
+on_properties1_get_selected_paths_page( FMATrackerGDBusProperties1 *properties, GDBusMethodInvocation *invocation, guint offset, guint count, FMATrackerPlugin *tracker )
+{
+	gchar **paths;
+
+	g_return_val_if_fail( FMA_IS_TRACKER_PLUGIN( tracker ), FALSE );
+
+	tracker->private->has_clients = TRUE;
+	paths = get_selected_paths( tracker, offset, count );
+
+	fma_tracker_gdbus_properties1_complete_get_selected_paths_page(
 			properties,
 			invocation,
+			tracker->private->generation,
+			tracker->private->selected->len,
 			( const gchar * const * ) paths );
 
+	g_strfreev( paths );
+
+	return( TRUE );
+}
+
+/*
+ * the file manager extension API doesn't provide the file type, the
+ * access rights nor the owner of the selected items: they are queried
+ * once per item, asynchronously so that the file manager UI is never
+ * blocked, and kept with the item while it stays selected and unchanged
+ *
+ * Returns: %TRUE if the method has been handled.
+ */
+static gboolean
+on_properties1_get_selected_infos( FMATrackerGDBusProperties1 *properties, GDBusMethodInvocation *invocation, guint offset, guint count, FMATrackerPlugin *tracker )
+{
+	static const gchar *thisfn = "fma_tracker_plugin_on_properties1_get_selected_infos";
+	FMATrackerPluginPrivate *priv;
+	InfosRequest *request;
+	InfosQuery *query;
+	SelectedItem *item;
+	GFile *location;
+	guint i;
+
+	g_return_val_if_fail( FMA_IS_TRACKER_PLUGIN( tracker ), FALSE );
+
+	priv = tracker->private;
+	priv->has_clients = TRUE;
+
+	g_debug( "%s: tracker=%p, offset=%u, count=%u", thisfn, ( void * ) tracker, offset, count );
+
+	request = g_new0( InfosRequest, 1 );
+	request->properties = g_object_ref( properties );
+	request->invocation = g_object_ref( invocation );
+	request->selected = g_ptr_array_ref( priv->selected );
+	request->generation = priv->generation;
+	request->offset = MIN( offset, priv->selected->len );
+	request->last = request->offset + MIN( count, priv->selected->len - request->offset );
+
+	/* this one is released at the end of the loop, so that we do not
+	 * reply before having started all the needed queries
+	 */
+	request->pending = 1;
+
+	for( i = request->offset ; i < request->last ; ++i ){
+		item = ( SelectedItem * ) g_ptr_array_index( request->selected, i );
+		if( !item->queried ){
+			query = g_new0( InfosQuery, 1 );
+			query->request = request;
+			query->item = item;
+			query->serial = item->serial;
+			request->pending += 1;
+			location = g_file_new_for_uri( selected_item_get_uri( item ));
+			g_file_query_info_async( location,
+					SELECTED_ITEM_ATTRIBUTES, G_FILE_QUERY_INFO_NONE, G_PRIORITY_DEFAULT, NULL,
+					( GAsyncReadyCallback ) on_selected_item_query_info_ready, query );
+			g_object_unref( location );
+		}
+	}
+
+	infos_request_done( request );
+
 	return( TRUE );
 }
 
+static void
+on_selected_item_query_info_ready( GFile *location, GAsyncResult *result, InfosQuery *query )
+{
+	static const gchar *thisfn = "fma_tracker_plugin_on_selected_item_query_info_ready";
+	SelectedItem *item;
+	GFileInfo *info;
+	GError *error;
+
+	item = query->item;
+	error = NULL;
+	info = g_file_query_info_finish( location, result, &error );
+
+	/* a failed query is not cached, and will be tried again on next
+	 * request; the attributes of a file which has changed since the
+	 * query was started are only sent with this reply
+	 */
+	if( error ){
+		g_debug( "%s: uri=%s, g_file_query_info: %s", thisfn, item->uri, error->message );
+		g_error_free( error );
+		item->file_type = G_FILE_TYPE_UNKNOWN;
+		item->access = 0;
+		g_free( item->owner );
+		item->owner = NULL;
+
+	} else {
+		item->file_type = ( GFileType ) g_file_info_get_attribute_uint32( info, G_FILE_ATTRIBUTE_STANDARD_TYPE );
+		item->access = 0;
+		if( g_file_info_get_attribute_boolean( info, G_FILE_ATTRIBUTE_ACCESS_CAN_READ )){
+			item->access |= SELECTED_INFO_CAN_READ;
+		}
+		if( g_file_info_get_attribute_boolean( info, G_FILE_ATTRIBUTE_ACCESS_CAN_WRITE )){
+			item->access |= SELECTED_INFO_CAN_WRITE;
+		}
+		if( g_file_info_get_attribute_boolean( info, G_FILE_ATTRIBUTE_ACCESS_CAN_EXECUTE )){
+			item->access |= SELECTED_INFO_CAN_EXECUTE;
+		}
+		g_free( item->owner );
+		item->owner = g_file_info_get_attribute_as_string( info, G_FILE_ATTRIBUTE_OWNER_USER );
+		g_object_unref( info );
+		item->queried = ( item->serial == query->serial );
+	}
+
+	infos_request_done( query->request );
+	g_free( query );
+}
+
+/*
+ * replies to the GetSelectedInfos invocation when the last query of
+ * the request has completed
+ */
+static void
+infos_request_done( InfosRequest *request )
+{
+	GVariantBuilder builder;
+	SelectedItem *item;
+	guint i;
+
+	request->pending -= 1;
+
+	if( request->pending == 0 ){
+
+		g_variant_builder_init( &builder, G_VARIANT_TYPE( "a(ssuus)" ));
+
+		for( i = request->offset ; i < request->last ; ++i ){
+			item = ( SelectedItem * ) g_ptr_array_index( request->selected, i );
+			g_variant_builder_add( &builder, "(ssuus)",
+					selected_item_get_uri( item ),
+					selected_item_get_mimetype( item ),
+					( guint ) item->file_type,
+					item->access,
+					item->owner ? item->owner : "" );
+		}
+
+		fma_tracker_gdbus_properties1_complete_get_selected_infos(
+				request->properties,
+				request->invocation,
+				request->generation,
+				request->selected->len,
+				g_variant_builder_end( &builder ));
+
+		g_object_unref( request->invocation );
+		g_ptr_array_unref( request->selected );
+		g_object_unref( request->properties );
+		g_free( request );
+	}
+}
+
 /*
  * get_selected_paths:
  * @tracker: this #FMATrackerPlugin object.
+ * @offset: the index of the first item.
+ * @count: the maximum count of items.
  *
  * Sends on session D-Bus the list of currently selected items, as two
  * strings for each item :
@@ -416,41 +830,135 @@ on_properties1_get_selected_paths( FMATrackerGDBusProperties1 *properties, GDBus
  * (e.g. computer), and standard GLib functions are not able to retrieve
  * their mimetype.
  *
- * Exported as GetSelectedPaths method on Tracker.Properties1 interface.
+ * Exported as GetSelectedPaths and GetSelectedPathsPage methods on
+ * Tracker.Properties1 interface.
  */
 static gchar **
-get_selected_paths( FMATrackerPlugin *tracker )
+get_selected_paths( FMATrackerPlugin *tracker, guint offset, guint count )
 {
 	static const gchar *thisfn = "fma_tracker_plugin_get_selected_paths";
 	FMATrackerPluginPrivate *priv;
+	SelectedItem *item;
 	gchar **paths;
-	GList *it;
-	int count;
 	gchar **iter;
+	guint i, last;
 
-	paths = NULL;
 	priv = tracker->private;
 
-	g_debug( "%s: tracker=%p", thisfn, ( void * ) tracker );
+	g_debug( "%s: tracker=%p, offset=%u, count=%u", thisfn, ( void * ) tracker, offset, count );
+
+	offset = MIN( offset, priv->selected->len );
+	last = offset + MIN( count, priv->selected->len - offset );
 
-	count = 2 * g_list_length( priv->selected );
-	paths = ( char ** ) g_new0( gchar *, 1+count );
+	paths = ( char ** ) g_new0( gchar *, 1+2*( last-offset ));
 	iter = paths;
 
-	for( it = priv->selected ; it ; it = it->next ){
-		*iter = file_manager_file_info_get_uri(( FileManagerFileInfo * ) it->data );
+	for( i = offset ; i < last ; ++i ){
+		item = ( SelectedItem * ) g_ptr_array_index( priv->selected, i );
+		*iter = g_strdup( selected_item_get_uri( item ));
 		iter++;
-		*iter = file_manager_file_info_get_mime_type(( FileManagerFileInfo * ) it->data );
+		*iter = g_strdup( selected_item_get_mimetype( item ));
 		iter++;
 	}
 
 	return( paths );
 }
 
-static GList *
-free_selected( GList *selected )
+static SelectionGuard *
+selection_guard_new( FMATrackerPlugin *tracker )
 {
-	file_manager_file_info_list_free( selected );
+	SelectionGuard *guard;
 
-	return( NULL );
+	guard = g_new0( SelectionGuard, 1 );
+	guard->ref_count = 1;
+	g_weak_ref_init( &guard->tracker, tracker );
+
+	return( guard );
+}
+
+static void
+selection_guard_unref( SelectionGuard *guard )
+{
+	guard->ref_count -= 1;
+
+	if( guard->ref_count == 0 ){
+		g_weak_ref_clear( &guard->tracker );
+		g_free( guard );
+	}
+}
+
+static SelectedItem *
+selected_item_new( SelectionGuard *guard, FileManagerFileInfo *info )
+{
+	SelectedItem *item;
+
+	item = g_new0( SelectedItem, 1 );
+	item->info = g_object_ref( info );
+	item->guard = guard;
+	guard->ref_count += 1;
+	item->changed_handler = g_signal_connect( info, "changed", G_CALLBACK( on_selected_item_changed ), item );
+
+	return( item );
+}
+
+/*
+ * the file may have been renamed, or its content type or attributes
+ * have changed: forget what we know about it, and the cached
+ * GetSelectedPaths reply if the item is still selected
+ */
+static void
+on_selected_item_changed( FileManagerFileInfo *info, SelectedItem *item )
+{
+	FMATrackerPlugin *tracker;
+	FMATrackerPluginPrivate *priv;
+
+	g_free( item->uri );
+	item->uri = NULL;
+	g_free( item->mimetype );
+	item->mimetype = NULL;
+	item->serial += 1;
+	item->queried = FALSE;
+
+	tracker = g_weak_ref_get( &item->guard->tracker );
+
+	if( tracker ){
+		priv = tracker->private;
+		if( priv->paths && !priv->dispose_has_run ){
+			g_variant_unref( priv->paths );
+			priv->paths = NULL;
+		}
+		g_object_unref( tracker );
+	}
+}
+
+static const gchar *
+selected_item_get_uri( SelectedItem *item )
+{
+	if( !item->uri ){
+		item->uri = file_manager_file_info_get_uri( item->info );
+	}
+
+	return( item->uri );
+}
+
+static const gchar *
+selected_item_get_mimetype( SelectedItem *item )
+{
+	if( !item->mimetype ){
+		item->mimetype = file_manager_file_info_get_mime_type( item->info );
+	}
+
+	return( item->mimetype );
+}
+
+static void
+free_selected_item( SelectedItem *item )
+{
+	g_signal_handler_disconnect( item->info, item->changed_handler );
+	selection_guard_unref( item->guard );
+	g_object_unref( item->info );
+	g_free( item->uri );
+	g_free( item->mimetype );
+	g_free( item->owner );
+	g_free( item );
 }
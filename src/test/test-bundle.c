@@ -0,0 +1,323 @@
+/*
+ * Nautilus-Actions
+ * A Nautilus extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * Nautilus-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * Nautilus-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Nautilus-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+/*
+ * Exports a menu and its two actions as one bundle, and imports the
+ * bundle back, checking that the same items are returned in the same
+ * order.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <api/fma-core-utils.h>
+#include <api/fma-object-api.h>
+
+#include <core/fma-exporter.h>
+#include <core/fma-importer.h>
+#include <core/fma-pivot.h>
+
+static gchar     *format  = "GConfEntry";
+static gboolean   version = FALSE;
+
+static GOptionEntry entries[] = {
+
+	{ "format"               , 'f', 0, G_OPTION_ARG_STRING        , &format,
+			N_( "The export format [GConfEntry]" ), N_( "<FORMAT>" ) },
+	{ NULL }
+};
+
+static GOptionEntry misc_entries[] = {
+
+	{ "version"              , 'v', 0, G_OPTION_ARG_NONE        , &version,
+			N_( "Output the version number" ), NULL },
+	{ NULL }
+};
+
+static GOptionContext  *init_options( void );
+static void             check_options( int argc, char **argv, GOptionContext *context );
+static void             exit_with_usage( void );
+static GList           *build_bundle( void );
+static gboolean         export_bundle( FMAPivot *pivot, GList *bundle, const gchar *fname );
+static gboolean         check_results( GList *bundle, GList *results );
+static FMAObjectItem   *check_for_existence( const FMAObjectItem *item, void *fn_data );
+
+int
+main( int argc, char **argv )
+{
+	FMAPivot *pivot;
+	GList *bundle;
+	gchar *fname;
+	gint fd;
+	FMAImporterParms parms;
+	GList *import_results, *ir;
+	FMAImporterResult *result;
+	gboolean ok;
+
+#if !GLIB_CHECK_VERSION( 2,36, 0 )
+	g_type_init();
+#endif
+
+	GOptionContext *context = init_options();
+	check_options( argc, argv, context );
+
+	pivot = fma_pivot_new();
+
+	bundle = build_bundle();
+	fd = g_file_open_tmp( "fma-test-bundle-XXXXXX.xml", &fname, NULL );
+	if( fd < 0 ){
+		g_printerr( "unable to create a temporary file\n" );
+		return( EXIT_FAILURE );
+	}
+	close( fd );
+
+	ok = export_bundle( pivot, bundle, fname );
+
+	if( ok ){
+		memset( &parms, '\0', sizeof( FMAImporterParms ));
+		parms.uris = g_slist_prepend( NULL, fname );
+		parms.check_fn = check_for_existence;
+		parms.preferred_mode = IMPORTER_MODE_NO_IMPORT;
+		import_results = fma_importer_import_from_uris( pivot, &parms );
+
+		ok = check_results( bundle, import_results );
+
+		for( ir = import_results ; ir ; ir = ir->next ){
+			result = ( FMAImporterResult * ) ir->data;
+			fma_core_utils_slist_dump( NULL, result->messages );
+			if( result->imported ){
+				g_object_unref( result->imported );
+			}
+			fma_importer_free_result( result );
+		}
+
+		g_list_free( import_results );
+		g_slist_free( parms.uris );
+	}
+
+	g_unlink( fname );
+	g_free( fname );
+	g_list_free_full( bundle, ( GDestroyNotify ) g_object_unref );
+	g_object_unref( pivot );
+
+	g_print( "%s: %s\n", format, ok ? "OK" : "FAILED" );
+
+	return( ok ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+
+/*
+ * a menu with two actions, as they should come back from the import
+ * (i.e. the menu followed by its subitems)
+ */
+static GList *
+build_bundle( void )
+{
+	FMAObjectMenu *menu;
+	FMAObjectAction *action;
+	GList *bundle;
+	guint i;
+
+	menu = fma_object_menu_new_with_defaults();
+	bundle = g_list_prepend( NULL, menu );
+
+	for( i = 0 ; i < 2 ; ++i ){
+		action = fma_object_action_new_with_defaults();
+		fma_object_append_item( menu, action );
+		bundle = g_list_prepend( bundle, g_object_ref( action ));
+		g_object_unref( action );
+	}
+
+	return( g_list_reverse( bundle ));
+}
+
+static gboolean
+export_bundle( FMAPivot *pivot, GList *bundle, const gchar *fname )
+{
+	GFile *file;
+	GFileOutputStream *stream;
+	GList *items;
+	GSList *messages;
+	guint code;
+
+	file = g_file_new_for_path( fname );
+	stream = g_file_replace( file, NULL, FALSE, G_FILE_CREATE_NONE, NULL, NULL );
+	g_object_unref( file );
+
+	if( !stream ){
+		g_printerr( "unable to open %s\n", fname );
+		return( FALSE );
+	}
+
+	/* only the menu is provided: the actions come with the recursion
+	 */
+	items = g_list_prepend( NULL, bundle->data );
+	messages = NULL;
+
+	code = fma_exporter_to_stream( pivot, items, TRUE, G_OUTPUT_STREAM( stream ), format, &messages );
+
+	g_output_stream_close( G_OUTPUT_STREAM( stream ), NULL, NULL );
+	g_object_unref( stream );
+	g_list_free( items );
+
+	fma_core_utils_slist_dump( NULL, messages );
+	fma_core_utils_slist_free( messages );
+
+	if( code != FMA_IEXPORTER_CODE_OK ){
+		g_printerr( "export failed with code=%u\n", code );
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+static gboolean
+check_results( GList *bundle, GList *results )
+{
+	GList *ib, *ir;
+	FMAImporterResult *result;
+	gchar *expected_id, *imported_id;
+	gboolean ok;
+
+	ok = TRUE;
+
+	if( g_list_length( results ) != g_list_length( bundle )){
+		g_printerr( "expected %u imported items, got %u\n", g_list_length( bundle ), g_list_length( results ));
+		return( FALSE );
+	}
+
+	for( ib = bundle, ir = results ; ib && ir && ok ; ib = ib->next, ir = ir->next ){
+		result = ( FMAImporterResult * ) ir->data;
+
+		if( !result->imported ){
+			g_printerr( "%s: no item imported\n", result->uri );
+			ok = FALSE;
+
+		} else if( G_OBJECT_TYPE( result->imported ) != G_OBJECT_TYPE( ib->data )){
+			g_printerr( "expected a %s, got a %s\n", G_OBJECT_TYPE_NAME( ib->data ), G_OBJECT_TYPE_NAME( result->imported ));
+			ok = FALSE;
+
+		} else {
+			expected_id = fma_object_get_id( ib->data );
+			imported_id = fma_object_get_id( result->imported );
+
+			if( strcmp( expected_id, imported_id )){
+				g_printerr( "expected id %s, got %s\n", expected_id, imported_id );
+				ok = FALSE;
+			}
+
+			g_free( imported_id );
+			g_free( expected_id );
+		}
+	}
+
+	return( ok );
+}
+
+/*
+ * the imported items are not compared against any repository, so that
+ * they keep their identifier
+ */
+static FMAObjectItem *
+check_for_existence( const FMAObjectItem *item, void *fn_data )
+{
+	return( NULL );
+}
+
+static GOptionContext *
+init_options( void )
+{
+	GOptionContext *context;
+	gchar* description;
+	GOptionGroup *misc_group;
+
+	context = g_option_context_new( _( "Export a bundle of items and import it back." ));
+
+#ifdef ENABLE_NLS
+	bindtextdomain( GETTEXT_PACKAGE, GNOMELOCALEDIR );
+# ifdef HAVE_BIND_TEXTDOMAIN_CODESET
+	bind_textdomain_codeset( GETTEXT_PACKAGE, "UTF-8" );
+# endif
+	textdomain( GETTEXT_PACKAGE );
+	g_option_context_add_main_entries( context, entries, GETTEXT_PACKAGE );
+#else
+	g_option_context_add_main_entries( context, entries, NULL );
+#endif
+
+	description = g_strdup_printf( "%s.\n%s", PACKAGE_STRING,
+			_( "Bug reports are welcomed at https://gitlab.gnome.org/GNOME/filemanager-actions/issues/\n" ));
+
+	g_option_context_set_description( context, description );
+
+	g_free( description );
+
+	misc_group = g_option_group_new(
+			"misc", _( "Miscellaneous options" ), _( "Miscellaneous options" ), NULL, NULL );
+	g_option_group_add_entries( misc_group, misc_entries );
+	g_option_context_add_group( context, misc_group );
+
+	return( context );
+}
+
+static void
+check_options( int argc, char **argv, GOptionContext *context )
+{
+	GError *error = NULL;
+
+	if( !g_option_context_parse( context, &argc, &argv, &error )){
+		g_printerr( _( "Syntax error: %s\n" ), error->message );
+		g_error_free (error);
+		exit_with_usage();
+	}
+
+	g_option_context_free( context );
+
+	if( version ){
+		fma_core_utils_print_version();
+		exit( EXIT_SUCCESS );
+	}
+
+	if( !format || !strlen( format )){
+		g_printerr( _( "Error: format is mandatory.\n" ));
+		exit_with_usage();
+	}
+}
+
+static void
+exit_with_usage( void )
+{
+	g_printerr( _( "Try %s --help for usage.\n" ), g_get_prgname());
+	exit( EXIT_FAILURE );
+}
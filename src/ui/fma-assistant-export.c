@@ -37,6 +37,7 @@
 #include "api/fma-core-utils.h"
 #include "api/fma-object-api.h"
 
+#include "core/fma-export-bulk.h"
 #include "core/fma-exporter.h"
 #include "core/fma-export-format.h"
 #include "core/fma-gtk-utils.h"
@@ -78,16 +79,10 @@ struct _FMAAssistantExportPrivate {
 	gchar        *uri;
 	GList        *selected_items;
 	GList        *results;
+	GtkWidget    *progress_bar;
+	gboolean      running;
 };
 
-typedef struct {
-	FMAObjectItem *item;
-	GSList        *msg;
-	gchar         *fname;
-	gchar         *format;
-}
-	ExportStruct;
-
 static const gchar        *st_xmlui_filename = PKGUIDIR "/fma-assistant-export.ui";
 static const gchar        *st_toplevel_name  = "ExportAssistant";
 static const gchar        *st_wsp_name       = IPREFS_EXPORT_ASSISTANT_WSP;
@@ -115,6 +110,7 @@ static void        on_folder_chooser_selection_changed( GtkFileChooser *chooser,
 static void        assistant_prepare( BaseAssistant *window, GtkAssistant *assistant, GtkWidget *page );
 static void        assist_prepare_confirm( FMAAssistantExport *window, GtkAssistant *assistant, GtkWidget *page );
 static void        assistant_apply( BaseAssistant *window, GtkAssistant *assistant );
+static void        on_export_progress( const FMAExportBulkProgress *progress, FMAAssistantExport *window );
 static void        assist_prepare_exportdone( FMAAssistantExport *window, GtkAssistant *assistant, GtkWidget *page );
 static void        free_results( GList *list );
 
@@ -734,17 +730,25 @@ assist_prepare_confirm( FMAAssistantExport *window, GtkAssistant *assistant, Gtk
  * As of 1.11, fma_gconf_writer doesn't return any error message.
  * An error is simply indicated by returning a null filename.
  * So we provide a general error message.
+ *
+ * The export format of each item is first determined, maybe asking
+ * the user; the items are then serialized in parallel by the bulk
+ * exporter, while the progress bar keeps being updated.
  */
 static void
 assistant_apply( BaseAssistant *wnd, GtkAssistant *assistant )
 {
 	static const gchar *thisfn = "fma_assistant_export_on_apply";
 	FMAAssistantExport *window;
-	GList *ia;
-	ExportStruct *str;
+	GList *ia, *jobs;
+	FMAExportBulkJob *job;
+	FMAObjectItem *item;
 	FMAApplication *application;
 	FMAUpdater *updater;
 	gboolean first;
+	gchar *format;
+	GtkWidget *page;
+	gboolean quit_on_escape;
 
 	g_return_if_fail( FMA_IS_ASSISTANT_EXPORT( wnd ));
 
@@ -752,37 +756,87 @@ assistant_apply( BaseAssistant *wnd, GtkAssistant *assistant )
 
 	window = FMA_ASSISTANT_EXPORT( wnd );
 
+	if( window->private->running ){
+		return;
+	}
+
 	application = FMA_APPLICATION( base_window_get_application( BASE_WINDOW( window )));
 	updater = fma_application_get_updater( application );
 	first = TRUE;
+	jobs = NULL;
 
 	g_return_if_fail( window->private->uri && strlen( window->private->uri ));
 
 	for( ia = window->private->selected_items ; ia ; ia = ia->next ){
-		str = g_new0( ExportStruct, 1 );
-		window->private->results = g_list_append( window->private->results, str );
-
-		str->item = FMA_OBJECT_ITEM( fma_object_get_origin( FMA_IDUPLICABLE( ia->data )));
-		str->format = fma_settings_get_string( IPREFS_EXPORT_PREFERRED_FORMAT, NULL, NULL );
-		g_return_if_fail( str->format && strlen( str->format ));
-
-		if( !strcmp( str->format, EXPORTER_FORMAT_ASK )){
-			g_free( str->format );
-			str->format = fma_export_ask_user( str->item, first );
-			g_return_if_fail( str->format && strlen( str->format ));
-
-			if( !str->format || !strcmp( str->format, EXPORTER_FORMAT_NOEXPORT )){
-				str->msg = g_slist_append( NULL, g_strdup( _( "Export canceled due to user action." )));
-			}
+		item = FMA_OBJECT_ITEM( fma_object_get_origin( FMA_IDUPLICABLE( ia->data )));
+		format = fma_settings_get_string( IPREFS_EXPORT_PREFERRED_FORMAT, NULL, NULL );
+		g_return_if_fail( format && strlen( format ));
+
+		if( !strcmp( format, EXPORTER_FORMAT_ASK )){
+			g_free( format );
+			format = fma_export_ask_user( item, first );
+			g_return_if_fail( format && strlen( format ));
 		}
 
-		if( strcmp( str->format, EXPORTER_FORMAT_NOEXPORT ) != 0 ){
-			str->fname = fma_exporter_to_file( FMA_PIVOT( updater ), str->item, window->private->uri, str->format, &str->msg );
+		job = fma_export_bulk_job_new( item, format );
+		window->private->results = g_list_append( window->private->results, job );
+
+		if( !strcmp( format, EXPORTER_FORMAT_NOEXPORT )){
+			job->msg = g_slist_append( NULL, g_strdup( _( "Export canceled due to user action." )));
+		} else {
+			jobs = g_list_prepend( jobs, job );
 		}
 
-		g_free( str->format );
+		g_free( format );
 		first = FALSE;
 	}
+
+	if( jobs ){
+		jobs = g_list_reverse( jobs );
+
+		page = gtk_assistant_get_nth_page( assistant, ASSIST_PAGE_CONFIRM );
+		window->private->progress_bar = gtk_progress_bar_new();
+		gtk_progress_bar_set_show_text( GTK_PROGRESS_BAR( window->private->progress_bar ), TRUE );
+		gtk_grid_attach_next_to( GTK_GRID( page ), window->private->progress_bar, NULL, GTK_POS_BOTTOM, 2, 1 );
+		gtk_widget_show( window->private->progress_bar );
+
+		/* the main context keeps being iterated while the items are
+		 * exported: the assistant must be neither applied again nor
+		 * canceled before the run is over
+		 */
+		window->private->running = TRUE;
+		g_object_get( window, BASE_PROP_QUIT_ON_ESCAPE, &quit_on_escape, NULL );
+		g_object_set( window, BASE_PROP_QUIT_ON_ESCAPE, FALSE, NULL );
+		gtk_assistant_set_page_complete( assistant, page, FALSE );
+		gtk_widget_set_sensitive( GTK_WIDGET( assistant ), FALSE );
+
+		fma_export_bulk_run(
+				FMA_PIVOT( updater ), jobs, window->private->uri, 0,
+				( FMAExportBulkProgressFn ) on_export_progress, window );
+
+		gtk_widget_set_sensitive( GTK_WIDGET( assistant ), TRUE );
+		gtk_assistant_set_page_complete( assistant, page, TRUE );
+		g_object_set( window, BASE_PROP_QUIT_ON_ESCAPE, quit_on_escape, NULL );
+		window->private->running = FALSE;
+
+		g_list_free( jobs );
+	}
+}
+
+static void
+on_export_progress( const FMAExportBulkProgress *progress, FMAAssistantExport *window )
+{
+	gchar *text;
+
+	if( !window->private->dispose_has_run && progress->total ){
+		/* i18n: export progress: <done>/<total> items (<throughput> items/s) */
+		text = g_strdup_printf( _( "%u/%u items (%.1f items/s)" ),
+				progress->done, progress->total, fma_export_bulk_throughput( progress ));
+		gtk_progress_bar_set_fraction(
+				GTK_PROGRESS_BAR( window->private->progress_bar ), ( gdouble ) progress->done / progress->total );
+		gtk_progress_bar_set_text( GTK_PROGRESS_BAR( window->private->progress_bar ), text );
+		g_free( text );
+	}
 }
 
 static void
@@ -799,7 +853,7 @@ assist_prepare_exportdone( FMAAssistantExport *window, GtkAssistant *assistant,
 	GtkWidget *label;
 	GSList *is;
 	GList *ir;
-	ExportStruct *str;
+	FMAExportBulkJob *str;
 
 	g_debug( "%s: window=%p, assistant=%p, page=%p",
 			thisfn, ( void * ) window, ( void * ) assistant, ( void * ) page );
@@ -820,7 +874,7 @@ assist_prepare_exportdone( FMAAssistantExport *window, GtkAssistant *assistant,
 
 		/* display the item label
 		 */
-		str = ( ExportStruct * ) ir->data;
+		str = ( FMAExportBulkJob * ) ir->data;
 		color = str->fname ? "blue" : "red";
 		item_label = fma_object_get_label( str->item );
 		text = g_markup_printf_escaped( "<span foreground=\"%s\">%s</span>", color, item_label );
@@ -884,14 +938,5 @@ assist_prepare_exportdone( FMAAssistantExport *window, GtkAssistant *assistant,
 static void
 free_results( GList *list )
 {
-	GList *ir;
-	ExportStruct *str;
-
-	for( ir = list ; ir ; ir = ir->next ){
-		str = ( ExportStruct * ) ir->data;
-		g_free( str->fname );
-		fma_core_utils_slist_free( str->msg );
-	}
-
-	g_list_free( list );
+	g_list_free_full( list, ( GDestroyNotify ) fma_export_bulk_job_free );
 }
@@ -52,6 +52,13 @@ struct _FMAIconChooserPrivate {
 	const gchar    *initial_icon;
 	gchar          *current_icon;
 	GtkWidget      *path_preview;
+
+	/* themed icons are rendered in batches, in an idle loop
+	 */
+	GtkListStore   *load_store;
+	guint           load_idle_id;
+	gint            load_cursor;
+	gint            load_width;
 };
 
 #define VIEW_ICON_SIZE					GTK_ICON_SIZE_DND
@@ -59,6 +66,7 @@ struct _FMAIconChooserPrivate {
 #define PREVIEW_ICON_SIZE				GTK_ICON_SIZE_DIALOG
 #define PREVIEW_ICON_WIDTH				64
 #define CURRENT_ICON_SIZE				GTK_ICON_SIZE_DIALOG
+#define LOAD_BATCH_COUNT				24	/* icons rendered per idle iteration */
 
 /* column ordering in the Stock model
  */
@@ -86,9 +94,17 @@ enum {
 enum {
 	THEME_ICON_LABEL_COLUMN = 0,
 	THEME_ICON_PIXBUF_COLUMN,
+	THEME_ICON_LOADED_COLUMN,
 	THEME_ICON_N_COLUMN
 };
 
+/* the rendered themed icons are kept for the whole session, and shared
+ * between all contexts: icon name -> GdkPixbuf
+ * the cache is cleared when the icon theme changes
+ */
+static GHashTable      *st_icon_cache     = NULL;
+static GdkPixbuf       *st_placeholder    = NULL;
+
 static const gchar     *st_xmlui_filename = PKGUIDIR "/fma-icon-chooser.ui";
 static const gchar     *st_toplevel_name  = "IconChooserDialog";
 static const gchar     *st_wsp_name       = IPREFS_ICON_CHOOSER_WSP;
@@ -126,6 +142,13 @@ static void          on_path_selection_changed( GtkFileChooser *chooser, FMAIcon
 static void          on_path_update_preview( GtkFileChooser *chooser, FMAIconChooser *editor );
 static void          on_path_apply_button_clicked( GtkButton *button, FMAIconChooser *editor );
 static GtkListStore *theme_context_load_icons( FMAIconChooser *editor, const gchar *context );
+static void          theme_icons_load_start( FMAIconChooser *editor, GtkListStore *store );
+static void          theme_icons_load_stop( FMAIconChooser *editor );
+static gboolean      theme_icons_load_batch( FMAIconChooser *editor );
+static gint          theme_icons_load_range( FMAIconChooser *editor, GtkTreeModel *model, gint first, gint last, gint count, gint *next );
+static GdkPixbuf    *theme_icon_get_pixbuf( const gchar *icon_name, gint width );
+static GdkPixbuf    *theme_icon_get_placeholder( gint width );
+static void          on_icon_theme_changed( GtkIconTheme *icon_theme, void *empty );
 
 GType
 fma_icon_chooser_get_type( void )
@@ -260,6 +283,8 @@ instance_dispose( GObject *dialog )
 
 		self->private->dispose_has_run = TRUE;
 
+		theme_icons_load_stop( self );
+
 		paned = base_window_get_widget( BASE_WINDOW( self ), "IconPaned" );
 		pos = gtk_paned_get_position( GTK_PANED( paned ));
 		fma_settings_set_uint( IPREFS_ICON_CHOOSER_PANED, pos );
@@ -749,6 +774,7 @@ on_themed_context_changed( GtkTreeSelection *selection, FMAIconChooser *editor )
 
 		GtkIconView *iconview = GTK_ICON_VIEW( base_window_get_widget( BASE_WINDOW( editor ), "ThemedIconView" ));
 		gtk_icon_view_set_model( iconview, GTK_TREE_MODEL( store ));
+		theme_icons_load_start( editor, store );
 
 		if( last_path ){
 			path = gtk_tree_path_new_from_string( last_path );
@@ -892,19 +918,24 @@ on_path_apply_button_clicked( GtkButton *button, FMAIconChooser *editor )
 	on_current_icon_changed( editor );
 }
 
+/*
+ * the icon names of the context are all inserted at once, with a
+ * placeholder pixbuf unless the icon has already been rendered during
+ * this session; the actual rendering is done by theme_icons_load_batch()
+ */
 static GtkListStore *
 theme_context_load_icons( FMAIconChooser *editor, const gchar *context )
 {
 	static const gchar *thisfn = "fma_icon_chooser_theme_context_load_icons";
 	GtkTreeIter iter;
 	GList *ic;
-	GError *error;
 	gint width, height;
+	GdkPixbuf *pixbuf, *placeholder;
 
 	g_debug( "%s: editor=%p, context=%s", thisfn, ( void * ) editor, context );
 
 	GtkIconTheme *icon_theme = gtk_icon_theme_get_default();
-	GtkListStore *store = gtk_list_store_new( THEME_ICON_N_COLUMN, G_TYPE_STRING, GDK_TYPE_PIXBUF );
+	GtkListStore *store = gtk_list_store_new( THEME_ICON_N_COLUMN, G_TYPE_STRING, GDK_TYPE_PIXBUF, G_TYPE_BOOLEAN );
 
 	GList *icon_list = g_list_sort( gtk_icon_theme_list_icons( icon_theme, context ), ( GCompareFunc ) g_utf8_collate );
 
@@ -912,27 +943,227 @@ theme_context_load_icons( FMAIconChooser *editor, const gchar *context )
 		width = VIEW_ICON_DEFAULT_WIDTH;
 	}
 	g_debug( "%s: width=%d", thisfn, width );
+	editor->private->load_width = width;
+
+	if( !st_icon_cache ){
+		st_icon_cache = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) g_object_unref );
+		g_signal_connect( icon_theme, "changed", G_CALLBACK( on_icon_theme_changed ), NULL );
+	}
+	placeholder = theme_icon_get_placeholder( width );
 
 	for( ic = icon_list ; ic ; ic = ic->next ){
 		const gchar *icon_name = ( const gchar * ) ic->data;
-		error = NULL;
-		GdkPixbuf *pixbuf = gtk_icon_theme_load_icon(
-				icon_theme, icon_name, width, GTK_ICON_LOOKUP_GENERIC_FALLBACK, &error );
-		if( error ){
-			g_warning( "%s: %s", thisfn, error->message );
-			g_error_free( error );
-		} else {
-			gtk_list_store_append( store, &iter );
-			gtk_list_store_set( store, &iter,
-					THEME_ICON_LABEL_COLUMN, icon_name,
-					THEME_ICON_PIXBUF_COLUMN, pixbuf,
-					-1 );
-			g_object_unref( pixbuf );
-		}
+		pixbuf = g_hash_table_lookup( st_icon_cache, icon_name );
+		gtk_list_store_insert_with_values( store, &iter, -1,
+				THEME_ICON_LABEL_COLUMN, icon_name,
+				THEME_ICON_PIXBUF_COLUMN, pixbuf ? pixbuf : placeholder,
+				THEME_ICON_LOADED_COLUMN, pixbuf != NULL,
+				-1 );
 	}
-	g_debug( "%s: %d loaded icons in store=%p", thisfn, g_list_length( icon_list ), ( void * ) store );
+	g_debug( "%s: %d icons in store=%p", thisfn, g_list_length( icon_list ), ( void * ) store );
 	g_list_foreach( icon_list, ( GFunc ) g_free, NULL );
 	g_list_free( icon_list );
 
 	return( store );
 }
+
+/*
+ * (re)starts the rendering of the icons of the newly displayed store;
+ * the icons of a previously displayed context which have not been
+ * rendered yet will be when this context is selected again
+ */
+static void
+theme_icons_load_start( FMAIconChooser *editor, GtkListStore *store )
+{
+	theme_icons_load_stop( editor );
+
+	editor->private->load_store = g_object_ref( store );
+	editor->private->load_cursor = 0;
+	editor->private->load_idle_id =
+			g_idle_add(( GSourceFunc ) theme_icons_load_batch, editor );
+}
+
+static void
+theme_icons_load_stop( FMAIconChooser *editor )
+{
+	if( editor->private->load_idle_id ){
+		g_source_remove( editor->private->load_idle_id );
+		editor->private->load_idle_id = 0;
+	}
+
+	if( editor->private->load_store ){
+		g_object_unref( editor->private->load_store );
+		editor->private->load_store = NULL;
+	}
+}
+
+/*
+ * renders at most LOAD_BATCH_COUNT icons, the visible ones first, then
+ * the others in the store order
+ *
+ * the idle source is removed when all icons of the store are rendered
+ */
+static gboolean
+theme_icons_load_batch( FMAIconChooser *editor )
+{
+	static const gchar *thisfn = "fma_icon_chooser_theme_icons_load_batch";
+	GtkIconView *icon_view;
+	GtkTreeModel *model;
+	GtkTreePath *start_path, *end_path;
+	gint count;
+
+	g_return_val_if_fail( FMA_IS_ICON_CHOOSER( editor ), FALSE );
+
+	if( editor->private->dispose_has_run ){
+		return( FALSE );
+	}
+
+	model = GTK_TREE_MODEL( editor->private->load_store );
+	count = LOAD_BATCH_COUNT;
+
+	icon_view = GTK_ICON_VIEW( base_window_get_widget( BASE_WINDOW( editor ), "ThemedIconView" ));
+	if( gtk_icon_view_get_model( icon_view ) == model &&
+			gtk_icon_view_get_visible_range( icon_view, &start_path, &end_path )){
+
+		count = theme_icons_load_range( editor, model,
+				gtk_tree_path_get_indices( start_path )[0], gtk_tree_path_get_indices( end_path )[0], count, NULL );
+		gtk_tree_path_free( start_path );
+		gtk_tree_path_free( end_path );
+	}
+
+	if( count ){
+		count = theme_icons_load_range( editor, model,
+				editor->private->load_cursor, -1, count, &editor->private->load_cursor );
+	}
+
+	/* nothing left to render
+	 */
+	if( count ){
+		g_debug( "%s: all icons rendered in store=%p", thisfn, ( void * ) model );
+		editor->private->load_idle_id = 0;
+		g_object_unref( editor->private->load_store );
+		editor->private->load_store = NULL;
+		return( FALSE );
+	}
+
+	return( TRUE );
+}
+
+/*
+ * renders at most count not yet rendered icons between first and last
+ * rows (last=-1 meaning up to the end of the store); if set, next
+ * receives the index of the first row which has not been examined
+ *
+ * Returns: the count of icons which may still be rendered in this batch.
+ */
+static gint
+theme_icons_load_range( FMAIconChooser *editor, GtkTreeModel *model, gint first, gint last, gint count, gint *next )
+{
+	GtkTreeIter iter;
+	gboolean loaded;
+	gchar *icon_name;
+	GdkPixbuf *pixbuf;
+	gint i;
+
+	i = first;
+
+	if( gtk_tree_model_iter_nth_child( model, &iter, NULL, first )){
+		for( ; count > 0 && ( last < 0 || i <= last ) ; ++i ){
+
+			gtk_tree_model_get( model, &iter,
+					THEME_ICON_LABEL_COLUMN, &icon_name,
+					THEME_ICON_LOADED_COLUMN, &loaded,
+					-1 );
+
+			if( !loaded ){
+				pixbuf = theme_icon_get_pixbuf( icon_name, editor->private->load_width );
+				gtk_list_store_set( GTK_LIST_STORE( model ), &iter,
+						THEME_ICON_PIXBUF_COLUMN, pixbuf,
+						THEME_ICON_LOADED_COLUMN, TRUE,
+						-1 );
+				count -= 1;
+			}
+
+			g_free( icon_name );
+
+			if( !gtk_tree_model_iter_next( model, &iter )){
+				i += 1;
+				break;
+			}
+		}
+	}
+
+	if( next ){
+		*next = i;
+	}
+
+	return( count );
+}
+
+/*
+ * Returns: the rendered icon, from the session cache if it has already
+ * been rendered, or the 'image-missing' icon if it cannot be rendered.
+ *
+ * The returned pixbuf is owned by the cache.
+ */
+static GdkPixbuf *
+theme_icon_get_pixbuf( const gchar *icon_name, gint width )
+{
+	static const gchar *thisfn = "fma_icon_chooser_theme_icon_get_pixbuf";
+	GdkPixbuf *pixbuf;
+	GError *error;
+
+	pixbuf = g_hash_table_lookup( st_icon_cache, icon_name );
+
+	if( !pixbuf ){
+		error = NULL;
+		pixbuf = gtk_icon_theme_load_icon(
+				gtk_icon_theme_get_default(), icon_name, width, GTK_ICON_LOOKUP_GENERIC_FALLBACK, &error );
+		if( !pixbuf ){
+			if( error ){
+				g_warning( "%s: %s", thisfn, error->message );
+				g_error_free( error );
+			}
+			/* Gtk+ has a builtin 'image-missing' icon, so this should
+			 * not fail */
+			pixbuf = gtk_icon_theme_load_icon(
+					gtk_icon_theme_get_default(), "image-missing", width, GTK_ICON_LOOKUP_GENERIC_FALLBACK, NULL );
+			if( !pixbuf ){
+				pixbuf = g_object_ref( theme_icon_get_placeholder( width ));
+			}
+		}
+		g_hash_table_insert( st_icon_cache, g_strdup( icon_name ), pixbuf );
+	}
+
+	return( pixbuf );
+}
+
+/*
+ * a transparent pixbuf, so that the icon view layout does not change
+ * when the icons are rendered
+ */
+static GdkPixbuf *
+theme_icon_get_placeholder( gint width )
+{
+	if( st_placeholder && gdk_pixbuf_get_width( st_placeholder ) != width ){
+		g_object_unref( st_placeholder );
+		st_placeholder = NULL;
+	}
+
+	if( !st_placeholder ){
+		st_placeholder = gdk_pixbuf_new( GDK_COLORSPACE_RGB, TRUE, 8, width, width );
+		gdk_pixbuf_fill( st_placeholder, 0x00000000 );
+	}
+
+	return( st_placeholder );
+}
+
+static void
+on_icon_theme_changed( GtkIconTheme *icon_theme, void *empty )
+{
+	static const gchar *thisfn = "fma_icon_chooser_on_icon_theme_changed";
+
+	g_debug( "%s: icon_theme=%p, clearing the icon cache", thisfn, ( void * ) icon_theme );
+
+	g_hash_table_remove_all( st_icon_cache );
+}
@@ -119,6 +119,7 @@ struct _FMAMainWindowPrivate {
 
 	gulong            pivot_handler_id;
 	FMATimeout        pivot_timeout;
+	gboolean          reload_blocked;
 };
 
 /* properties set against the main window
@@ -149,6 +150,7 @@ static const gchar     *st_toplevel_name          = "MainWindow";
 static const gchar     *st_wsp_name               = IPREFS_MAIN_WINDOW_WSP;
 
 static gint             st_burst_timeout          = 2500;		/* burst timeout in msec */
+static gint             st_burst_max_wait         = 10000;		/* max burst duration in msec */
 static BaseWindowClass *st_parent_class           = NULL;
 static guint            st_signals[ LAST_SIGNAL ] = { 0 };
 
@@ -514,7 +516,7 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	priv->pivot_timeout.timeout = st_burst_timeout;
 	priv->pivot_timeout.handler = ( FMATimeoutFunc ) on_block_items_changed_timeout;
 	priv->pivot_timeout.user_data = self;
-	priv->pivot_timeout.source_id = 0;
+	fma_timeout_set_max_wait( &priv->pivot_timeout, st_burst_max_wait );
 }
 
 static void
@@ -611,6 +613,8 @@ instance_dispose( GObject *window )
 
 		self->private->dispose_has_run = TRUE;
 
+		fma_timeout_cancel( &self->private->pivot_timeout );
+
 		g_object_unref( self->private->clipboard );
 
 		pane = fma_gtk_utils_find_widget_by_name( GTK_CONTAINER( window ), "main-paned" );
@@ -940,6 +944,9 @@ fma_main_window_reload( FMAMainWindow *window )
  * @window: this #FMAMainWindow instance.
  *
  * Temporarily blocks the handling of pivot-items-changed signal.
+ *
+ * The signal stays blocked while items are being saved, and until the
+ * end of the burst of events which follows the last call.
  */
 void
 fma_main_window_block_reload( FMAMainWindow *window )
@@ -950,8 +957,11 @@ fma_main_window_block_reload( FMAMainWindow *window )
 
 	if( !window->private->dispose_has_run ){
 
-		g_debug( "%s: blocking %s signal", thisfn, PIVOT_SIGNAL_ITEMS_CHANGED );
-		g_signal_handler_block( window->private->updater, window->private->pivot_handler_id );
+		if( !window->private->reload_blocked ){
+			g_debug( "%s: blocking %s signal", thisfn, PIVOT_SIGNAL_ITEMS_CHANGED );
+			g_signal_handler_block( window->private->updater, window->private->pivot_handler_id );
+			window->private->reload_blocked = TRUE;
+		}
 		fma_timeout_event( &window->private->pivot_timeout );
 	}
 }
@@ -963,8 +973,16 @@ on_block_items_changed_timeout( FMAMainWindow *window )
 
 	g_return_if_fail( FMA_IS_MAIN_WINDOW( window ));
 
+	/* the save may run longer than the burst: wait for its end
+	 */
+	if( fma_menu_get_data( window )->is_saving ){
+		fma_timeout_event( &window->private->pivot_timeout );
+		return;
+	}
+
 	g_debug( "%s: unblocking %s signal", thisfn, PIVOT_SIGNAL_ITEMS_CHANGED );
 	g_signal_handler_unblock( window->private->updater, window->private->pivot_handler_id );
+	window->private->reload_blocked = FALSE;
 }
 
 /*
@@ -1260,7 +1278,12 @@ fma_main_window_quit( FMAMainWindow *window )
 	if( !window->private->dispose_has_run ){
 		g_debug( "%s: window=%p (%s)", thisfn, ( void * ) window, G_OBJECT_TYPE_NAME( window ));
 
-		if( !window->private->is_tree_modified  || warn_modified( window )){
+		/* do not let the window be destroyed while items are being saved
+		 */
+		if( fma_menu_get_data( window )->is_saving ){
+			g_debug( "%s: save in progress, ignoring quit request", thisfn );
+
+		} else if( !window->private->is_tree_modified  || warn_modified( window )){
 			gtk_widget_destroy( GTK_WIDGET( window ));
 			terminated = TRUE;
 		}
@@ -56,7 +56,22 @@ static gchar *st_save_warning     = N_( "Some items may not have been saved" );
 static gchar *st_level_zero_write = N_( "Unable to rewrite the level-zero items list" );
 static gchar *st_delete_error     = N_( "Some items have not been deleted" );
 
-static gboolean save_item( FMAMainWindow *window, FMAUpdater *updater, FMAObjectItem *item, GSList **messages );
+#define MENU_FILE_SAVE_CONTEXT			"save-context"
+
+/* data used while saving the modified items
+ */
+typedef struct {
+	FMAMainWindow *window;
+	FMAStatusBar  *bar;
+	GHashTable    *providers;		/* item -> provider before the save */
+	GHashTable    *failed;			/* items which have not been saved */
+}
+	SaveData;
+
+static GList   *save_get_modified_rec( GList *modified, FMAObjectItem *item, SaveData *save );
+static void     save_on_progress( const FMAUpdaterProgress *progress, SaveData *save );
+static void     save_item_written( FMAObjectItem *item, FMAIOProvider *provider_before, SaveData *save );
+static gboolean save_has_failed_rec( FMAObjectItem *item, SaveData *save );
 static void     install_autosave( FMAMainWindow *main_window );
 static void     on_autosave_prefs_changed( const gchar *group, const gchar *key, gconstpointer new_value, gpointer user_data );
 static void     on_autosave_prefs_timeout( FMAMainWindow *main_window );
@@ -226,6 +241,12 @@ fma_menu_file_new_profile( FMAMainWindow *main_window )
  *      and reset modified
  *
  * - idem if some items cannot be actually rewritten...
+ *
+ * Modified items are written by the #FMAUpdater from a dedicated
+ * thread, as one transaction per I/O provider: if an item cannot be
+ * written, the other items of the same provider are restored, and all
+ * stay modified. The window is kept insensitive meanwhile, while the
+ * progress is displayed in the status bar.
  */
 void
 fma_menu_file_save_items( FMAMainWindow *window )
@@ -234,15 +255,21 @@ fma_menu_file_save_items( FMAMainWindow *window )
 	sMenuData *sdata;
 	FMATreeView *items_view;
 	GList *items, *it;
-	GList *new_pivot;
-	FMAObjectItem *duplicate;
+	GList *new_pivot, *modified, *failed;
+	FMAObjectItem *duplicate, *origin;
 	GSList *messages;
 	gchar *msg;
+	SaveData save;
 
 	g_debug( "%s: window=%p", thisfn, ( void * ) window );
 
 	sdata = fma_menu_get_data( window );
 
+	if( sdata->is_saving ){
+		g_debug( "%s: a save is already in progress", thisfn );
+		return;
+	}
+
 	/* always write the level zero list of items as the first save phase
 	 * and reset the corresponding modification flag
 	 */
@@ -288,21 +315,71 @@ fma_menu_file_save_items( FMAMainWindow *window )
 		items = fma_tree_view_get_items( items_view );
 	}
 
-	/* recursively save the modified items
-	 * check is useless here if item was not modified, but not very costly;
-	 * above all, it is less costly to check the status here, than to check
-	 * recursively each and every modified item
+	/* collect the modified items, children before their parent,
+	 * and write them as a whole
+	 */
+	save.window = window;
+	save.bar = fma_main_window_get_statusbar( window );
+	save.providers = g_hash_table_new( g_direct_hash, g_direct_equal );
+	save.failed = g_hash_table_new( g_direct_hash, g_direct_equal );
+
+	modified = NULL;
+	for( it = items ; it ; it = it->next ){
+		modified = save_get_modified_rec( modified, FMA_OBJECT_ITEM( it->data ), &save );
+	}
+	modified = g_list_reverse( modified );
+
+	if( modified ){
+		sdata->is_saving = TRUE;
+		gtk_widget_set_sensitive( GTK_WIDGET( window ), FALSE );
+
+		/* the main context keeps running while the items are written:
+		 * do not let the monitors reload the pivot under us
+		 */
+		fma_main_window_block_reload( window );
+
+		fma_updater_write_items( sdata->updater, modified, &failed,
+				( FMAUpdaterProgressFn ) save_on_progress, &save, &messages );
+
+		for( it = failed ; it ; it = it->next ){
+			g_hash_table_add( save.failed, it->data );
+		}
+		for( it = modified ; it ; it = it->next ){
+			if( !g_hash_table_contains( save.failed, it->data )){
+				save_item_written( FMA_OBJECT_ITEM( it->data ),
+						g_hash_table_lookup( save.providers, it->data ), &save );
+			}
+		}
+		g_list_free( failed );
+		g_list_free( modified );
+
+		fma_status_bar_hide_status( save.bar, MENU_FILE_SAVE_CONTEXT );
+		gtk_widget_set_sensitive( GTK_WIDGET( window ), TRUE );
+		sdata->is_saving = FALSE;
+	}
+
+	/* items which have not been saved stay modified: their origin is
+	 * kept as is in the pivot
 	 */
 	new_pivot = NULL;
 
 	for( it = items ; it ; it = it->next ){
-		save_item( window, sdata->updater, FMA_OBJECT_ITEM( it->data ), &messages );
+		if( save_has_failed_rec( FMA_OBJECT_ITEM( it->data ), &save )){
+			origin = ( FMAObjectItem * ) fma_object_get_origin( it->data );
+			if( origin ){
+				new_pivot = g_list_prepend( new_pivot, fma_object_ref( origin ));
+			}
+			continue;
+		}
 		duplicate = FMA_OBJECT_ITEM( fma_object_duplicate( it->data, FMA_DUPLICATE_REC ));
 		fma_object_reset_origin( it->data, duplicate );
 		fma_object_check_status( it->data );
 		new_pivot = g_list_prepend( new_pivot, duplicate );
 	}
 
+	g_hash_table_destroy( save.providers );
+	g_hash_table_destroy( save.failed );
+
 	if( g_slist_length( messages )){
 		msg = fma_core_utils_slist_join_at_end( messages, "\n" );
 		base_window_display_error_dlg( NULL, gettext( st_save_warning ), msg );
@@ -318,58 +395,80 @@ fma_menu_file_save_items( FMAMainWindow *window )
 }
 
 /*
- * iterates here on each and every FMAObjectItem row stored in the tree
+ * iterates here on each and every FMAObjectItem row stored in the tree,
+ * prepending the modified ones to the list, children first
  */
-static gboolean
-save_item( FMAMainWindow *window, FMAUpdater *updater, FMAObjectItem *item, GSList **messages )
+static GList *
+save_get_modified_rec( GList *modified, FMAObjectItem *item, SaveData *save )
 {
-	static const gchar *thisfn = "fma_menu_file_save_item";
-	gboolean ret;
-	FMAIOProvider *provider_before;
-	FMAIOProvider *provider_after;
+	static const gchar *thisfn = "fma_menu_file_save_get_modified_rec";
 	GList *subitems, *it;
 	gchar *label;
-	guint save_ret;
-
-	g_return_val_if_fail( FMA_IS_MAIN_WINDOW( window ), FALSE );
-	g_return_val_if_fail( FMA_IS_UPDATER( updater ), FALSE );
-	g_return_val_if_fail( FMA_IS_OBJECT_ITEM( item ), FALSE );
-
-	ret = TRUE;
 
 	if( FMA_IS_OBJECT_MENU( item )){
 		subitems = fma_object_get_items( item );
 		for( it = subitems ; it ; it = it->next ){
-			ret &= save_item( window, updater, FMA_OBJECT_ITEM( it->data ), messages );
+			modified = save_get_modified_rec( modified, FMA_OBJECT_ITEM( it->data ), save );
 		}
 	}
 
-	provider_before = fma_object_get_provider( item );
-
 	if( fma_object_is_modified( item )){
 		label = fma_object_get_label( item );
 		g_debug( "%s: saving %p (%s) '%s'", thisfn, ( void * ) item, G_OBJECT_TYPE_NAME( item ), label );
 		g_free( label );
 
-		save_ret = fma_updater_write_item( updater, item, messages );
-		ret = ( save_ret == IIO_PROVIDER_CODE_OK );
+		g_hash_table_insert( save->providers, item, fma_object_get_provider( item ));
+		modified = g_list_prepend( modified, item );
+	}
 
-		if( ret ){
-			if( FMA_IS_OBJECT_ACTION( item )){
-				fma_object_reset_last_allocated( item );
-			}
+	return( modified );
+}
 
-			provider_after = fma_object_get_provider( item );
-			if( provider_after != provider_before ){
-				g_signal_emit_by_name( window, MAIN_SIGNAL_ITEM_UPDATED, item, MAIN_DATA_PROVIDER );
-			}
+static void
+save_on_progress( const FMAUpdaterProgress *progress, SaveData *save )
+{
+	gchar *status;
 
-		} else {
-			g_warning( "%s: unable to write item: save_ret=%d", thisfn, save_ret );
+	/* i18n: status bar message while saving: 'Saving modified items… (12/800)' */
+	status = g_strdup_printf( _( "Saving modified items… (%u/%u)" ), progress->done, progress->total );
+	fma_status_bar_display_status( save->bar, MENU_FILE_SAVE_CONTEXT, status );
+	g_free( status );
+}
+
+static void
+save_item_written( FMAObjectItem *item, FMAIOProvider *provider_before, SaveData *save )
+{
+	FMAIOProvider *provider_after;
+
+	if( FMA_IS_OBJECT_ACTION( item )){
+		fma_object_reset_last_allocated( item );
+	}
+
+	provider_after = fma_object_get_provider( item );
+	if( provider_after != provider_before ){
+		g_signal_emit_by_name( save->window, MAIN_SIGNAL_ITEM_UPDATED, item, MAIN_DATA_PROVIDER );
+	}
+}
+
+static gboolean
+save_has_failed_rec( FMAObjectItem *item, SaveData *save )
+{
+	GList *subitems, *it;
+
+	if( g_hash_table_contains( save->failed, item )){
+		return( TRUE );
+	}
+
+	if( FMA_IS_OBJECT_MENU( item )){
+		subitems = fma_object_get_items( item );
+		for( it = subitems ; it ; it = it->next ){
+			if( save_has_failed_rec( FMA_OBJECT_ITEM( it->data ), save )){
+				return( TRUE );
+			}
 		}
 	}
 
-	return( ret );
+	return( FALSE );
 }
 
 /*
@@ -73,6 +73,10 @@ typedef struct {
 	 */
 	gboolean     is_tree_modified;
 
+	/* set while the modified items are being written
+	 */
+	gboolean     is_saving;
+
 	/* set on focus in/out
 	 */
 	gboolean     treeview_has_focus;
@@ -198,7 +198,7 @@ fma_tree_ieditable_initialize( FMATreeIEditable *instance, GtkTreeView *treeview
 	g_signal_connect( treeview, "key-press-event", G_CALLBACK( on_key_pressed_event ), instance );
 
 	/* label edition: inform the corresponding tab */
-	column = gtk_tree_view_get_column( treeview, TREE_COLUMN_LABEL );
+	column = gtk_tree_view_get_column( treeview, TREE_VIEW_COLUMN_LABEL );
 	renderers = gtk_cell_layout_get_cells( GTK_CELL_LAYOUT( column ));
 	g_signal_connect( renderers->data, "edited", G_CALLBACK( on_label_edited ), instance );
 
@@ -306,7 +306,7 @@ on_tree_view_selection_changed( FMATreeIEditable *instance, GList *selected_item
 	ied = ( IEditableData * ) g_object_get_data( G_OBJECT( instance ), VIEW_DATA_IEDITABLE );
 	g_object_get( ied->main_window, MAIN_PROP_ITEM, &object, MAIN_PROP_EDITABLE, &object_editable, NULL );
 	editable = FMA_IS_OBJECT( object ) && object_editable;
-	column = gtk_tree_view_get_column( ied->treeview, TREE_COLUMN_LABEL );
+	column = gtk_tree_view_get_column( ied->treeview, TREE_VIEW_COLUMN_LABEL );
 	renderers = gtk_cell_layout_get_cells( GTK_CELL_LAYOUT( column ));
 	g_object_set( G_OBJECT( renderers->data ), "editable", editable, "editable-set", TRUE, NULL );
 }
@@ -1151,7 +1151,7 @@ inline_edition( FMATreeIEditable *view )
 
 	if( g_list_length( listrows ) == 1 ){
 		path = ( GtkTreePath * ) listrows->data;
-		column = gtk_tree_view_get_column( ied->treeview, TREE_COLUMN_LABEL );
+		column = gtk_tree_view_get_column( ied->treeview, TREE_VIEW_COLUMN_LABEL );
 		gtk_tree_view_set_cursor( ied->treeview, path, column, TRUE );
 	}
 
@@ -60,7 +60,17 @@ struct _FMATreeModelPrivate {
 	guint           mode;
 
 	/* runtime data
+	 * the store is indexed by object and by (lowercase) item id,
+	 * the row references being owned by the object index
 	 */
+	GHashTable     *object_index;
+	GHashTable     *id_index;
+
+	/* icons are only loaded when a row is first rendered, and are
+	 * shared between rows: icon name -> GdkPixbuf
+	 */
+	GHashTable     *icons;
+
 	gboolean        drag_has_profiles;
 	gboolean        drag_highlight;		/* defined for on_drag_motion handler */
 	gboolean        drag_drop;			/* defined for on_drag_motion handler */
@@ -59,26 +59,6 @@ typedef struct {
 }
 	ntmGetItems;
 
-/* when iterating while searching for an object by id
- * setting the iter if found
- */
-typedef struct {
-	gchar       *id;
-	FMAObject   *object;
-	GtkTreeIter *iter;
-}
-	ntmFindId;
-
-/* when iterating while searching for an object by its address
- * setting the iter if found
- */
-typedef struct {
-	const FMAObject *object;
-	GtkTreeIter     *iter;
-	GtkTreePath     *path;
-}
-	ntmFindObject;
-
 /* dump the content of the tree
  */
 typedef struct {
@@ -107,22 +87,26 @@ static void     connect_item_updated_signal( FMATreeModel *tmodel );
 static void     on_settings_order_mode_changed( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, FMATreeModel *model );
 static void     on_main_item_updated( BaseWindow *window, FMAIContext *context, guint data, FMATreeModel *model );
 static void     setup_dnd_edition( FMATreeModel *tmodel );
-static void     append_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent, GtkTreeIter *iter, const FMAObject *object );
+static void     append_item( FMATreeModel *tmodel, GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent, GtkTreeIter *iter, const FMAObject *object );
 static void     display_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *iter, const FMAObject *object );
 static void     display_order_change( FMATreeModel *model, gint order_mode );
 #if 0
 static void     dump( FMATreeModel *model );
 static gboolean dump_store( FMATreeModel *model, GtkTreePath *path, FMAObject *object, ntmDumpStruct *ntm );
 #endif
-static void     fill_tree_store( GtkTreeStore *model, GtkTreeView *treeview, FMAObject *object, GtkTreeIter *parent );
+static void     fill_tree_store( FMATreeModel *tmodel, GtkTreeStore *model, GtkTreeView *treeview, FMAObject *object, GtkTreeIter *parent );
 static gboolean filter_visible( GtkTreeModel *store, GtkTreeIter *iter, FMATreeModel *model );
-static gboolean find_item_iter( FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmFindId *nfo );
-static gboolean find_object_iter( FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmFindObject *nfo );
+static void     index_add( FMATreeModel *model, GtkTreeModel *store, GtkTreeIter *iter, const FMAObject *object );
+static void     index_clear( FMATreeModel *model );
+static gboolean index_get_iter( const FMATreeModel *model, GtkTreeModel *store, const FMAObject *object, GtkTreeIter *iter );
+static void     index_remove( FMATreeModel *model, const FMAObject *object );
+static void     index_rekey( FMATreeModel *model, const FMAObject *object );
+static gboolean index_remove_value( const gchar *key, const FMAObject *indexed, const FMAObject *object );
 static gboolean get_items_iter( const FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmGetItems *ngi );
 static void     iter_on_store( const FMATreeModel *model, GtkTreeModel *store, GtkTreeIter *parent, FnIterOnStore fn, gpointer user_data );
 static gboolean iter_on_store_item( const FMATreeModel *model, GtkTreeModel *store, GtkTreeIter *iter, FnIterOnStore fn, gpointer user_data );
 static void     remove_if_exists( FMATreeModel *model, GtkTreeModel *store, const FMAObject *object );
-static gboolean delete_items_rec( GtkTreeStore *store, GtkTreeIter *iter );
+static gboolean delete_items_rec( FMATreeModel *model, GtkTreeStore *store, GtkTreeIter *iter );
 static gint     sort_actions_list( GtkTreeModel *model, GtkTreeIter *a, GtkTreeIter *b, gpointer user_data );
 
 GType
@@ -235,6 +219,9 @@ instance_init( GTypeInstance *instance, gpointer klass )
 	self->private = g_new0( FMATreeModelPrivate, 1 );
 
 	self->private->dispose_has_run = FALSE;
+	self->private->object_index = g_hash_table_new_full( NULL, NULL, NULL, ( GDestroyNotify ) gtk_tree_row_reference_free );
+	self->private->id_index = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, NULL );
+	self->private->icons = g_hash_table_new_full( g_str_hash, g_str_equal, g_free, ( GDestroyNotify ) g_object_unref );
 }
 
 #if 0
@@ -330,6 +317,7 @@ instance_dispose( GObject *object )
 		self->private->dispose_has_run = TRUE;
 
 		ts_model = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( self )));
+		index_clear( self );
 		gtk_tree_store_clear( ts_model );
 		g_debug( "%s: tree store cleared", thisfn );
 
@@ -354,6 +342,10 @@ instance_finalize( GObject *object )
 
 	self = FMA_TREE_MODEL( object );
 
+	g_hash_table_destroy( self->private->object_index );
+	g_hash_table_destroy( self->private->id_index );
+	g_hash_table_destroy( self->private->icons );
+
 	g_free( self->private );
 
 	/* chain call to parent class */
@@ -381,7 +373,7 @@ fma_tree_model_new( GtkTreeView *treeview )
 
 	/* create the underlying tree store */
 	ts_model = gtk_tree_store_new(
-			TREE_N_COLUMN, GDK_TYPE_PIXBUF, G_TYPE_STRING, FMA_TYPE_OBJECT );
+			TREE_N_COLUMN, G_TYPE_STRING, FMA_TYPE_OBJECT );
 
 	/* create our filter model */
 	model = g_object_new( FMA_TYPE_TREE_MODEL,
@@ -540,6 +532,8 @@ on_main_item_updated( BaseWindow *window, FMAIContext *context, guint data, FMAT
 				data,
 				( void * ) model );
 
+		index_rekey( model, FMA_OBJECT( context ));
+
 		if( data & ( MAIN_DATA_LABEL | MAIN_DATA_ICON )){
 			path = fma_tree_model_object_to_path( model, ( FMAObject * ) context );
 			if( path ){
@@ -636,7 +630,7 @@ fma_tree_model_delete( FMATreeModel *model, FMAObject *object )
 			 */
 			store = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
 			if( gtk_tree_model_get_iter( GTK_TREE_MODEL( store ), &iter, path )){
-				delete_items_rec( store, &iter );
+				delete_items_rec( model, store, &iter );
 			}
 		}
 	}
@@ -656,6 +650,10 @@ fma_tree_model_delete( FMATreeModel *model, FMAObject *object )
  * We enter with the GSList owned by FMAPivot which contains the ordered
  * list of level-zero items. We want have a duplicate of this list in
  * tree store, so that we are able to freely edit it.
+ *
+ * The store is left unsorted while it is filled, and only sorted once
+ * at the end; icons are not loaded here, but when the rows are first
+ * rendered (see fma_tree_model_get_icon()).
  */
 void
 fma_tree_model_fill( FMATreeModel *model, GList *items )
@@ -673,14 +671,21 @@ fma_tree_model_fill( FMATreeModel *model, GList *items )
 	if( !model->private->dispose_has_run ){
 
 		ts_model = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
+		index_clear( model );
 		gtk_tree_store_clear( ts_model );
 
+		gtk_tree_sortable_set_sort_column_id( GTK_TREE_SORTABLE( ts_model ),
+				GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID, 0 );
+
 		for( it = items ; it ; it = it->next ){
 			duplicate = ( FMAObject * ) fma_object_duplicate( it->data, FMA_DUPLICATE_REC );
 			fma_object_check_status( duplicate );
-			fill_tree_store( ts_model, model->private->treeview, duplicate, NULL );
+			fill_tree_store( model, ts_model, model->private->treeview, duplicate, NULL );
 			fma_object_unref( duplicate );
 		}
+
+		display_order_change( model,
+				GPOINTER_TO_INT( g_object_get_data( G_OBJECT( ts_model ), TREE_MODEL_ORDER_MODE )));
 	}
 }
 
@@ -771,6 +776,7 @@ fma_tree_model_insert_before( FMATreeModel *model, const FMAObject *object, GtkT
 				has_parent ? &parent_iter : NULL,
 				has_sibling ? &sibling_iter : NULL );
 		gtk_tree_store_set( GTK_TREE_STORE( store ), &iter, TREE_COLUMN_NAOBJECT, object, -1 );
+		index_add( model, store, &iter, object );
 		display_item( GTK_TREE_STORE( store ), model->private->treeview, &iter, object );
 
 		inserted_path = gtk_tree_model_get_path( store, &iter );
@@ -836,6 +842,7 @@ fma_tree_model_insert_into( FMATreeModel *model, const FMAObject *object, GtkTre
 
 		gtk_tree_store_insert_after( GTK_TREE_STORE( store ), &iter, &parent_iter, NULL );
 		gtk_tree_store_set( GTK_TREE_STORE( store ), &iter, TREE_COLUMN_NAOBJECT, object, -1 );
+		index_add( model, store, &iter, object );
 		display_item( GTK_TREE_STORE( store ), model->private->treeview, &iter, object );
 
 		new_path = gtk_tree_model_get_path( store, &iter );
@@ -862,22 +869,22 @@ FMAObjectItem *
 fma_tree_model_get_item_by_id( const FMATreeModel *model, const gchar *id )
 {
 	static const gchar *thisfn = "fma_tree_model_get_item_by_id";
-	GtkTreeStore *store;
-	ntmFindId nfi;
+	FMAObject *object;
+	gchar *key;
 
 	g_return_val_if_fail( FMA_IS_TREE_MODEL( model ), NULL );
 
-	nfi.object = NULL;
+	object = NULL;
 
 	if( !model->private->dispose_has_run ){
 		g_debug( "%s: model=%p, id=%s", thisfn, ( void * ) model, id );
 
-		nfi.id = ( gchar * ) id;
-		store = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
-		iter_on_store( model, GTK_TREE_MODEL( store ), NULL, ( FnIterOnStore ) find_item_iter, &nfi );
+		key = g_ascii_strdown( id, -1 );
+		object = g_hash_table_lookup( model->private->id_index, key );
+		g_free( key );
 	}
 
-	return(( FMAObjectItem * ) nfi.object );
+	return(( FMAObjectItem * ) object );
 }
 
 /**
@@ -960,52 +967,101 @@ GtkTreePath *
 fma_tree_model_object_to_path( const FMATreeModel *model, const FMAObject *object )
 {
 	static const gchar *thisfn = "fma_tree_model_object_to_path";
-	ntmFindObject nfo;
-	GtkTreeIter iter;
-	GtkTreeStore *store;
+	GtkTreeRowReference *ref;
+	GtkTreePath *path;
 
 	g_return_val_if_fail( FMA_IS_TREE_MODEL( model ), NULL );
 
-	nfo.path = NULL;
+	path = NULL;
 
 	if( !model->private->dispose_has_run ){
 		g_debug( "%s: model=%p, object=%p (%s)",
 				thisfn, ( void * ) model, ( void * ) object, G_OBJECT_TYPE_NAME( object ));
 
-		nfo.object = object;
-		nfo.iter = &iter;
+		ref = g_hash_table_lookup( model->private->object_index, object );
+		if( ref ){
+			path = gtk_tree_row_reference_get_path( ref );
+		}
+	}
 
-		store = GTK_TREE_STORE( gtk_tree_model_filter_get_model( GTK_TREE_MODEL_FILTER( model )));
-		iter_on_store( model, GTK_TREE_MODEL( store ), NULL, ( FnIterOnStore ) find_object_iter, &nfo );
+	return( path );
+}
+
+/**
+ * fma_tree_model_get_icon:
+ * @model: this #FMATreeModel.
+ * @object: a #FMAObject stored in the model.
+ *
+ * Returns: the icon of @object, loaded on the first request for its
+ * name, or %NULL if @object is not a #FMAObjectItem.
+ *
+ * The returned pixbuf is owned by the @model, and should not be released
+ * by the caller.
+ */
+GdkPixbuf *
+fma_tree_model_get_icon( FMATreeModel *model, const FMAObject *object )
+{
+	GdkPixbuf *icon;
+	gchar *icon_name;
+
+	g_return_val_if_fail( FMA_IS_TREE_MODEL( model ), NULL );
+
+	icon = NULL;
+
+	if( !model->private->dispose_has_run && FMA_IS_OBJECT_ITEM( object )){
+
+		icon_name = fma_object_get_icon( object );
+		if( !icon_name ){
+			icon_name = g_strdup( "" );
+		}
+
+		icon = g_hash_table_lookup( model->private->icons, icon_name );
+		if( !icon ){
+			icon = base_gtk_utils_get_pixbuf( icon_name, GTK_WIDGET( model->private->treeview ), GTK_ICON_SIZE_MENU );
+			if( icon ){
+				g_hash_table_insert( model->private->icons, icon_name, icon );
+				icon_name = NULL;
+			}
+		}
+
+		g_free( icon_name );
 	}
 
-	return( nfo.path );
+	return( icon );
 }
 
+/*
+ * the row is inserted with all its data at once, so that only one
+ * 'row-inserted' signal is emitted
+ */
 static void
-append_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent, GtkTreeIter *iter, const FMAObject *object )
+append_item( FMATreeModel *tmodel, GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *parent, GtkTreeIter *iter, const FMAObject *object )
 {
+	gchar *label;
+
 	/*g_debug( "fma_tree_model_append_item: object=%p (ref_count=%d), parent=%p",
 					( void * ) object, G_OBJECT( object )->ref_count, ( void * ) parent );*/
 
-	gtk_tree_store_append( model, iter, parent );
-	gtk_tree_store_set( model, iter, TREE_COLUMN_NAOBJECT, object, -1 );
-	display_item( model, treeview, iter, object );
+	label = fma_object_get_label( object );
+	gtk_tree_store_insert_with_values( model, iter, parent, -1,
+			TREE_COLUMN_NAOBJECT, object,
+			TREE_COLUMN_LABEL, label,
+			-1 );
+	g_free( label );
+
+	index_add( tmodel, GTK_TREE_MODEL( model ), iter, object );
 }
 
+/*
+ * the icon is not stored in the row, but got from the model icon cache
+ * by the view when the row is rendered
+ */
 static void
 display_item( GtkTreeStore *model, GtkTreeView *treeview, GtkTreeIter *iter, const FMAObject *object )
 {
 	gchar *label = fma_object_get_label( object );
 	gtk_tree_store_set( model, iter, TREE_COLUMN_LABEL, label, -1 );
 	g_free( label );
-
-	if( FMA_IS_OBJECT_ITEM( object )){
-		gchar *icon_name = fma_object_get_icon( object );
-		GdkPixbuf *icon = base_gtk_utils_get_pixbuf( icon_name, GTK_WIDGET( treeview ), GTK_ICON_SIZE_MENU );
-		gtk_tree_store_set( model, iter, TREE_COLUMN_ICON, icon, -1 );
-		g_object_unref( icon );
-	}
 }
 
 /*
@@ -1107,7 +1163,7 @@ dump_store( FMATreeModel *model, GtkTreePath *path, FMAObject *object, ntmDumpSt
 #endif
 
 static void
-fill_tree_store( GtkTreeStore *model, GtkTreeView *treeview, FMAObject *object, GtkTreeIter *parent )
+fill_tree_store( FMATreeModel *tmodel, GtkTreeStore *model, GtkTreeView *treeview, FMAObject *object, GtkTreeIter *parent )
 {
 	static const gchar *thisfn = "fma_tree_model_fill_tree_store";
 	GList *subitems, *it;
@@ -1119,15 +1175,15 @@ fill_tree_store( GtkTreeStore *model, GtkTreeView *treeview, FMAObject *object,
 	/* an action or a menu
 	 */
 	if( FMA_IS_OBJECT_ITEM( object )){
-		append_item( model, treeview, parent, &iter, object );
+		append_item( tmodel, model, treeview, parent, &iter, object );
 		subitems = fma_object_get_items( object );
 		for( it = subitems ; it ; it = it->next ){
-			fill_tree_store( model, treeview, it->data, &iter );
+			fill_tree_store( tmodel, model, treeview, it->data, &iter );
 		}
 
 	} else {
 		g_return_if_fail( FMA_IS_OBJECT_PROFILE( object ));
-		append_item( model, treeview, parent, &iter, object );
+		append_item( tmodel, model, treeview, parent, &iter, object );
 	}
 
 	/*g_debug( "%s quitting: object=%p (%s, ref_count=%d)", thisfn,
@@ -1178,58 +1234,129 @@ filter_visible( GtkTreeModel *store, GtkTreeIter *iter, FMATreeModel *model )
 }
 
 /*
- * search for an object, given its id
+ * Builds the tree by iterating on the store
+ * we may want selected, modified or both, or a combination of these modes
+ *
+ * This function is called from iter_on_store_item();
  */
 static gboolean
-find_item_iter( FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmFindId *nfi )
+get_items_iter( const FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmGetItems *ngi )
 {
+	if( ngi->mode & TREE_LIST_ALL ){
+		if( gtk_tree_path_get_depth( path ) == 1 ){
+			ngi->items = g_list_prepend( ngi->items, fma_object_ref( object ));
+		}
+	}
+
+	/* don't stop iteration */
+	return( FALSE );
+}
+
+/*
+ * index the row which has just been set at @iter in the store
+ */
+static void
+index_add( FMATreeModel *model, GtkTreeModel *store, GtkTreeIter *iter, const FMAObject *object )
+{
+	GtkTreePath *path;
 	gchar *id;
-	gboolean found = FALSE;
+
+	path = gtk_tree_model_get_path( store, iter );
+	g_hash_table_insert( model->private->object_index,
+			( gpointer ) object, gtk_tree_row_reference_new( store, path ));
+	gtk_tree_path_free( path );
 
 	if( FMA_IS_OBJECT_ITEM( object )){
 		id = fma_object_get_id( object );
-		found = ( g_ascii_strcasecmp( id, nfi->id ) == 0 );
+		g_hash_table_insert( model->private->id_index, g_ascii_strdown( id, -1 ), ( gpointer ) object );
 		g_free( id );
+	}
+}
+
+static void
+index_clear( FMATreeModel *model )
+{
+	g_hash_table_remove_all( model->private->id_index );
+	g_hash_table_remove_all( model->private->object_index );
+}
+
+static gboolean
+index_get_iter( const FMATreeModel *model, GtkTreeModel *store, const FMAObject *object, GtkTreeIter *iter )
+{
+	GtkTreeRowReference *ref;
+	GtkTreePath *path;
+	gboolean found;
+
+	found = FALSE;
+	ref = g_hash_table_lookup( model->private->object_index, object );
 
-		if( found ){
-			nfi->object = object;
+	if( ref ){
+		path = gtk_tree_row_reference_get_path( ref );
+		if( path ){
+			found = gtk_tree_model_get_iter( store, iter, path );
+			gtk_tree_path_free( path );
 		}
 	}
 
-	/* stop iteration if found */
 	return( found );
 }
 
-static gboolean
-find_object_iter( FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmFindObject *nfo )
+/*
+ * the row of @object is about to be removed from the store
+ */
+static void
+index_remove( FMATreeModel *model, const FMAObject *object )
 {
-	if( object == nfo->object ){
-		if( gtk_tree_model_get_iter( GTK_TREE_MODEL( store ), nfo->iter, path )){
-			nfo->path = gtk_tree_path_copy( path );
+	gchar *id, *key;
+
+	if( FMA_IS_OBJECT_ITEM( object )){
+		id = fma_object_get_id( object );
+		key = g_ascii_strdown( id, -1 );
+		if( g_hash_table_lookup( model->private->id_index, key ) == object ){
+			g_hash_table_remove( model->private->id_index, key );
+
+		/* the item may have been renamed since it has been indexed */
+		} else {
+			g_hash_table_foreach_remove( model->private->id_index, ( GHRFunc ) index_remove_value, ( gpointer ) object );
 		}
+		g_free( key );
+		g_free( id );
 	}
 
-	/* stop iteration when found */
-	return( nfo->path != NULL );
+	g_hash_table_remove( model->private->object_index, object );
 }
 
 /*
- * Builds the tree by iterating on the store
- * we may want selected, modified or both, or a combination of these modes
- *
- * This function is called from iter_on_store_item();
+ * the id of an item which is in the store may be changed: move its
+ * entry to its new id; an update which doesn't touch the id only costs
+ * a lookup
  */
-static gboolean
-get_items_iter( const FMATreeModel *model, GtkTreeStore *store, GtkTreePath *path, FMAObject *object, ntmGetItems *ngi )
+static void
+index_rekey( FMATreeModel *model, const FMAObject *object )
 {
-	if( ngi->mode & TREE_LIST_ALL ){
-		if( gtk_tree_path_get_depth( path ) == 1 ){
-			ngi->items = g_list_prepend( ngi->items, fma_object_ref( object ));
+	gchar *id, *key;
+
+	if( FMA_IS_OBJECT_ITEM( object ) &&
+			g_hash_table_lookup( model->private->object_index, object )){
+
+		id = fma_object_get_id( object );
+		key = g_ascii_strdown( id, -1 );
+
+		if( g_hash_table_lookup( model->private->id_index, key ) != object ){
+			g_hash_table_foreach_remove( model->private->id_index, ( GHRFunc ) index_remove_value, ( gpointer ) object );
+			g_hash_table_insert( model->private->id_index, key, ( gpointer ) object );
+			key = NULL;
 		}
+
+		g_free( key );
+		g_free( id );
 	}
+}
 
-	/* don't stop iteration */
-	return( FALSE );
+static gboolean
+index_remove_value( const gchar *key, const FMAObject *indexed, const FMAObject *object )
+{
+	return( indexed == object );
 }
 
 static void
@@ -1283,24 +1410,22 @@ iter_on_store_item( const FMATreeModel *model, GtkTreeModel *store, GtkTreeIter
 static void
 remove_if_exists( FMATreeModel *model, GtkTreeModel *store, const FMAObject *object )
 {
-	ntmFindId nfi;
+	gchar *id;
+	FMAObjectItem *exist;
 	GtkTreeIter iter;
 
 	if( FMA_IS_OBJECT_ITEM( object )){
 
-		nfi.id = fma_object_get_id( object );
-		nfi.object = NULL;
-		nfi.iter = &iter;
-
-		iter_on_store( model, store, NULL, ( FnIterOnStore ) find_item_iter, &nfi );
+		id = fma_object_get_id( object );
+		exist = fma_tree_model_get_item_by_id( model, id );
 
-		if( nfi.object ){
+		if( exist && index_get_iter( model, store, FMA_OBJECT( exist ), &iter )){
 			g_debug( "fma_tree_model_remove_if_exists: removing %s %p",
 					G_OBJECT_TYPE_NAME( object ), ( void * ) object );
-			gtk_tree_store_remove( GTK_TREE_STORE( store ), nfi.iter );
+			delete_items_rec( model, GTK_TREE_STORE( store ), &iter );
 		}
 
-		g_free( nfi.id );
+		g_free( id );
 	}
 }
 
@@ -1309,14 +1434,22 @@ remove_if_exists( FMATreeModel *model, GtkTreeModel *store, const FMAObject *obj
  * returns TRUE if iter is always valid after the remove
  */
 static gboolean
-delete_items_rec( GtkTreeStore *store, GtkTreeIter *iter )
+delete_items_rec( FMATreeModel *model, GtkTreeStore *store, GtkTreeIter *iter )
 {
 	GtkTreeIter child;
 	gboolean valid;
+	FMAObject *object;
 
 	while( gtk_tree_model_iter_children( GTK_TREE_MODEL( store ), &child, iter )){
-		delete_items_rec( store, &child );
+		delete_items_rec( model, store, &child );
+	}
+
+	gtk_tree_model_get( GTK_TREE_MODEL( store ), iter, TREE_COLUMN_NAOBJECT, &object, -1 );
+	if( object ){
+		index_remove( model, object );
+		g_object_unref( object );
 	}
+
 	valid = gtk_tree_store_remove( store, iter );
 
 	return( valid );
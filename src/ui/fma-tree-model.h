@@ -73,11 +73,13 @@ typedef struct {
 	FMATreeModelClass;
 
 /**
- * Column ordering in the tree view
+ * Column ordering in the tree store
+ *
+ * Icons are not stored in the rows: they are got from the model by the
+ * view when a row is rendered (see fma_tree_model_get_icon()).
  */
 enum {
-	TREE_COLUMN_ICON = 0,
-	TREE_COLUMN_LABEL,
+	TREE_COLUMN_LABEL = 0,
 	TREE_COLUMN_NAOBJECT,
 	TREE_N_COLUMN
 };
@@ -118,6 +120,9 @@ FMAObject     *fma_tree_model_object_at_path  ( const FMATreeModel *model,
 GtkTreePath   *fma_tree_model_object_to_path  ( const FMATreeModel *model,
 														const FMAObject *object );
 
+GdkPixbuf     *fma_tree_model_get_icon        ( FMATreeModel *model,
+														const FMAObject *object );
+
 G_END_DECLS
 
 #endif /* __UI_FMA_TREE_MODEL_H__ */
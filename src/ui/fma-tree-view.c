@@ -108,6 +108,7 @@ static void       on_selection_changed( GtkTreeSelection *selection, FMATreeView
 static void       on_tree_view_realized( FMATreeView *treeview, void *empty );
 static void       clear_selection( FMATreeView *view );
 static void       on_selection_changed_cleanup_handler( FMATreeView *tview, GList *selected_items );
+static void       display_icon( GtkTreeViewColumn *column, GtkCellRenderer *cell, GtkTreeModel *model, GtkTreeIter *iter, FMATreeView *view );
 static void       display_label( GtkTreeViewColumn *column, GtkCellRenderer *cell, GtkTreeModel *model, GtkTreeIter *iter, FMATreeView *view );
 static void       extend_selection_to_children( FMATreeView *view, GtkTreeModel *model, GtkTreeIter *parent );
 static GList     *get_selected_items( FMATreeView *view );
@@ -500,11 +501,13 @@ initialize_gtk( FMATreeView *view )
 
 	/* create visible columns on the tree view
 	 */
+	renderer = gtk_cell_renderer_pixbuf_new();
 	column = gtk_tree_view_column_new_with_attributes(
 			"icon",
-			gtk_cell_renderer_pixbuf_new(),
-			"pixbuf", TREE_COLUMN_ICON,
+			renderer,
 			NULL );
+	gtk_tree_view_column_set_cell_data_func(
+			column, renderer, ( GtkTreeCellDataFunc ) display_icon, view, NULL );
 	gtk_tree_view_append_column( GTK_TREE_VIEW( tview ), column );
 
 	renderer = gtk_cell_renderer_text_new();
@@ -585,7 +588,7 @@ fma_tree_view_set_edition_mode( FMATreeView *view, guint mode )
 			/* main window */
 			case TREE_MODE_EDITION:
 
-				column = gtk_tree_view_get_column( priv->tree_view, TREE_COLUMN_LABEL );
+				column = gtk_tree_view_get_column( priv->tree_view, TREE_VIEW_COLUMN_LABEL );
 				renderers = gtk_cell_layout_get_cells( GTK_CELL_LAYOUT( column ));
 				renderer = GTK_CELL_RENDERER( renderers->data );
 				gtk_tree_view_column_set_cell_data_func(
@@ -1007,6 +1010,26 @@ on_selection_changed_cleanup_handler( FMATreeView *tview, GList *selected_items
 	fma_object_free_items( selected_items );
 }
 
+/*
+ * icons are loaded by the model when the row is first rendered
+ */
+static void
+display_icon( GtkTreeViewColumn *column, GtkCellRenderer *cell, GtkTreeModel *model, GtkTreeIter *iter, FMATreeView *view )
+{
+	FMAObject *object;
+	GdkPixbuf *icon;
+
+	icon = NULL;
+	gtk_tree_model_get( model, iter, TREE_COLUMN_NAOBJECT, &object, -1 );
+
+	if( object ){
+		g_object_unref( object );
+		icon = fma_tree_model_get_icon( FMA_TREE_MODEL( model ), object );
+	}
+
+	g_object_set( cell, "pixbuf", icon, NULL );
+}
+
 /*
  * item modified: italic
  * item not saveable (invalid): red
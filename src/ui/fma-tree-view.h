@@ -105,6 +105,14 @@ enum {
 	TREE_LIST_DELETED  = 1<<8,
 };
 
+/**
+ * Column ordering in the tree view
+ */
+enum {
+	TREE_VIEW_COLUMN_ICON = 0,
+	TREE_VIEW_COLUMN_LABEL,
+};
+
 GType          fma_tree_view_get_type          ( void );
 
 FMATreeView   *fma_tree_view_new               ( FMAMainWindow *main_window );
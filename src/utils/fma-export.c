@@ -0,0 +1,307 @@
+/*
+ * FileManager-Actions
+ * A file-manager extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * FileManager-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * FileManager-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileManager-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <glib.h>
+#include <glib/gi18n.h>
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <api/fma-core-utils.h>
+#include <api/fma-object-api.h>
+
+#include <core/fma-export-bulk.h>
+#include <core/fma-exporter.h>
+
+#include "console-utils.h"
+
+static gchar    **ids              = NULL;
+static gboolean   all              = FALSE;
+static gchar     *format           = "";
+static gchar     *folder           = "";
+static gint       jobs             = 0;
+static gboolean   quiet            = FALSE;
+static gboolean   version          = FALSE;
+
+/* i18n: filemanager-actions-export program summary */
+static const gchar *program_summary = N_( "Export menus and actions to a folder." );
+
+static GOptionEntry entries[] = {
+
+	{ "id"                   , 'i', 0, G_OPTION_ARG_STRING_ARRAY  , &ids,
+			N_( "The identifier of a menu or an action to be exported; may be specified several times" ), N_( "<STRING>" ) },
+	{ "all"                  , 'a', 0, G_OPTION_ARG_NONE          , &all,
+			N_( "Export all menus and actions" ), NULL },
+	{ "format"               , 'f', 0, G_OPTION_ARG_STRING        , &format,
+	/* i18n: “Desktop1” here is the internal identifier of an export format; it is not translatable */
+			N_( "An export format [Desktop1]" ), N_( "<STRING>" ) },
+	{ "folder"               , 'o', 0, G_OPTION_ARG_FILENAME      , &folder,
+			N_( "The target folder" ), N_( "<PATH>" ) },
+	{ "jobs"                 , 'j', 0, G_OPTION_ARG_INT           , &jobs,
+			N_( "The count of parallel workers [one per processor]" ), N_( "<INT>" ) },
+	{ NULL }
+};
+
+static GOptionEntry misc_entries[] = {
+
+	{ "quiet"                , 'q', 0, G_OPTION_ARG_NONE        , &quiet,
+			N_( "Do not display the progress" ), NULL },
+	{ "version"              , 'v', 0, G_OPTION_ARG_NONE        , &version,
+			N_( "Output the version number" ), NULL },
+	{ NULL }
+};
+
+static FMAPivot *pivot = NULL;
+
+static GOptionContext  *init_options( void );
+static GList           *get_all_jobs( GList *items, GList *list );
+static void             on_progress( const FMAExportBulkProgress *progress, void *empty );
+static void             exit_with_usage( void );
+
+int
+main( int argc, char** argv )
+{
+	int status = EXIT_SUCCESS;
+	GOptionContext *context;
+	GError *error = NULL;
+	gchar *help;
+	gint errors;
+	GList *list, *it;
+	FMAObjectItem *item;
+	FMAExportBulkJob *job;
+	gchar *folder_uri;
+	GSList *is;
+	guint i;
+
+#if !GLIB_CHECK_VERSION( 2,36, 0 )
+	g_type_init();
+#endif
+
+	setlocale( LC_ALL, "" );
+	console_init_log_handler();
+
+	context = init_options();
+
+	if( argc == 1 ){
+		g_set_prgname( argv[0] );
+		help = g_option_context_get_help( context, FALSE, NULL );
+		g_print( "\n%s", help );
+		g_free( help );
+		exit( status );
+	}
+
+	if( !g_option_context_parse( context, &argc, &argv, &error )){
+		g_printerr( _( "Syntax error: %s\n" ), error->message );
+		g_error_free (error);
+		exit_with_usage();
+	}
+
+	g_option_context_free( context );
+
+	if( version ){
+		fma_core_utils_print_version();
+		exit( status );
+	}
+
+	errors = 0;
+
+	if( !all && ( !ids || !ids[0] )){
+		g_printerr( _( "Error: a menu or action id, or --all, is mandatory.\n" ));
+		errors += 1;
+	}
+
+	if( !folder || !strlen( folder )){
+		g_printerr( _( "Error: the target folder is mandatory.\n" ));
+		errors += 1;
+
+	} else if( !g_file_test( folder, G_FILE_TEST_IS_DIR )){
+		g_printerr( _( "Error: %s: not a folder.\n" ), folder );
+		errors += 1;
+	}
+
+	if( jobs < 0 ){
+		g_printerr( _( "Error: the count of workers must be positive.\n" ));
+		errors += 1;
+	}
+
+	if( !format || !strlen( format )){
+		format = "Desktop1";
+	}
+
+	if( errors ){
+		exit_with_usage();
+	}
+
+	pivot = fma_pivot_new();
+	fma_pivot_set_loadable( pivot, PIVOT_LOAD_ALL );
+	fma_pivot_load_items( pivot );
+
+	if( !fma_exporter_find_for_format( pivot, format )){
+		/* i18n: %s stands for the id of the export format, and is not translatable */
+		g_printerr( _( "Error: %s: unknown export format.\n" ), format );
+		exit_with_usage();
+	}
+
+	list = NULL;
+
+	if( all ){
+		list = get_all_jobs( fma_pivot_get_items( pivot ), NULL );
+
+	} else {
+		for( i = 0 ; ids[i] ; ++i ){
+			item = fma_pivot_get_item( pivot, ids[i] );
+			if( item ){
+				list = g_list_prepend( list, fma_export_bulk_job_new( item, format ));
+			} else {
+				g_printerr( _( "Error: item “%s” doesn’t exist.\n" ), ids[i] );
+				errors += 1;
+			}
+		}
+	}
+
+	if( errors ){
+		g_list_free_full( list, ( GDestroyNotify ) fma_export_bulk_job_free );
+		exit_with_usage();
+	}
+
+	list = g_list_reverse( list );
+	folder_uri = g_filename_to_uri( folder, NULL, NULL );
+
+	if( !folder_uri ){
+		folder_uri = g_strdup_printf( "file://%s", folder );
+	}
+
+	if( fma_export_bulk_run( pivot, list, folder_uri, jobs, quiet ? NULL : on_progress, NULL )){
+		status = EXIT_FAILURE;
+	}
+
+	for( it = list ; it ; it = it->next ){
+		job = ( FMAExportBulkJob * ) it->data;
+		if( job->fname ){
+			if( !quiet ){
+				g_print( "%s\n", job->fname );
+			}
+		} else {
+			for( is = job->msg ; is ; is = is->next ){
+				g_printerr( "%s\n", ( const gchar * ) is->data );
+			}
+		}
+	}
+
+	g_free( folder_uri );
+	g_list_free_full( list, ( GDestroyNotify ) fma_export_bulk_job_free );
+	g_object_unref( pivot );
+
+	exit( status );
+}
+
+/*
+ * init options context
+ */
+static GOptionContext *
+init_options( void )
+{
+	GOptionContext *context;
+	gchar* description;
+	GOptionGroup *misc_group;
+
+	context = g_option_context_new( program_summary );
+	g_option_context_set_translation_domain( context, GETTEXT_PACKAGE );
+
+#ifdef ENABLE_NLS
+	bindtextdomain( GETTEXT_PACKAGE, GNOMELOCALEDIR );
+# ifdef HAVE_BIND_TEXTDOMAIN_CODESET
+	bind_textdomain_codeset( GETTEXT_PACKAGE, "UTF-8" );
+# endif
+	textdomain( GETTEXT_PACKAGE );
+	g_option_context_add_main_entries( context, entries, GETTEXT_PACKAGE );
+#else
+	g_option_context_add_main_entries( context, entries, NULL );
+#endif
+
+	description = console_cmdline_get_description();
+	g_option_context_set_description( context, description );
+	g_free( description );
+
+	misc_group = g_option_group_new(
+			"misc", _( "Miscellaneous options" ), _( "Miscellaneous options" ), NULL, NULL );
+	g_option_group_add_entries( misc_group, misc_entries );
+	g_option_group_set_translation_domain( misc_group, GETTEXT_PACKAGE );
+	g_option_context_add_group( context, misc_group );
+
+	return( context );
+}
+
+/*
+ * walk through the whole tree, so that each menu and each action gets
+ * its own job; the returned list is built in reverse order
+ */
+static GList *
+get_all_jobs( GList *items, GList *list )
+{
+	GList *it;
+
+	for( it = items ; it ; it = it->next ){
+		list = g_list_prepend( list, fma_export_bulk_job_new( FMA_OBJECT_ITEM( it->data ), format ));
+
+		if( FMA_IS_OBJECT_MENU( it->data )){
+			list = get_all_jobs( fma_object_get_items( it->data ), list );
+		}
+	}
+
+	return( list );
+}
+
+/*
+ * display the progress on stderr, so that stdout only lists the
+ * exported files
+ */
+static void
+on_progress( const FMAExportBulkProgress *progress, void *empty )
+{
+	g_printerr( "\r%u/%u (%.1f items/s)", progress->done, progress->total, fma_export_bulk_throughput( progress ));
+
+	if( progress->done == progress->total ){
+		g_printerr( "\n" );
+	}
+}
+
+/*
+ * print a help message and exit with failure
+ */
+static void
+exit_with_usage( void )
+{
+	g_printerr( _( "Try %s --help for usage.\n" ), g_get_prgname());
+	exit( EXIT_FAILURE );
+}
@@ -34,9 +34,11 @@
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <glib/gprintf.h>
+#include <gio/gunixoutputstream.h>
 #include <locale.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <api/fma-core-utils.h>
 #include <api/fma-object-api.h>
@@ -198,9 +200,8 @@ get_item( const gchar *id )
 
 	pivot = fma_pivot_new();
 	fma_pivot_set_loadable( pivot, PIVOT_LOAD_ALL );
-	fma_pivot_load_items( pivot );
 
-	item = fma_pivot_get_item( pivot, id );
+	item = fma_pivot_load_item_by_id( pivot, id );
 
 	if( !item ){
 		g_printerr( _( "Error: item “%s” doesn’t exist.\n" ), id );
@@ -211,24 +212,31 @@ get_item( const gchar *id )
 
 /*
  * displays the specified item on stdout, in the specified export format
+ *
+ * the item is directly streamed to stdout, without being first fully
+ * serialized in memory
  */
 static void
 export_item( const FMAObjectItem *item, const gchar *format )
 {
 	GSList *messages = NULL;
 	GSList *it;
+	GList *items;
+	GOutputStream *stream;
+
+	items = g_list_prepend( NULL, ( gpointer ) item );
+	stream = g_unix_output_stream_new( STDOUT_FILENO, FALSE );
+
+	fma_exporter_to_stream( pivot, items, FALSE, stream, format, &messages );
 
-	gchar *buffer = fma_exporter_to_buffer( pivot, item, format, &messages );
+	g_output_stream_flush( stream, NULL, NULL );
+	g_object_unref( stream );
+	g_list_free( items );
 
 	for( it = messages ; it ; it = it->next ){
 		g_printerr( "%s\n", ( const gchar * ) it->data );
 	}
 	fma_core_utils_slist_free( messages );
-
-	if( buffer ){
-		g_printf( "%s\n", buffer );
-		g_free( buffer );
-	}
 }
 
 /*
@@ -0,0 +1,278 @@
+/*
+ * FileManager-Actions
+ * A file-manager extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * FileManager-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * FileManager-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileManager-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <glib.h>
+#include <glib/gi18n.h>
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <api/fma-dbus.h>
+
+#include <core/fma-gconf-migration.h>
+#include <core/fma-pivot.h>
+#include <core/fma-selected-info.h>
+#include <core/fma-settings.h>
+
+#include "console-utils.h"
+#include "fma-run-utils.h"
+#include "fma-run-daemon-bindings.h"
+
+/* the daemon keeps the items loaded between two requests, reloading
+ * them when they change, and exits after some idle time
+ */
+typedef struct {
+	GMainLoop           *loop;
+	FMAPivot            *pivot;
+	FMARunGDBusActions1 *skeleton;
+	guint                idle_id;
+}
+	sDaemon;
+
+static void     on_bus_acquired( GDBusConnection *connection, const gchar *name, sDaemon *daemon );
+static void     on_name_lost( GDBusConnection *connection, const gchar *name, sDaemon *daemon );
+static gboolean on_handle_run_action( FMARunGDBusActions1 *skeleton, GDBusMethodInvocation *invocation, const gchar *id, const gchar *const *uris, const gchar *const *mimetypes, const gchar *cwd, const gchar *const *environment, sDaemon *daemon );
+static gboolean on_handle_run_action_for_infos( FMARunGDBusActions1 *skeleton, GDBusMethodInvocation *invocation, const gchar *id, GVariant *infos, const gchar *cwd, const gchar *const *environment, sDaemon *daemon );
+static RunCode  run_action( sDaemon *daemon, const gchar *id, GList *targets, const gchar *cwd, const gchar *const *environment, gchar **message );
+static void     on_pivot_items_changed( FMAPivot *pivot, sDaemon *daemon );
+static void     on_settings_key_changed( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, sDaemon *daemon );
+static void     idle_restart( sDaemon *daemon );
+static gboolean on_idle_timeout( sDaemon *daemon );
+
+int
+main( int argc, char** argv )
+{
+	static const gchar *thisfn = "fma_run_daemon_main";
+	sDaemon daemon;
+	guint owner_id;
+
+#if !GLIB_CHECK_VERSION( 2,36, 0 )
+	g_type_init();
+#endif
+
+	setlocale( LC_ALL, "" );
+	console_init_log_handler();
+
+#ifdef ENABLE_NLS
+	bindtextdomain( GETTEXT_PACKAGE, GNOMELOCALEDIR );
+# ifdef HAVE_BIND_TEXTDOMAIN_CODESET
+	bind_textdomain_codeset( GETTEXT_PACKAGE, "UTF-8" );
+# endif
+	textdomain( GETTEXT_PACKAGE );
+#endif
+
+	/* run GConf migration tools before allocating the FMAPivot,
+	 * as fma-run used to do
+	 */
+	fma_gconf_migration_run();
+
+	daemon.loop = g_main_loop_new( NULL, FALSE );
+	daemon.skeleton = NULL;
+	daemon.idle_id = 0;
+
+	daemon.pivot = fma_pivot_new();
+	fma_pivot_set_loadable( daemon.pivot, !PIVOT_LOAD_DISABLED & !PIVOT_LOAD_INVALID );
+	fma_pivot_load_items( daemon.pivot );
+
+	g_signal_connect( daemon.pivot, PIVOT_SIGNAL_ITEMS_CHANGED, G_CALLBACK( on_pivot_items_changed ), &daemon );
+
+	fma_settings_register_key_callback(
+			IPREFS_IO_PROVIDERS_READ_STATUS,
+			G_CALLBACK( on_settings_key_changed ),
+			&daemon );
+
+	owner_id = g_bus_own_name(
+			G_BUS_TYPE_SESSION,
+			FILEMANAGER_ACTIONS_DBUS_RUN_SERVICE,
+			G_BUS_NAME_OWNER_FLAGS_NONE,
+			( GBusAcquiredCallback ) on_bus_acquired,
+			NULL,
+			( GBusNameLostCallback ) on_name_lost,
+			&daemon,
+			NULL );
+
+	idle_restart( &daemon );
+	g_main_loop_run( daemon.loop );
+
+	g_debug( "%s: quitting", thisfn );
+
+	g_bus_unown_name( owner_id );
+
+	if( daemon.idle_id ){
+		g_source_remove( daemon.idle_id );
+	}
+	if( daemon.skeleton ){
+		g_dbus_interface_skeleton_unexport( G_DBUS_INTERFACE_SKELETON( daemon.skeleton ));
+		g_object_unref( daemon.skeleton );
+	}
+	g_object_unref( daemon.pivot );
+	g_main_loop_unref( daemon.loop );
+
+	return( EXIT_SUCCESS );
+}
+
+static void
+on_bus_acquired( GDBusConnection *connection, const gchar *name, sDaemon *daemon )
+{
+	static const gchar *thisfn = "fma_run_daemon_on_bus_acquired";
+	GError *error;
+
+	g_debug( "%s: connection=%p, name=%s", thisfn, ( void * ) connection, name );
+
+	daemon->skeleton = fma_run_gdbus_actions1_skeleton_new();
+
+	g_signal_connect( daemon->skeleton, "handle-run-action", G_CALLBACK( on_handle_run_action ), daemon );
+	g_signal_connect( daemon->skeleton, "handle-run-action-for-infos", G_CALLBACK( on_handle_run_action_for_infos ), daemon );
+
+	error = NULL;
+	if( !g_dbus_interface_skeleton_export(
+			G_DBUS_INTERFACE_SKELETON( daemon->skeleton ), connection, FILEMANAGER_ACTIONS_DBUS_RUN_PATH, &error )){
+
+		g_warning( "%s: unable to export the %s interface: %s", thisfn, FILEMANAGER_ACTIONS_DBUS_RUN_IFACE, error->message );
+		g_error_free( error );
+		g_main_loop_quit( daemon->loop );
+	}
+}
+
+/*
+ * either the connection has been closed, or another instance owns the
+ * name: in both cases, just quit
+ */
+static void
+on_name_lost( GDBusConnection *connection, const gchar *name, sDaemon *daemon )
+{
+	static const gchar *thisfn = "fma_run_daemon_on_name_lost";
+
+	g_debug( "%s: connection=%p, name=%s", thisfn, ( void * ) connection, name );
+
+	g_main_loop_quit( daemon->loop );
+}
+
+static gboolean
+on_handle_run_action( FMARunGDBusActions1 *skeleton, GDBusMethodInvocation *invocation,
+		const gchar *id, const gchar *const *uris, const gchar *const *mimetypes,
+		const gchar *cwd, const gchar *const *environment, sDaemon *daemon )
+{
+	static const gchar *thisfn = "fma_run_daemon_on_handle_run_action";
+	GList *targets;
+	RunCode code;
+	gchar *message;
+
+	g_debug( "%s: id=%s, uris_count=%u", thisfn, id, g_strv_length(( gchar ** ) uris ));
+
+	targets = fma_run_utils_get_selection(( const gchar ** ) uris, ( const gchar ** ) mimetypes );
+	code = run_action( daemon, id, targets, cwd, environment, &message );
+	fma_selected_info_free_list( targets );
+
+	fma_run_gdbus_actions1_complete_run_action( skeleton, invocation, code, message ? message : "" );
+	g_free( message );
+
+	idle_restart( daemon );
+
+	return( TRUE );
+}
+
+static gboolean
+on_handle_run_action_for_infos( FMARunGDBusActions1 *skeleton, GDBusMethodInvocation *invocation,
+		const gchar *id, GVariant *infos, const gchar *cwd, const gchar *const *environment, sDaemon *daemon )
+{
+	static const gchar *thisfn = "fma_run_daemon_on_handle_run_action_for_infos";
+	GList *targets;
+	RunCode code;
+	gchar *message;
+
+	g_debug( "%s: id=%s, infos_count=%lu", thisfn, id, ( unsigned long ) g_variant_n_children( infos ));
+
+	targets = fma_run_utils_get_selection_from_infos( infos );
+	code = run_action( daemon, id, targets, cwd, environment, &message );
+	fma_selected_info_free_list( targets );
+
+	fma_run_gdbus_actions1_complete_run_action_for_infos( skeleton, invocation, code, message ? message : "" );
+	g_free( message );
+
+	idle_restart( daemon );
+
+	return( TRUE );
+}
+
+/*
+ * the command is executed in the working directory, and in the
+ * environment, of the caller, rather than in those of the daemon
+ */
+static RunCode
+run_action( sDaemon *daemon, const gchar *id, GList *targets, const gchar *cwd, const gchar *const *environment, gchar **message )
+{
+	return( fma_run_utils_run_action(
+			daemon->pivot, id, targets, strlen( cwd ) ? cwd : NULL, ( gchar ** ) environment, message ));
+}
+
+/*
+ * FMAPivot has already coalesced the change events
+ */
+static void
+on_pivot_items_changed( FMAPivot *pivot, sDaemon *daemon )
+{
+	static const gchar *thisfn = "fma_run_daemon_on_pivot_items_changed";
+
+	g_debug( "%s: reloading items", thisfn );
+
+	fma_pivot_load_items( pivot );
+}
+
+static void
+on_settings_key_changed( const gchar *group, const gchar *key, gconstpointer new_value, gboolean mandatory, sDaemon *daemon )
+{
+	fma_pivot_load_items( daemon->pivot );
+}
+
+static void
+idle_restart( sDaemon *daemon )
+{
+	if( daemon->idle_id ){
+		g_source_remove( daemon->idle_id );
+	}
+	daemon->idle_id = g_timeout_add_seconds( RUN_DAEMON_IDLE_TIMEOUT, ( GSourceFunc ) on_idle_timeout, daemon );
+}
+
+static gboolean
+on_idle_timeout( sDaemon *daemon )
+{
+	static const gchar *thisfn = "fma_run_daemon_on_idle_timeout";
+
+	g_debug( "%s: no request since %u seconds, exiting", thisfn, RUN_DAEMON_IDLE_TIMEOUT );
+
+	daemon->idle_id = 0;
+	g_main_loop_quit( daemon->loop );
+
+	return( FALSE );
+}
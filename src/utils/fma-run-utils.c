@@ -0,0 +1,229 @@
+/*
+ * FileManager-Actions
+ * A file-manager extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * FileManager-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * FileManager-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileManager-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <string.h>
+
+#include <api/fma-object-api.h>
+
+#include <core/fma-selected-info.h>
+#include <core/fma-tokens.h>
+
+#include "fma-run-utils.h"
+
+static FMAObjectAction  *get_action( FMAPivot *pivot, const gchar *id, gchar **message );
+static FMAObjectProfile *get_profile_for_targets( FMAObjectAction *action, GList *targets );
+
+/**
+ * fma_run_utils_get_selection:
+ * @uris: a %NULL-terminated array of URIs.
+ * @mimetypes: [allow-none]: a %NULL-terminated array of the mimetypes
+ *  of each of the @uris, or %NULL.
+ *
+ * Returns: a list of #FMASelectedInfo objects, which should be released
+ * with fma_selected_info_free_list().
+ */
+GList *
+fma_run_utils_get_selection( const gchar **uris, const gchar **mimetypes )
+{
+	GList *list;
+	guint i, n_mimetypes;
+	gchar *errmsg;
+	const gchar *mimetype;
+	FMASelectedInfo *nsi;
+
+	list = NULL;
+	n_mimetypes = mimetypes ? g_strv_length(( gchar ** ) mimetypes ) : 0;
+
+	for( i = 0 ; uris && uris[i] ; ++i ){
+		mimetype = NULL;
+		if( i < n_mimetypes && strlen( mimetypes[i] )){
+			mimetype = mimetypes[i];
+		}
+
+		errmsg = NULL;
+		nsi = fma_selected_info_create_for_uri( uris[i], mimetype, &errmsg );
+
+		if( errmsg ){
+			g_printerr( "%s\n", errmsg );
+			g_free( errmsg );
+		}
+
+		if( nsi ){
+			list = g_list_prepend( list, nsi );
+		}
+	}
+
+	return( g_list_reverse( list ));
+}
+
+/**
+ * fma_run_utils_get_selection_from_infos:
+ * @infos: an a(ssuus) #GVariant, as returned by the GetSelectedInfos
+ *  method of the tracker.
+ *
+ * Contrarily to fma_run_utils_get_selection(), the attributes of the
+ * targets are not queried again.
+ *
+ * Returns: a list of #FMASelectedInfo objects, which should be released
+ * with fma_selected_info_free_list().
+ */
+GList *
+fma_run_utils_get_selection_from_infos( GVariant *infos )
+{
+	GList *list;
+	GVariantIter iter;
+	const gchar *uri, *mimetype, *owner;
+	guint type, access;
+
+	list = NULL;
+	g_variant_iter_init( &iter, infos );
+
+	while( g_variant_iter_next( &iter, "(&s&suu&s)", &uri, &mimetype, &type, &access, &owner )){
+		list = g_list_prepend( list,
+				fma_selected_info_create_for_attributes( uri, mimetype, ( GFileType ) type, access, owner ));
+	}
+
+	return( g_list_reverse( list ));
+}
+
+/**
+ * fma_run_utils_run_action:
+ * @pivot: the #FMAPivot which holds the loaded items.
+ * @id: the identifier of the action.
+ * @targets: a list of #FMASelectedInfo objects.
+ * @cwd: [allow-none]: the working directory of the command, when the
+ *  profile does not specify one, or %NULL for the current one.
+ * @envp: [allow-none]: the environment of the command, or %NULL for the
+ *  current one.
+ * @message: [out]: set to a displayable message, to be g_free() by the
+ *  caller, when the action has not been executed.
+ *
+ * Executes the action on the @targets, with the first profile which is
+ * candidate to them.
+ *
+ * Returns: the result of the operation.
+ */
+RunCode
+fma_run_utils_run_action( FMAPivot *pivot, const gchar *id, GList *targets,
+		const gchar *cwd, gchar **envp, gchar **message )
+{
+	static const gchar *thisfn = "fma_run_utils_run_action";
+	FMAObjectAction *action;
+	FMAObjectProfile *profile;
+	FMATokens *tokens;
+
+	*message = NULL;
+
+	action = get_action( pivot, id, message );
+	if( !action ){
+		return( RUN_CODE_INVALID_ACTION );
+	}
+	g_debug( "%s: action %s have been found, and is enabled and valid", thisfn, id );
+
+	if( !targets ){
+		*message = g_strdup( _( "No current selection. Nothing to do. Exiting.\n" ));
+		return( RUN_CODE_NO_SELECTION );
+	}
+
+	if( !fma_icontext_is_candidate( FMA_ICONTEXT( action ), ITEM_TARGET_ANY, targets )){
+		*message = g_strdup_printf( _( "Action %s is not a valid candidate. Exiting.\n" ), id );
+		return( RUN_CODE_NOT_CANDIDATE );
+	}
+
+	profile = get_profile_for_targets( action, targets );
+	if( !profile ){
+		*message = g_strdup( _( "No valid profile is candidate to execution. Exiting.\n" ));
+		return( RUN_CODE_NO_PROFILE );
+	}
+	g_debug( "%s: profile %p found", thisfn, ( void * ) profile );
+
+	tokens = fma_tokens_new_from_selection( targets );
+	if( cwd || envp ){
+		fma_tokens_set_environment( tokens, cwd, envp );
+	}
+	fma_tokens_execute_action( tokens, profile );
+	g_object_unref( tokens );
+
+	return( RUN_CODE_OK );
+}
+
+/*
+ * search for the action in the repository
+ * the returned action is owned by the pivot
+ */
+static FMAObjectAction *
+get_action( FMAPivot *pivot, const gchar *id, gchar **message )
+{
+	FMAObjectItem *item;
+	FMAObjectAction *action;
+
+	action = NULL;
+	item = fma_pivot_get_item( pivot, id );
+
+	if( !item || !FMA_IS_OBJECT_ACTION( item )){
+		*message = g_strdup_printf( _( "Error: action “%s” doesn’t exist.\n" ), id );
+
+	} else if( !fma_object_is_enabled( item )){
+		*message = g_strdup_printf( _( "Error: action “%s” is disabled.\n" ), id );
+
+	} else if( !fma_object_is_valid( item )){
+		*message = g_strdup_printf( _( "Error: action “%s” is not valid.\n" ), id );
+
+	} else {
+		action = FMA_OBJECT_ACTION( item );
+	}
+
+	return( action );
+}
+
+/*
+ * find a profile candidate to be executed for the given uris
+ */
+static FMAObjectProfile *
+get_profile_for_targets( FMAObjectAction *action, GList *targets )
+{
+	GList *profiles, *ip;
+	FMAObjectProfile *candidate;
+
+	candidate = NULL;
+	profiles = fma_object_get_items( action );
+
+	for( ip = profiles ; ip && !candidate ; ip = ip->next ){
+		if( fma_icontext_is_candidate( FMA_ICONTEXT( ip->data ), ITEM_TARGET_ANY, targets )){
+			candidate = FMA_OBJECT_PROFILE( ip->data );
+		}
+	}
+
+	return( candidate );
+}
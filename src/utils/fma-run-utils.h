@@ -0,0 +1,80 @@
+/*
+ * FileManager-Actions
+ * A file-manager extension which offers configurable context menu actions.
+ *
+ * Copyright (C) 2005 The GNOME Foundation
+ * Copyright (C) 2006-2008 Frederic Ruaudel and others (see AUTHORS)
+ * Copyright (C) 2009-2015 Pierre Wieser and others (see AUTHORS)
+ *
+ * FileManager-Actions is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of
+ * the License, or (at your option) any later version.
+ *
+ * FileManager-Actions is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileManager-Actions; see the file COPYING. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * Authors:
+ *   Frederic Ruaudel <grumz@grumz.net>
+ *   Rodrigo Moya <rodrigo@gnome-db.org>
+ *   Pierre Wieser <pwieser@trychlos.org>
+ *   ... and many others (see AUTHORS)
+ */
+
+#ifndef __UTILS_FMA_RUN_UTILS_H__
+#define __UTILS_FMA_RUN_UTILS_H__
+
+/**
+ * SECTION: fma-run-utils
+ * @title: RunUtils
+ * @short_description: Action execution shared by fma-run and fma-run-daemon
+ * @include: utils/fma-run-utils.h
+ */
+
+#include <core/fma-pivot.h>
+
+G_BEGIN_DECLS
+
+/**
+ * RunCode:
+ * @RUN_CODE_OK:             the action has been executed.
+ * @RUN_CODE_INVALID_ACTION: the action does not exist, is disabled or invalid.
+ * @RUN_CODE_NO_SELECTION:   there is no target.
+ * @RUN_CODE_NOT_CANDIDATE:  the action is not candidate for the targets.
+ * @RUN_CODE_NO_PROFILE:     no profile is candidate for the targets.
+ *
+ * The result of an execution request; this is also the code returned
+ * by the RunAction D-Bus method.
+ */
+typedef enum {
+	RUN_CODE_OK = 0,
+	RUN_CODE_INVALID_ACTION,
+	RUN_CODE_NO_SELECTION,
+	RUN_CODE_NOT_CANDIDATE,
+	RUN_CODE_NO_PROFILE
+}
+	RunCode;
+
+/**
+ * RUN_DAEMON_IDLE_TIMEOUT:
+ *
+ * The count of seconds after which an idle fma-run-daemon exits;
+ * it will be activated again on the next request.
+ */
+#define RUN_DAEMON_IDLE_TIMEOUT			600
+
+GList  *fma_run_utils_get_selection           ( const gchar **uris, const gchar **mimetypes );
+GList  *fma_run_utils_get_selection_from_infos( GVariant *infos );
+
+RunCode fma_run_utils_run_action              ( FMAPivot *pivot, const gchar *id, GList *targets,
+													const gchar *cwd, gchar **envp, gchar **message );
+
+G_END_DECLS
+
+#endif /* __UTILS_FMA_RUN_UTILS_H__ */
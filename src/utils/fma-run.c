@@ -44,10 +44,15 @@
 #include <core/fma-gconf-migration.h>
 #include <core/fma-pivot.h>
 #include <core/fma-selected-info.h>
-#include <core/fma-tokens.h>
 
 #include "console-utils.h"
 #include "fma-run-bindings.h"
+#include "fma-run-daemon-bindings.h"
+#include "fma-run-utils.h"
+
+/* the count of items requested to the tracker at once
+ */
+#define SELECTION_PAGE_SIZE		256
 
 static gchar     *id               = "";
 static gchar    **targets_array    = NULL;
@@ -70,12 +75,11 @@ static GOptionEntry misc_entries[] = {
 };
 
 static GOptionContext  *init_options( void );
-static FMAObjectAction  *get_action( const gchar *id );
-static GList           *targets_from_selection( void );
-static GList           *targets_from_commandline( void );
-static GList           *get_selection_from_strv( const gchar **strv, gboolean has_mimetype );
-static FMAObjectProfile *get_profile_for_targets( FMAObjectAction *action, GList *targets );
-static void             execute_action( FMAObjectAction *action, FMAObjectProfile *profile, GList *targets );
+static void             targets_from_selection( gchar ***uris, gchar ***mimetypes, GVariant **infos );
+static GVariant        *get_selected_infos( FMATrackerGDBusProperties1 *properties, GError **error );
+static gchar          **get_selected_paths( FMATrackerGDBusProperties1 *properties, GError **error );
+static gboolean         run_with_daemon( const gchar *id, const gchar **uris, const gchar **mimetypes, GVariant *infos, RunCode *code, gchar **message, GError **error );
+static RunCode          run_in_process( const gchar *id, const gchar **uris, const gchar **mimetypes, GVariant *infos, gchar **message );
 static void             dump_targets( GList *targets );
 static void             exit_with_usage( void );
 
@@ -87,10 +91,10 @@ main( int argc, char** argv )
 	GOptionContext *context;
 	GError *error = NULL;
 	gchar *help;
-	gint errors;
-	FMAObjectAction *action;
-	FMAObjectProfile *profile;
-	GList *targets;
+	gchar **uris, **mimetypes;
+	GVariant *infos;
+	RunCode code;
+	gchar *message;
 
 #if !GLIB_CHECK_VERSION( 2,36, 0 )
 	g_type_init();
@@ -99,12 +103,6 @@ main( int argc, char** argv )
 	setlocale( LC_ALL, "" );
 	console_init_log_handler();
 
-	/* pwi 2011-01-05
-	 * run GConf migration tools before doing anything else
-	 * above all before allocating a new FMAPivot
-	 */
-	fma_gconf_migration_run();
-
 	context = init_options();
 
 	if( argc == 1 ){
@@ -128,53 +126,70 @@ main( int argc, char** argv )
 		exit( status );
 	}
 
-	errors = 0;
-
 	if( !id || !strlen( id )){
 		g_printerr( _( "Error: action id is mandatory.\n" ));
-		errors += 1;
-	}
-
-	action = get_action( id );
-	if( !action ){
-		errors += 1;
-	} else {
-		g_debug( "%s: action %s have been found, and is enabled and valid", thisfn, id );
-	}
-
-	if( errors ){
 		exit_with_usage();
 	}
 
+	infos = NULL;
+
 	if( targets_array ){
-		targets = targets_from_commandline();
+		uris = g_strdupv( targets_array );
+		mimetypes = NULL;
 
 	} else {
-		targets = targets_from_selection();
+		targets_from_selection( &uris, &mimetypes, &infos );
 	}
 
-	dump_targets( targets );
+	/* pwi 2011-01-05
+	 * run GConf migration tools before doing anything else
+	 * above all before allocating a new FMAPivot
+	 *
+	 * Starting with 3.5, the resident daemon runs them itself, and
+	 * already has its FMAPivot loaded
+	 */
+	message = NULL;
+	error = NULL;
 
-	if( g_list_length( targets ) == 0 ){
-		g_print( _( "No current selection. Nothing to do. Exiting.\n" ));
-		exit( status );
+	if( !run_with_daemon( id, ( const gchar ** ) uris, ( const gchar ** ) mimetypes, infos, &code, &message, &error )){
+		fma_gconf_migration_run();
+		code = run_in_process( id, ( const gchar ** ) uris, ( const gchar ** ) mimetypes, infos, &message );
 	}
 
-	if( !fma_icontext_is_candidate( FMA_ICONTEXT( action ), ITEM_TARGET_ANY, targets )){
-		g_printerr( _( "Action %s is not a valid candidate. Exiting.\n" ), id );
-		exit( status );
-	}
+	g_debug( "%s: code=%u", thisfn, code );
 
-	profile = get_profile_for_targets( action, targets );
-	if( !profile ){
-		g_print( _( "No valid profile is candidate to execution. Exiting.\n" ));
-		exit( status );
+	g_strfreev( uris );
+	g_strfreev( mimetypes );
+	if( infos ){
+		g_variant_unref( infos );
 	}
-	g_debug( "%s: profile %p found", thisfn, ( void * ) profile );
 
-	execute_action( action, profile, targets );
+	if( error ){
+		g_printerr( "%s\n", error->message );
+		g_error_free( error );
+		status = EXIT_FAILURE;
 
-	fma_selected_info_free_list( targets );
+	} else {
+		switch( code ){
+			case RUN_CODE_OK:
+				break;
+
+			case RUN_CODE_INVALID_ACTION:
+				g_printerr( "%s", message );
+				exit_with_usage();
+				break;
+
+			case RUN_CODE_NOT_CANDIDATE:
+				g_printerr( "%s", message );
+				break;
+
+			default:
+				g_print( "%s", message );
+				break;
+		}
+	}
+
+	g_free( message );
 	exit( status );
 }
 
@@ -216,55 +231,22 @@ init_options( void )
 }
 
 /*
- * search for the action in the repository
- */
-static FMAObjectAction *
-get_action( const gchar *id )
-{
-	FMAPivot *pivot;
-	FMAObjectAction *action;
-
-	action = NULL;
-
-	pivot = fma_pivot_new();
-	fma_pivot_set_loadable( pivot, !PIVOT_LOAD_DISABLED & !PIVOT_LOAD_INVALID );
-	fma_pivot_load_items( pivot );
-
-	action = ( FMAObjectAction * ) fma_pivot_get_item( pivot, id );
-
-	if( !action ){
-		g_printerr( _( "Error: action “%s” doesn’t exist.\n" ), id );
-
-	} else {
-		if( !fma_object_is_enabled( action )){
-			g_printerr( _( "Error: action “%s” is disabled.\n" ), id );
-			g_object_unref( action );
-			action = NULL;
-		}
-		if( !fma_object_is_valid( action )){
-			g_printerr( _( "Error: action “%s” is not valid.\n" ), id );
-			g_object_unref( action );
-			action = NULL;
-		}
-	}
-
-	return( action );
-}
-
-/*
- * the DBus.Tracker.Properties1 interface returns a list of strings
- * where each selected item brings up both its URI and its Nautilus
- * mime type.
+ * the DBus.Tracker.Properties1 interface returns the selected items
+ * with their URI, their Nautilus mime type and the file attributes
+ * needed to validate the conditions, which we return to the caller as
+ * @infos.
  *
- * We return to the caller a GList of FMASelectedInfo objects
+ * Trackers older than 3.5 only return a list of strings where each
+ * selected item brings up both its URI and its Nautilus mime type: we
+ * then return to the caller the two arrays of URIs and of mimetypes
  */
-static GList *
-targets_from_selection( void )
+static void
+targets_from_selection( gchar ***uris, gchar ***mimetypes, GVariant **infos )
 {
 	static const gchar *thisfn = "nautilus_actions_run_targets_from_selection";
-	GList *selection;
 	GError *error;
 	gchar **paths;
+	guint i, count;
 	GDBusObjectManager *manager;
 	gchar *name_owner;
 	GDBusObject *object;
@@ -272,7 +254,9 @@ targets_from_selection( void )
 
 	g_debug( "%s", thisfn );
 
-	selection = NULL;
+	*uris = NULL;
+	*mimetypes = NULL;
+	*infos = NULL;
 	error = NULL;
 	paths = NULL;
 
@@ -287,7 +271,7 @@ targets_from_selection( void )
 	if( !manager ){
 		g_printerr( "%s: unable to allocate an ObjectManagerClient: %s\n", thisfn, error->message );
 		g_error_free( error );
-		return( NULL );
+		return;
 	}
 
 	name_owner = g_dbus_object_manager_client_get_name_owner( G_DBUS_OBJECT_MANAGER_CLIENT( manager ));
@@ -298,7 +282,7 @@ targets_from_selection( void )
 	if( !object ){
 		g_printerr( "%s: unable to get object at %s path\n", thisfn, FILEMANAGER_ACTIONS_DBUS_TRACKER_PATH "/0" );
 		g_object_unref( manager );
-		return( NULL );
+		return;
 	}
 
 	iface = g_dbus_object_get_interface( object, FILEMANAGER_ACTIONS_DBUS_TRACKER_IFACE );
@@ -306,108 +290,290 @@ targets_from_selection( void )
 		g_printerr( "%s: unable to get %s interface\n", thisfn, FILEMANAGER_ACTIONS_DBUS_TRACKER_IFACE );
 		g_object_unref( object );
 		g_object_unref( manager );
-		return( NULL );
+		return;
 	}
 
 	/* note that @iface is really a GDBusProxy instance
 	 * and additionally also a NATrackerProperties1 instance
 	 */
-	fma_tracker_gdbus_properties1_call_get_selected_paths_sync(
-			FMA_TRACKER_GDBUS_PROPERTIES1( iface ),
-			&paths,
-			NULL,
-			&error );
+	*infos = get_selected_infos( FMA_TRACKER_GDBUS_PROPERTIES1( iface ), &error );
+
+	if( !*infos && !error ){
+		paths = get_selected_paths( FMA_TRACKER_GDBUS_PROPERTIES1( iface ), &error );
 
-	selection = get_selection_from_strv(( const gchar ** ) paths, TRUE );
+		if( !error ){
+			count = paths ? g_strv_length( paths ) / 2 : 0;
+			*uris = g_new0( gchar *, 1+count );
+			*mimetypes = g_new0( gchar *, 1+count );
 
-	g_strfreev( paths );
+			for( i = 0 ; i < count ; ++i ){
+				( *uris )[i] = g_strdup( paths[2*i] );
+				( *mimetypes )[i] = g_strdup( paths[2*i+1] );
+			}
 
-	return( selection );
+			g_strfreev( paths );
+		}
+	}
+
+	/* a partial selection is not a selection: run nothing
+	 */
+	if( error ){
+		g_printerr( "%s: unable to get the selection: %s\n", thisfn, error->message );
+		g_error_free( error );
+	}
+
+	g_object_unref( iface );
+	g_object_unref( object );
+	g_object_unref( manager );
 }
 
 /*
- * get targets from command-line
+ * pages through the current selection, starting again if it changes
+ * meanwhile
  *
- * We return to the caller a GList of FMASelectedInfo objects.
+ * Returns: the a(ssuus) selection, or %NULL if the tracker doesn't
+ * know about GetSelectedInfos, or if an error has occurred, in which
+ * case @error is set.
  */
-static GList *
-targets_from_commandline( void )
+static GVariant *
+get_selected_infos( FMATrackerGDBusProperties1 *properties, GError **error )
 {
-	static const gchar *thisfn = "nautilus_actions_run_targets_from_commandline";
-	GList *targets;
+	static const gchar *thisfn = "nautilus_actions_run_get_selected_infos";
+	GVariantBuilder builder;
+	GVariantIter iter;
+	GVariant *page, *child;
+	GError *local_error;
+	guint offset, count;
+	guint generation, first_generation, total;
+	gboolean done;
+
+	g_variant_builder_init( &builder, G_VARIANT_TYPE( "a(ssuus)" ));
+	first_generation = 0;
+	offset = 0;
+	done = FALSE;
+
+	while( !done ){
+		page = NULL;
+		local_error = NULL;
+
+		if( !fma_tracker_gdbus_properties1_call_get_selected_infos_sync(
+				properties, offset, SELECTION_PAGE_SIZE, &generation, &total, &page, NULL, &local_error )){
+
+			if( g_error_matches( local_error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD )){
+				g_debug( "%s: %s", thisfn, local_error->message );
+				g_error_free( local_error );
+
+			} else {
+				g_propagate_error( error, local_error );
+			}
+
+			g_variant_builder_clear( &builder );
+			return( NULL );
+		}
 
-	g_debug( "%s", thisfn );
+		if( offset == 0 ){
+			first_generation = generation;
+
+		} else if( generation != first_generation ){
+			g_debug( "%s: selection has changed, starting again", thisfn );
+			g_variant_builder_clear( &builder );
+			g_variant_builder_init( &builder, G_VARIANT_TYPE( "a(ssuus)" ));
+			g_variant_unref( page );
+			offset = 0;
+			continue;
+		}
 
-	targets = get_selection_from_strv(( const gchar ** ) targets_array, FALSE );
+		count = g_variant_n_children( page );
+		g_variant_iter_init( &iter, page );
+		while(( child = g_variant_iter_next_value( &iter ))){
+			g_variant_builder_add_value( &builder, child );
+			g_variant_unref( child );
+		}
+		g_variant_unref( page );
+
+		offset += count;
+		done = ( count == 0 || offset >= total );
+	}
 
-	return( targets );
+	return( g_variant_ref_sink( g_variant_builder_end( &builder )));
 }
 
-static GList *
-get_selection_from_strv( const gchar **strv, gboolean has_mimetype )
+/*
+ * pages through the current selection, starting again if it changes
+ * meanwhile; trackers older than 3.5 only know about GetSelectedPaths
+ *
+ * Returns: the uri/mimetype pairs of the selection, or %NULL if an error
+ * has occurred, in which case @error is set.
+ */
+static gchar **
+get_selected_paths( FMATrackerGDBusProperties1 *properties, GError **error )
 {
-	GList *list;
-	gchar **iter;
-	gchar *errmsg;
-
-	list = NULL;
-	iter = ( gchar ** ) strv;
-
-	while( *iter ){
-		const gchar *uri = ( const gchar * ) *iter;
-		const gchar *mimetype = NULL;
-		if( has_mimetype ){
-			iter++;
-			mimetype = ( const gchar * ) *iter;
+	static const gchar *thisfn = "nautilus_actions_run_get_selected_paths";
+	GPtrArray *paths;
+	gchar **page;
+	GError *local_error;
+	guint offset, count, i;
+	guint generation, first_generation, total;
+	gboolean done;
+
+	paths = g_ptr_array_new_with_free_func( g_free );
+	first_generation = 0;
+	offset = 0;
+	done = FALSE;
+
+	while( !done ){
+		page = NULL;
+		local_error = NULL;
+
+		if( !fma_tracker_gdbus_properties1_call_get_selected_paths_page_sync(
+				properties, offset, SELECTION_PAGE_SIZE, &generation, &total, &page, NULL, &local_error )){
+
+			g_ptr_array_free( paths, TRUE );
+
+			if( g_error_matches( local_error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD )){
+				g_debug( "%s: %s", thisfn, local_error->message );
+				g_error_free( local_error );
+				fma_tracker_gdbus_properties1_call_get_selected_paths_sync( properties, &page, NULL, error );
+
+			} else {
+				g_propagate_error( error, local_error );
+			}
+
+			return( page );
 		}
 
-		errmsg = NULL;
-		FMASelectedInfo *nsi = fma_selected_info_create_for_uri( uri, mimetype, &errmsg );
+		if( offset == 0 ){
+			first_generation = generation;
 
-		if( errmsg ){
-			g_printerr( "%s\n", errmsg );
-			g_free( errmsg );
+		} else if( generation != first_generation ){
+			g_debug( "%s: selection has changed, starting again", thisfn );
+			g_ptr_array_set_size( paths, 0 );
+			g_strfreev( page );
+			offset = 0;
+			continue;
 		}
 
-		if( nsi ){
-			list = g_list_prepend( list, nsi );
+		count = g_strv_length( page );
+		for( i = 0 ; i < count ; ++i ){
+			g_ptr_array_add( paths, page[i] );
 		}
-		iter++;
+		g_free( page );
+
+		offset += count / 2;
+		done = ( count == 0 || offset >= total );
 	}
 
-	return( g_list_reverse( list ));
+	g_ptr_array_add( paths, NULL );
+
+	return(( gchar ** ) g_ptr_array_free( paths, FALSE ));
 }
 
 /*
- * find a profile candidate to be executed for the given uris
+ * request the execution to the resident fma-run-daemon, which is
+ * activated on demand by D-Bus; the action is run in the current working
+ * directory, and in the current environment
+ *
+ * Returns: %FALSE if the service is not available, and the action
+ * should be run in-process; %TRUE if the request has been handled by
+ * the daemon, or may have been, in which case @daemon_error is set.
  */
-static FMAObjectProfile *
-get_profile_for_targets( FMAObjectAction *action, GList *targets )
+static gboolean
+run_with_daemon( const gchar *id, const gchar **uris, const gchar **mimetypes, GVariant *infos, RunCode *code, gchar **message, GError **daemon_error )
 {
-	/*static const gchar *thisfn = "nautilus_actions_run_get_profile_for_targets";*/
-	GList *profiles, *ip;
-	FMAObjectProfile *candidate;
+	static const gchar *thisfn = "nautilus_actions_run_run_with_daemon";
+	static const gchar *empty[] = { NULL };
+	FMARunGDBusActions1 *proxy;
+	GError *error;
+	guint out_code;
+	gboolean done, called;
+	gchar *cwd;
+	gchar **envp;
 
-	candidate = NULL;
-	profiles = fma_object_get_items( action );
+	error = NULL;
+	done = FALSE;
+
+	proxy = fma_run_gdbus_actions1_proxy_new_for_bus_sync(
+			G_BUS_TYPE_SESSION,
+			G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES | G_DBUS_PROXY_FLAGS_DO_NOT_CONNECT_SIGNALS,
+			FILEMANAGER_ACTIONS_DBUS_RUN_SERVICE,
+			FILEMANAGER_ACTIONS_DBUS_RUN_PATH,
+			NULL,
+			&error );
 
-	for( ip = profiles ; ip && !candidate ; ip = ip->next ){
-		if( fma_icontext_is_candidate( FMA_ICONTEXT( ip->data ), ITEM_TARGET_ANY, targets )){
-			candidate = FMA_OBJECT_PROFILE( ip->data );
+	if( !proxy ){
+		g_debug( "%s: %s", thisfn, error->message );
+		g_error_free( error );
+		return( FALSE );
+	}
+
+	cwd = g_get_current_dir();
+	envp = g_get_environ();
+
+	if( infos ){
+		called = fma_run_gdbus_actions1_call_run_action_for_infos_sync(
+				proxy, id, infos, cwd, ( const gchar * const * ) envp, &out_code, message, NULL, &error );
+	} else {
+		called = fma_run_gdbus_actions1_call_run_action_sync(
+				proxy, id, uris ? uris : empty, mimetypes ? mimetypes : empty,
+				cwd, ( const gchar * const * ) envp, &out_code, message, NULL, &error );
+	}
+
+	g_strfreev( envp );
+	g_free( cwd );
+
+	if( called ){
+
+		*code = ( RunCode ) out_code;
+		done = TRUE;
+
+	} else {
+		/* do not risk to execute the action twice if the daemon may
+		 * have received the request
+		 */
+		if( g_error_matches( error, G_DBUS_ERROR, G_DBUS_ERROR_NO_REPLY ) ||
+				g_error_matches( error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT )){
+			g_debug( "%s: %s", thisfn, error->message );
+			g_propagate_error( daemon_error, error );
+			done = TRUE;
+
+		} else {
+			g_debug( "%s: %s, running in-process", thisfn, error->message );
+			g_error_free( error );
 		}
 	}
 
-	return( candidate );
+	g_object_unref( proxy );
+
+	return( done );
 }
 
-static void
-execute_action( FMAObjectAction *action, FMAObjectProfile *profile, GList *targets )
+/*
+ * only load the requested action
+ */
+static RunCode
+run_in_process( const gchar *id, const gchar **uris, const gchar **mimetypes, GVariant *infos, gchar **message )
 {
-	/*static const gchar *thisfn = "nautilus_action_run_execute_action";*/
-	FMATokens *tokens;
+	FMAPivot *pivot;
+	GList *targets;
+	RunCode code;
+
+	pivot = fma_pivot_new();
+	fma_pivot_set_loadable( pivot, !PIVOT_LOAD_DISABLED & !PIVOT_LOAD_INVALID );
+	fma_pivot_load_item_by_id( pivot, id );
+
+	if( infos ){
+		targets = fma_run_utils_get_selection_from_infos( infos );
+	} else {
+		targets = fma_run_utils_get_selection( uris, mimetypes );
+	}
+	dump_targets( targets );
+
+	code = fma_run_utils_run_action( pivot, id, targets, NULL, NULL, message );
+
+	fma_selected_info_free_list( targets );
+	g_object_unref( pivot );
 
-	tokens = fma_tokens_new_from_selection( targets );
-	fma_tokens_execute_action( tokens, profile );
+	return( code );
 }
 
 /*